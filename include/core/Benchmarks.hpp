@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class Scene;
+
+struct BenchmarkResult {
+    std::string name;
+    double ms = 0.0;        // Median über alle Durchläufe
+    std::string detail;
+};
+
+// CPU-Microbenchmarks der Engine-Subsysteme. Werden aus dem Monitoring-Panel gestartet
+// und laufen synchron im Main-Thread (der Editor steht währenddessen).
+namespace Benchmarks {
+    BenchmarkResult FrustumCulling(size_t boxCount, int runs = 10);
+    // Transformiert itemCount AABBs per JobSystem::ParallelFor mit 1..N Threads (ein Ergebnis pro Stufe)
+    std::vector<BenchmarkResult> JobSystemScaling(size_t itemCount, int runs = 5);
+    // Iteriert entityCount Entities über EntityViews (lesen bzw. Welt-Matrix schreiben) und
+    // vergleicht mit verstreut allokierten Objekten hinter shared_ptr (bisheriger Scene-Aufbau)
+    std::vector<BenchmarkResult> EntityIteration(size_t entityCount, int runs = 10);
+    // Typ-Dispatch über objectCount gemischte Objekte: dynamic_cast-Scan vs. Scene-Kategorielisten.
+    // Legt einen Würfel-Mesh an und braucht daher einen aktiven GL-Context.
+    std::vector<BenchmarkResult> SceneDispatch(size_t objectCount, int runs = 10);
+    // CPU-Binning des Clustered Shading für je lightCount zufällige Punktlichter im Sichtbereich
+    std::vector<BenchmarkResult> LightClustering(const std::vector<size_t>& lightCounts, int runs = 10);
+    // Software-Occlusion-Culling in einem Innenraum (Wandreihen mit Durchgängen, Boden): Rasterzeit der
+    // Occluder und Test der frustum-sichtbaren Boxen unter objectCount zufälligen, inkl. Cull-Rate. Ohne GL.
+    std::vector<BenchmarkResult> OcclusionCulling(size_t objectCount, int runs = 10);
+    // Frustum-Culling von instanceCount Instanzen: CPU (AABB transformieren + testen) gegen GpuCuller
+    // mit Compute (falls verfügbar) und Transform Feedback, jeweils inkl. Upload. Braucht einen aktiven GL-Context.
+    std::vector<BenchmarkResult> GpuCulling(size_t instanceCount, int runs = 10);
+    // Instanz-Transformation: frühere Model-Matrix (68 Byte, inverse() pro Vertex) gegen InstanceData
+    // (Position/Quaternion/Skalierung, 36 Byte). Gemessen werden Upload der Instanzdaten und die Vertex-Stufe
+    // (instanceCount Kugeln bei GL_RASTERIZER_DISCARD). Braucht einen aktiven GL-Context.
+    std::vector<BenchmarkResult> InstanceTransforms(size_t instanceCount, int runs = 10);
+    // Import-Optimierung (MeshOptimizer) einer UV-Kugel mit gemischter Dreiecksreihenfolge: Laufzeit, ACMR/ATVR
+    // vorher/nachher und Prüfung, dass die optimierte Geometrie dieselben Dreiecke beschreibt. Ohne GL.
+    std::vector<BenchmarkResult> MeshOptimization(size_t triangleCount, int runs = 5);
+    // Modell-Import aller Modelle unter modelDirectory: kalt (Assimp, Aufbereitung, .arkmesh schreiben) gegen
+    // warm (gekochte Datei per mmap). Nur die CPU-Phase des Imports, ohne GL.
+    std::vector<BenchmarkResult> ModelCache(const std::string& modelDirectory, int runs = 3);
+    // Ersetzt den Inhalt der Scene durch eine Testszene (Boden, Würfelraster, lightCount kleine Punktlichter)
+    // zum Messen der Shading-Kosten im Viewport. Braucht einen aktiven GL-Context.
+    void BuildLightScene(Scene& scene, size_t lightCount);
+    // Testszene für das Batching über Materialien: objectCount Würfel mit vier verschiedenen Textur-Sets,
+    // aber gleicher Geometrie. Objekte pro Draw zeigt der Renderer-Tab. Braucht einen aktiven GL-Context.
+    void BuildMaterialScene(Scene& scene, size_t objectCount);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+class Mesh;
+class Model;
+class Light;
+
+// Komponenten der EntityRegistry. Jede liegt in einem eigenen dichten Pool, Systeme lesen
+// damit nur die Daten, die sie brauchen (Transform-Update z.B. nie Licht- oder Mesh-Daten).
+
+struct TransformComponent {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+};
+
+// Gecachte Matrizen; version wird bei jeder Neuberechnung der Welt-Matrix erhöht.
+// worldPosition/-Rotation/-Scale ist die Welt-Matrix zerlegt (Instanzdaten der GPU, ohne Scherung).
+struct WorldTransformComponent {
+    glm::mat4 local = glm::mat4(1.0f);
+    glm::mat4 world = glm::mat4(1.0f);
+    glm::vec3 worldPosition = glm::vec3(0.0f);
+    glm::quat worldRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 worldScale = glm::vec3(1.0f);
+    uint32_t version = 0;
+};
+
+struct MeshRendererComponent {
+    Mesh* mesh = nullptr;
+};
+
+// Markierung: Meshes des Objekts werden in den CPU-Tiefenpuffer des OcclusionCuller gerastert
+struct OccluderComponent {};
+
+struct ModelRefComponent {
+    Model* model = nullptr;
+};
+
+// Lichtparameter bleiben im Light-Objekt (Inspector bearbeitet sie direkt)
+struct LightComponent {
+    Light* light = nullptr;
+};
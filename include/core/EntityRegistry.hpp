@@ -0,0 +1,169 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// Entity = 24 Bit Index + 8 Bit Generation. Die Generation macht Handles auf
+// zerstörte (und wiederverwendete) Indizes ungültig.
+using Entity = uint32_t;
+constexpr Entity NullEntity = 0xFFFFFFFFu;
+
+inline uint32_t EntityIndex(Entity e) { return e & 0x00FFFFFFu; }
+inline uint32_t EntityGeneration(Entity e) { return e >> 24; }
+
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+    virtual void Remove(Entity e) = 0;
+    virtual bool Contains(Entity e) const = 0;
+    virtual void Clear() = 0;
+};
+
+// Sparse Set: sparse[EntityIndex] -> Position im dichten Array.
+// Komponenten liegen lückenlos hintereinander, Views laufen linear darüber.
+// Entfernen tauscht das letzte Element nach vorne; Referenzen sind nur bis zum nächsten Add/Remove gültig.
+template<typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    static constexpr uint32_t Invalid = 0xFFFFFFFFu;
+
+    T& Add(Entity e, T value) {
+        const uint32_t index = EntityIndex(e);
+        if (index >= sparse.size()) sparse.resize(index + 1, Invalid);
+        if (sparse[index] != Invalid) {
+            data[sparse[index]] = std::move(value);
+            return data[sparse[index]];
+        }
+        sparse[index] = static_cast<uint32_t>(dense.size());
+        dense.push_back(e);
+        data.push_back(std::move(value));
+        return data.back();
+    }
+
+    void Remove(Entity e) override {
+        const uint32_t index = EntityIndex(e);
+        if (!Contains(e)) return;
+        const uint32_t pos = sparse[index];
+        const uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (pos != last) {
+            dense[pos] = dense[last];
+            data[pos] = std::move(data[last]);
+            sparse[EntityIndex(dense[pos])] = pos;
+        }
+        dense.pop_back();
+        data.pop_back();
+        sparse[index] = Invalid;
+    }
+
+    bool Contains(Entity e) const override {
+        const uint32_t index = EntityIndex(e);
+        return index < sparse.size() && sparse[index] != Invalid && dense[sparse[index]] == e;
+    }
+
+    T& Get(Entity e) { return data[sparse[EntityIndex(e)]]; }
+    const T& Get(Entity e) const { return data[sparse[EntityIndex(e)]]; }
+    T* TryGet(Entity e) { return Contains(e) ? &data[sparse[EntityIndex(e)]] : nullptr; }
+
+    void Reserve(size_t count) { dense.reserve(count); data.reserve(count); }
+    void Clear() override { sparse.clear(); dense.clear(); data.clear(); }
+
+    size_t Size() const { return dense.size(); }
+    T* Data() { return data.data(); }
+    const T* Data() const { return data.data(); }
+    const Entity* Entities() const { return dense.data(); }
+
+private:
+    std::vector<uint32_t> sparse;
+    std::vector<Entity> dense;
+    std::vector<T> data;
+};
+
+class EntityRegistry;
+
+// Iteriert alle Entities, die jede der Komponenten Ts besitzen. Getrieben wird vom kleinsten Pool;
+// bei einer einzelnen Komponente ist das eine reine lineare Schleife über das dichte Array.
+template<typename... Ts>
+class EntityView {
+public:
+    explicit EntityView(ComponentPool<Ts>&... p) : pools(&p...) {}
+
+    // fn(Entity, Ts&...)
+    template<typename Fn>
+    void Each(Fn&& fn) {
+        if constexpr (sizeof...(Ts) == 1) {
+            auto* pool = std::get<0>(pools);
+            const Entity* entities = pool->Entities();
+            auto* data = pool->Data();
+            const size_t n = pool->Size();
+            for (size_t i = 0; i < n; ++i) fn(entities[i], data[i]);
+        } else {
+            const Entity* entities = nullptr;
+            size_t n = SIZE_MAX;
+            std::apply([&](auto*... p) {
+                ((p->Size() < n ? (n = p->Size(), entities = p->Entities()) : entities), ...);
+            }, pools);
+            for (size_t i = 0; i < n; ++i) {
+                const Entity e = entities[i];
+                if (std::apply([e](auto*... p) { return (p->Contains(e) && ...); }, pools)) {
+                    std::apply([&](auto*... p) { fn(e, p->Get(e)...); }, pools);
+                }
+            }
+        }
+    }
+
+private:
+    std::tuple<ComponentPool<Ts>*...> pools;
+};
+
+// Verwaltet Entities und einen Sparse-Set-Pool pro Komponententyp.
+// Instance() ist die Registry der Engine, auf die GameObject als Fassade zugreift;
+// weitere Instanzen (z.B. für Benchmarks) sind unabhängig davon.
+class EntityRegistry {
+public:
+    static EntityRegistry& Instance();
+
+    EntityRegistry() = default;
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    Entity Create();
+    void Destroy(Entity e);
+    bool IsAlive(Entity e) const;
+    size_t AliveCount() const { return generations.size() - freeIndices.size(); }
+    void Clear();
+
+    template<typename T>
+    T& Add(Entity e, T value = T{}) { return Pool<T>().Add(e, std::move(value)); }
+    template<typename T>
+    void Remove(Entity e) { Pool<T>().Remove(e); }
+    template<typename T>
+    bool Has(Entity e) { return Pool<T>().Contains(e); }
+    template<typename T>
+    T& Get(Entity e) { return Pool<T>().Get(e); }
+    template<typename T>
+    T* TryGet(Entity e) { return Pool<T>().TryGet(e); }
+
+    template<typename T>
+    ComponentPool<T>& Pool() {
+        const size_t id = TypeId<T>();
+        if (id >= pools.size()) pools.resize(id + 1);
+        if (!pools[id]) pools[id] = std::make_unique<ComponentPool<T>>();
+        return *static_cast<ComponentPool<T>*>(pools[id].get());
+    }
+
+    template<typename... Ts>
+    EntityView<Ts...> View() { return EntityView<Ts...>(Pool<Ts>()...); }
+
+private:
+    static size_t NextTypeId();
+    template<typename T>
+    static size_t TypeId() {
+        static const size_t id = NextTypeId();
+        return id;
+    }
+
+    std::vector<uint8_t> generations;     // pro Index
+    std::vector<uint32_t> freeIndices;
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Sechs Ebenen (nach innen zeigende Normalen, xyz = n, w = d), extrahiert aus Projection * View.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum FromMatrix(const glm::mat4& viewProj);
+};
+
+// Sammelt Welt-AABBs als SoA (Center/Extents getrennt nach Achsen) und testet sie
+// blockweise gegen ein Frustum: 8 Boxen pro Schritt mit AVX (zur Laufzeit erkannt), 4 mit SSE, sonst skalar.
+class FrustumCuller {
+public:
+    void Clear();
+    void Reserve(size_t count);
+
+    // Fügt eine lokale AABB hinzu, die mit `model` in den Welt-Raum transformiert wird.
+    uint32_t Add(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model);
+    // Fügt eine Welt-AABB in Center/Extents-Form hinzu.
+    uint32_t AddWorld(const glm::vec3& center, const glm::vec3& extents);
+
+    // Für paralleles Befüllen: erst Resize, dann Set aus beliebigen Threads (disjunkte Indizes)
+    void Resize(size_t count);
+    void Set(size_t index, const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model);
+    void SetWorld(size_t index, const glm::vec3& center, const glm::vec3& extents);
+
+    // Schreibt pro Box 1 (sichtbar) oder 0 (verworfen) nach visible und liefert die Anzahl sichtbarer Boxen.
+    size_t Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+    // Wie Cull, aber nur für [begin, end); visible muss mindestens Size() Einträge haben.
+    size_t CullRange(const Frustum& frustum, uint8_t* visible, size_t begin, size_t end) const;
+
+    size_t Size() const { return count; }
+    // Welt-AABB einer Box (z.B. für nachgelagerte Occlusion-Tests)
+    glm::vec3 GetCenter(size_t index) const { return glm::vec3(cx[index], cy[index], cz[index]); }
+    glm::vec3 GetExtents(size_t index) const { return glm::vec3(ex[index], ey[index], ez[index]); }
+
+private:
+    size_t CullScalar(const Frustum& frustum, uint8_t* visible, size_t begin, size_t end) const;
+
+    std::vector<float> cx, cy, cz;
+    std::vector<float> ex, ey, ez;
+    size_t count = 0;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+// Einmalig abgefragte Fähigkeiten des aktuellen GL-Kontexts.
+// Get() darf erst nach gladLoadGLLoader aufgerufen werden.
+struct GLCapabilities {
+    bool bufferStorage = false;      // GL 4.4 / ARB_buffer_storage (persistentes Mapping)
+    bool multiDrawIndirect = false;  // GL 4.3 / ARB_multi_draw_indirect + baseInstance (GL 4.2 / ARB_base_instance)
+    bool computeShader = false;      // GL 4.3 / ARB_compute_shader + ARB_shader_storage_buffer_object
+
+    static const GLCapabilities& Get();
+    static bool HasExtension(const char* name);
+
+    // Thread, in dem der Kontext aktuell ist (Window nach gladLoadGLLoader). GL-Aufrufe nur von dort,
+    // Worker (JobSystem, Modell-Import) arbeiten rein auf CPU-Daten.
+    static void SetContextThread();
+    static bool IsContextThread();
+};
@@ -0,0 +1,224 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+struct Vertex;
+
+// First-Fit-Allokator über einen linearen Bereich [0, capacity) in Elementen (Vertices bzw. Indizes).
+// Freie Blöcke liegen nach Offset sortiert in einer Liste; Free verschmilzt mit den Nachbarn.
+class RangeAllocator {
+public:
+    static constexpr uint32_t Invalid = 0xFFFFFFFFu;
+
+    void Reset(uint32_t capacity);
+    // Liefert Invalid, wenn kein freier Block groß genug ist
+    uint32_t Allocate(uint32_t count);
+    void Free(uint32_t offset, uint32_t count);
+    // Hängt [capacity, newCapacity) als freien Bereich an
+    void Grow(uint32_t newCapacity);
+    // Nach dem Kompaktieren: [0, used) belegt, Rest frei
+    void ResetCompacted(uint32_t used, uint32_t capacity);
+
+    uint32_t Capacity() const { return capacity; }
+    uint32_t FreeCount() const { return freeCount; }
+    uint32_t LargestFreeBlock() const;
+
+private:
+    struct Block {
+        uint32_t offset;
+        uint32_t count;
+    };
+    std::vector<Block> freeBlocks;
+    uint32_t capacity = 0;
+    uint32_t freeCount = 0;
+};
+
+// Layout von GL_DRAW_INDIRECT_BUFFER-Einträgen für glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+// Per-Instanz-Daten im Ring-Buffer, 36 statt 68 Byte mit voller Matrix: Position (Location 3), Rotation als
+// Quaternion (Location 4), Skalierung (Location 5) und Material-Index (Location 7). Der Vertex-Shader dreht
+// und skaliert direkt; für die Normale reichen Rotation und 1/Skalierung statt inverse(mat4) pro Vertex.
+// Scherung (nicht-uniform skalierter Elternteil mit gedrehtem Kind) ist so nicht darstellbar und fällt weg.
+struct InstanceData {
+    glm::vec3 position;
+    uint32_t material;
+    glm::vec3 scale;
+    int16_t rotation[4];        // x, y, z, w als snorm16
+
+    static InstanceData Make(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+                             uint32_t material);
+    // Rotation so, wie der Shader sie sieht (dequantisiert und normalisiert)
+    glm::quat Rotation() const;
+};
+
+// Kompaktes Vertex-Layout (16 Byte statt 32): Position als unorm16 relativ zur Bounding-Box des Meshes,
+// Normale oktaedrisch als 2x snorm16, UV als half float. Die Dequantisierung der Position steckt in der
+// Instanz (Range::Dequantize), die Normale dekodiert StandardLit.vert.
+struct CompactVertex {
+    uint16_t position[4];       // [3] = Padding, hält die Attribute 4-Byte-ausgerichtet
+    int16_t normal[2];
+    uint16_t texCoords[2];
+};
+
+// Vertex-Layouts der Arena; pro Format ein VAO mit eigenem Vertex- und Index-Buffer.
+// Meshes mit höchstens 65536 Vertices bekommen automatisch 16-Bit-Indizes (Indizes sind mesh-lokal).
+enum class VertexFormat : uint8_t {
+    Standard,           // Vertex: Position, Normale, UV (je float), 32-Bit-Indizes
+    Standard16,         // Vertex, 16-Bit-Indizes
+    Compact,            // CompactVertex, 32-Bit-Indizes
+    Compact16,          // CompactVertex, 16-Bit-Indizes
+    Count
+};
+
+inline bool IsCompactFormat(VertexFormat format) {
+    return format == VertexFormat::Compact || format == VertexFormat::Compact16;
+}
+inline bool HasShortIndices(VertexFormat format) {
+    return format == VertexFormat::Standard16 || format == VertexFormat::Compact16;
+}
+
+// Gemeinsame Geometrie aller Meshes: wenige große Vertex-/Index-Buffer pro Format, Meshes sind nur
+// Bereiche darin. Gezeichnet wird per BaseVertex (Indizes bleiben mesh-lokal), so dass ein VAO-Bind
+// pro Format und Frame reicht. Buffer wachsen bei Bedarf; Maintain() kompaktiert stark fragmentierte Pools.
+class GeometryArena {
+public:
+    static constexpr uint32_t InvalidHandle = 0xFFFFFFFFu;
+
+    struct Range {
+        uint32_t baseVertex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        VertexFormat format = VertexFormat::Standard;
+        bool alive = false;
+        uint32_t refCount = 0;      // Meshes mit identischer Geometrie teilen sich den Bereich
+        uint64_t contentHash = 0;       // Schlüssel in contentIndex
+        uint64_t contentCheck = 0;      // zweite Hälfte des 128-Bit-Inhaltshashes
+        // Compact: Position = positionOffset + unorm16 * positionScale (Standard: 0 und 1)
+        glm::vec3 positionOffset = glm::vec3(0.0f);
+        glm::vec3 positionScale = glm::vec3(1.0f);
+
+        // Faltet die Dequantisierung in die Instanz: p + R(s * positionOffset), s * positionScale.
+        // Nutzt die quantisierte Rotation, damit alle Teil-Meshes eines Objekts exakt gleich gedreht werden.
+        InstanceData Dequantize(const InstanceData& instance) const;
+    };
+
+    // Fertig kodierte Geometrie im Layout eines Pools, z.B. direkt aus einer gemappten .arkmesh-Datei.
+    // Die Zeiger gehören dem Aufrufer und müssen nur während Allocate gültig sein.
+    struct EncodedGeometry {
+        VertexFormat format = VertexFormat::Standard;
+        const void* vertices = nullptr;     // GetVertexSize(format) Byte pro Vertex
+        const void* positions = nullptr;    // GetPositionSize(format) Byte pro Vertex
+        uint32_t vertexCount = 0;
+        const void* indices = nullptr;      // GetIndexSize(format) Byte pro Index
+        uint32_t indexCount = 0;
+        glm::vec3 positionOffset = glm::vec3(0.0f);
+        glm::vec3 positionScale = glm::vec3(1.0f);
+    };
+    // Besitzt die Bytes einer Kodierung (Encode); View() zeigt hinein
+    struct EncodedMesh {
+        VertexFormat format = VertexFormat::Standard;
+        std::vector<unsigned char> vertices;
+        std::vector<unsigned char> positions;
+        std::vector<unsigned char> indices;
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        glm::vec3 positionOffset = glm::vec3(0.0f);
+        glm::vec3 positionScale = glm::vec3(1.0f);
+
+        EncodedGeometry View() const {
+            return { format, vertices.data(), positions.data(), vertexCount, indices.data(), indexCount,
+                     positionOffset, positionScale };
+        }
+    };
+
+    static GeometryArena& Instance();
+
+    // Nur CPU, ohne GL und threadsicher: Format wählen (compact, Index-Typ nach Vertexzahl) und kodieren.
+    // Allocate macht intern dasselbe; der Modell-Cache legt das Ergebnis so ab, wie es hochgeladen wird.
+    static EncodedMesh Encode(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                              bool compact);
+
+    // Braucht einen aktiven GL-Context (Upload direkt in den Pool). Liegt dieselbe Geometrie schon in der
+    // Arena, wird deren Handle mit erhöhtem Referenzzähler geliefert -> gleiche Handles lassen sich batchen.
+    // compact = CompactVertex statt Vertex; der Index-Typ richtet sich nach der Vertexzahl.
+    uint32_t Allocate(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                      bool compact = false);
+    // Bereits kodierte Daten unverändert hochladen (gleiche Deduplizierung)
+    uint32_t Allocate(const EncodedGeometry& geometry);
+    // Nur CPU-seitig; der Bereich wird mit der letzten Referenz beim nächsten Allocate/Maintain wiederverwendet
+    void Free(uint32_t handle);
+    const Range& Get(uint32_t handle) const { return ranges[handle]; }
+    // Belegter GPU-Speicher eines Bereichs (Vertex-, Positions- und Index-Buffer)
+    size_t GetRangeBytes(uint32_t handle) const;
+
+    // GL_UNSIGNED_SHORT bzw. GL_UNSIGNED_INT und Größe eines Index in Byte
+    static unsigned int GetIndexType(VertexFormat format);
+    static size_t GetIndexSize(VertexFormat format) { return HasShortIndices(format) ? sizeof(uint16_t) : sizeof(uint32_t); }
+    static size_t GetVertexSize(VertexFormat format);
+    static size_t GetPositionSize(VertexFormat format);
+
+    // Bindet das VAO des Formats (zählt für die Monitoring-Statistik)
+    void BindVertexFormat(VertexFormat format);
+    // Bindet das VAO des reinen Positions-Streams (12 Byte pro Vertex, gleiche Offsets und Indizes)
+    // für Tiefen-Passes, die weder Normalen noch UVs brauchen
+    void BindPositionStream(VertexFormat format);
+    // Setzt die Instanz-Attribute (InstanceData, Locations 3-5 und 7) des gebundenen VAOs auf buffer + byteOffset
+    void SetInstanceBuffer(unsigned int buffer, size_t byteOffset);
+
+    // Einmal pro Frame: kompaktiert Pools, deren freier Platz überwiegend aus Lücken besteht
+    void Maintain();
+    void Defragment(VertexFormat format);
+
+    size_t GetVertexBytes() const;
+    size_t GetIndexBytes() const;
+    // Anzahl VAO-Binds seit dem letzten Aufruf
+    static size_t ConsumeBindCount();
+
+private:
+    GeometryArena() = default;
+
+    struct Pool {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+        unsigned int ebo = 0;
+        unsigned int positionVao = 0;
+        unsigned int positionVbo = 0;   // nur die Position, parallel zu vbo
+        uint32_t stride = 0;
+        uint32_t positionStride = 0;
+        uint32_t indexSize = 0;
+        RangeAllocator vertices;
+        RangeAllocator indices;
+    };
+
+    Pool& GetPool(VertexFormat format);
+    void SetupVertexArray(Pool& pool, VertexFormat format);
+    struct CompactTarget {
+        unsigned int* buffer;
+        size_t elementSize;
+    };
+    // Legt die Buffer (gleiche Offsets, z.B. Vertex- und Positions-Buffer) mit newCapacity Elementen neu an
+    // und kopiert alle lebenden Bereiche lückenlos hinein (Wachsen und Defragmentieren in einem Schritt).
+    // Danach SetupVertexArray.
+    void Compact(std::initializer_list<CompactTarget> targets, RangeAllocator& allocator, uint32_t newCapacity,
+                 VertexFormat format, uint32_t Range::*offset, uint32_t Range::*count);
+
+    Pool pools[static_cast<size_t>(VertexFormat::Count)];
+    std::vector<Range> ranges;
+    std::vector<uint32_t> freeHandles;
+    std::unordered_multimap<uint64_t, uint32_t> contentIndex;   // 64-Bit-Hälfte des Inhaltshashes -> Handle
+
+    static size_t bindCount;
+};
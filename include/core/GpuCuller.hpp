@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "glm/glm.hpp"
+#include "GeometryArena.hpp"
+#include "FrustumCuller.hpp"
+#include "RenderQueue.hpp"
+
+class Shader;
+
+// Per-Instanz-Eingabe des GPU-Cullings neben InstanceData: lokale AABB des Meshes und Index des Batches
+// (= Index des Indirect-Kommandos). 32 Byte, entspricht dem std430-Struct in GpuCull.comp.
+struct CullBounds {
+    glm::vec3 center;
+    uint32_t batch;
+    glm::vec3 extents;
+    float padding;
+};
+
+// Frustum-Culling aller Instanzen auf der GPU. Eingabe sind alle Instanzen der Queue (InstanceData +
+// CullBounds, je Batch zusammenhängend); ausgegeben werden die sichtbaren Instanzen jedes Batches
+// lückenlos ab batch.first in einen eigenen Buffer, den die Draws statt des Ring-Buffers lesen.
+//   Compute (GL 4.3): ein Thread pro Instanz, Platz per atomicAdd auf instanceCount des Indirect-Kommandos;
+//                     die Anzahl bleibt auf der GPU.
+//   Transform Feedback (GL 3.3): ein Punkt pro Instanz, der Geometry-Shader gibt nur sichtbare weiter;
+//                     ein Pass pro Batch, die Anzahl steht in einer Query (TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN).
+//                     Sie zurückzulesen blockiert bis zum Ende der Passes, deshalb nutzt der Renderer nur den
+//                     Compute-Pfad und bleibt ohne GL 4.3 beim CPU-Culling; Transform Feedback bleibt für
+//                     Benchmark und Tests.
+class GpuCuller {
+public:
+    enum class Mode { None, TransformFeedback, Compute };
+
+    GpuCuller();
+    ~GpuCuller();
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    // Wählt den Pfad nach GLCapabilities; preferCompute = false erzwingt Transform Feedback (Benchmark)
+    void Init(bool preferCompute = true);
+    void Shutdown();
+    Mode GetMode() const { return mode; }
+    static const char* ModeName(Mode mode);
+
+    void Upload(const InstanceData* instances, const CullBounds* bounds, size_t count);
+    // Compute: indirectBuffer enthält ein Kommando pro Batch mit instanceCount = 0 und baseInstance = first;
+    // der Shader zählt instanceCount hoch. Transform Feedback: indirectBuffer wird nicht benutzt, es werden
+    // nur alle Passes abgesetzt, die Anzahl pro Batch liefert ReadVisibleCounts().
+    void Cull(const Frustum& frustum, const std::vector<RenderQueue::Batch>& batches, unsigned int indirectBuffer);
+
+    unsigned int GetOutputBuffer() const { return outputBuffer; }
+    // Nur Transform Feedback: sichtbare Instanzen pro Batch des letzten Cull(). Wartet auf die GPU.
+    const std::vector<uint32_t>& ReadVisibleCounts();
+
+private:
+    void SetupFeedbackInput();
+
+    Mode mode = Mode::None;
+    std::unique_ptr<Shader> program;
+    unsigned int inputBuffer = 0;
+    unsigned int boundsBuffer = 0;
+    unsigned int outputBuffer = 0;
+    unsigned int feedbackVao = 0;       // Eingabe des Transform-Feedback-Pfads (Instanzen als Vertices)
+    size_t count = 0;
+    size_t outputCapacity = 0;          // Instanzen
+    std::vector<unsigned int> queries;  // eine GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN-Query pro Batch
+    size_t pendingQueries = 0;          // abgesetzt, aber noch nicht gelesen
+    std::vector<uint32_t> visibleCounts;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// GPU-Zeit einzelner Render-Passes über GL_TIME_ELAPSED-Queries. Ergebnisse werden erst
+// Latency Frames später abgeholt, damit die CPU nie auf die GPU wartet.
+// Passes dürfen nicht verschachtelt werden (GL erlaubt nur eine aktive TIME_ELAPSED-Query).
+// Optional zählt ein Pass zusätzlich die Samples, die den Tiefentest bestehen (GL_SAMPLES_PASSED).
+class GpuTimer {
+public:
+    static constexpr int Latency = 3;
+
+    struct PassTime {
+        const char* name;   // String-Literal aus Begin()
+        double ms;
+        long long samples;  // -1, wenn der Pass nicht zählt
+    };
+
+    GpuTimer() = default;
+    ~GpuTimer();
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    void Init();
+    void Shutdown();
+
+    // Holt die Ergebnisse des ältesten Frames ab und beginnt einen neuen
+    void BeginFrame();
+    void Begin(const char* pass, bool countSamples = false);
+    void End();
+
+    // Pass-Zeiten des zuletzt abgeholten Frames
+    const std::vector<PassTime>& GetResults() const { return results; }
+
+private:
+    struct Query {
+        const char* name = nullptr;
+        unsigned int id = 0;
+        unsigned int samplesId = 0;     // bei Bedarf angelegt
+        bool countSamples = false;
+    };
+    struct Frame {
+        std::vector<Query> queries;     // wachsen nur; ids werden wiederverwendet
+        size_t used = 0;
+    };
+
+    Frame frames[Latency];
+    int current = 0;
+    bool active = false;
+    bool activeSamples = false;
+    bool initialized = false;
+    std::vector<PassTime> results;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+
+// wie in glad.h; der Header darf glad nicht einbinden (GLFW wird teils vorher inkludiert)
+typedef struct __GLsync* GLsync;
+
+// Gemeinsamer Ring-Buffer für Per-Instanz-Daten (Model-Matrizen).
+// Der Buffer ist in FramesInFlight Regionen aufgeteilt; jede Region wird nach dem Frame
+// mit einem Fence versehen und erst wieder beschrieben, wenn die GPU sie gelesen hat.
+// Mit ARB_buffer_storage bleibt der Buffer dauerhaft gemappt, sonst wird pro Upload
+// unsynchronisiert per glMapBufferRange gemappt (die Fences übernehmen die Synchronisation).
+class InstanceRingBuffer {
+public:
+    static constexpr int FramesInFlight = 3;
+
+    InstanceRingBuffer() = default;
+    ~InstanceRingBuffer();
+    InstanceRingBuffer(const InstanceRingBuffer&) = delete;
+    InstanceRingBuffer& operator=(const InstanceRingBuffer&) = delete;
+
+    void Init(size_t bytesPerFrame);
+    void Shutdown();
+
+    // Wartet auf den Fence der aktuellen Region und setzt den Schreibcursor zurück.
+    void BeginFrame();
+    // Setzt den Fence für die aktuelle Region und schaltet zur nächsten weiter.
+    void EndFrame();
+
+    // Stellt sicher, dass eine Region mindestens `bytes` aufnimmt (vergrößert ggf. den Buffer).
+    void Reserve(size_t bytes);
+
+    // Liefert einen beschreibbaren Zeiger für `bytes` Bytes; outOffset ist der Byte-Offset im GL-Buffer.
+    // Nach dem Schreiben muss Unmap() aufgerufen werden. nullptr, wenn die Region voll ist.
+    void* Map(size_t bytes, size_t& outOffset);
+    void Unmap();
+    // Ersatzweg, wenn Map() scheitert: lädt data per glBufferSubData in einen eigenen Buffer, der dafür jedes Mal
+    // verwaist wird (keine Synchronisation mit der GPU nötig). Liefert dessen Namen, die Daten beginnen bei Offset 0.
+    unsigned int UploadFallback(const void* data, size_t bytes);
+
+    unsigned int GetBuffer() const { return buffer; }
+    bool IsPersistent() const { return persistent; }
+
+    // Statistik des aktuellen Frames
+    size_t BytesThisFrame() const { return cursor; }
+    int FenceWaitsThisFrame() const { return fenceWaits; }
+    int FallbacksThisFrame() const { return fallbacks; }
+    double FenceWaitMsThisFrame() const { return fenceWaitMs; }
+
+private:
+    void Allocate(size_t bytesPerFrame);
+    void Release();
+    void WaitForFence(int region);
+
+    unsigned int buffer = 0;
+    size_t regionSize = 0;
+    int region = 0;
+    size_t cursor = 0;
+    bool persistent = false;
+    bool mapped = false;
+    unsigned char* persistentPtr = nullptr;
+    GLsync fences[FramesInFlight] = {};
+    unsigned int fallbackBuffer = 0;
+    bool fallbackLogged = false;
+
+    int fenceWaits = 0;
+    double fenceWaitMs = 0.0;
+    int fallbacks = 0;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job;
+
+// Zählt offene Jobs. Jobs können an einen Counter gehängt werden (Continuation) und starten,
+// sobald dieser auf 0 fällt. Wait() auf einen Counter arbeitet währenddessen selbst Jobs ab.
+class JobCounter {
+public:
+    int Pending() const { return pending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+    std::mutex continuationMutex;
+    std::vector<Job*> continuations;
+};
+
+// Chase-Lev Work-Stealing-Deque mit fester Kapazität.
+// Push/Pop nur vom besitzenden Thread (unten), Steal von beliebigen Threads (oben).
+class JobDeque {
+public:
+    static constexpr int64_t Capacity = 4096; // Zweierpotenz
+
+    bool Push(Job* job);
+    Job* Pop();
+    Job* Steal();
+
+private:
+    static constexpr int64_t Mask = Capacity - 1;
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<Job*> buffer[Capacity] = {};
+};
+
+// Globales Job-System: ein Worker-Thread pro Kern (minus Main-Thread), jeder mit eigener Deque.
+// Freie Worker stehlen Arbeit von zufälligen anderen Deques. Der Thread, der Initialize() aufruft,
+// ist Worker 0 und arbeitet in Wait() mit.
+class JobSystem {
+public:
+    static JobSystem& Instance();
+
+    // workerThreads = 0 -> hardware_concurrency - 1 (überschreibbar per Umgebungsvariable ARK_WORKER_THREADS)
+    void Initialize(unsigned workerThreads = 0);
+    void Shutdown();
+    bool IsInitialized() const { return initialized; }
+
+    // Anzahl der Threads, die Jobs ausführen (inklusive Main-Thread)
+    unsigned ThreadCount() const { return static_cast<unsigned>(deques.size()); }
+
+    // Startet task, sobald dependency (falls gesetzt) auf 0 gefallen ist; counter wird für die Laufzeit erhöht.
+    // Aus einem Hintergrund-Job heraus (auch über ParallelFor) landet task ebenfalls in der Hintergrund-Queue.
+    void Run(std::function<void()> task, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+    // Lange Hintergrundarbeit (z.B. Modell-Import): eigene Queue, die nur Worker ohne andere Arbeit abholen.
+    // Wait() führt sie nie aus, ein Frame blockiert also nicht auf einem Import. Ohne Worker-Threads
+    // übernimmt ein eigener Hintergrund-Thread; ohne Initialize läuft task synchron.
+    void RunBackground(std::function<void()> task, JobCounter* counter = nullptr);
+    // Blockiert, bis counter 0 ist, und führt in der Zwischenzeit selbst Jobs aus.
+    // Hintergrund-Jobs nur, wenn der Aufrufer selbst einer ist; Wait() im Main-Thread nimmt sie nie.
+    void Wait(JobCounter& counter);
+
+    // Teilt [begin, end) in Blöcke von mindestens grain Elementen und ruft fn(blockBegin, blockEnd) parallel auf.
+    // maxParallelism begrenzt die Anzahl gleichzeitig nutzbarer Threads (0 = alle).
+    void ParallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& fn, unsigned maxParallelism = 0);
+
+    static void SetCurrentThreadName(const char* name);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+
+    void WorkerLoop(unsigned index);
+    void BackgroundLoop();
+    void Schedule(Job* job);
+    void Execute(Job* job);
+    Job* FindJob(unsigned self);
+    Job* FindBackgroundJob();
+    static void Finish(JobCounter* counter);
+
+    std::vector<std::unique_ptr<JobDeque>> deques; // [0] = Main-Thread
+    std::vector<std::thread> workers;
+
+    // Jobs von Threads, die keine eigene Deque haben
+    std::mutex injectionMutex;
+    std::deque<Job*> injectionQueue;
+
+    // RunBackground: von Workern im Leerlauf bzw. dem Hintergrund-Thread abgearbeitet
+    std::mutex backgroundMutex;
+    std::deque<Job*> backgroundQueue;
+    std::atomic<int> backgroundJobs{0};
+    std::thread backgroundThread;   // nur ohne Worker-Threads
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<int> queuedJobs{0};
+    std::atomic<int> sleepingWorkers{0};
+    std::atomic<bool> quit{false};
+    bool initialized = false;
+};
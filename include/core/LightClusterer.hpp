@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "UniformBlocks.hpp"
+
+class Shader;
+
+// Clustered Forward Shading: der View-Frustum wird in GridX x GridY Kacheln und GridZ exponentielle
+// Tiefenscheiben zerlegt. Build() ordnet jedem Cluster die Punkt-/Spotlichter zu, deren Reichweite ihn
+// schneidet; der Fragment-Shader wertet nur die Lichter seines Clusters aus. Keine Obergrenze für die
+// Lichtanzahl: Lichtdaten, Cluster-Bereiche und Indexliste liegen in Texture-Buffern (GL 3.3).
+class LightClusterer {
+public:
+    // Muss zu den #defines in StandardLit.frag passen
+    static constexpr uint32_t GridX = 16;
+    static constexpr uint32_t GridY = 9;
+    static constexpr uint32_t GridZ = 24;
+    static constexpr uint32_t ClusterCount = GridX * GridY * GridZ;
+
+    // Texture-Units der drei Buffer (oberhalb der Material-Texturen)
+    static constexpr int LightDataUnit = 12;
+    static constexpr int ClusterRangeUnit = 13;
+    static constexpr int LightIndexUnit = 14;
+
+    LightClusterer() = default;
+    ~LightClusterer();
+    LightClusterer(const LightClusterer&) = delete;
+    LightClusterer& operator=(const LightClusterer&) = delete;
+
+    // GL-Ressourcen; Build() funktioniert auch ohne (z.B. im Benchmark)
+    void Init();
+    void Shutdown();
+
+    // Reine CPU-Arbeit, verteilt über das JobSystem
+    void Build(const std::vector<GpuClusterLight>& lights, const glm::mat4& view, const glm::mat4& projection,
+               float nearPlane, float farPlane);
+    // Lädt geänderte Buffer hoch (lights = dieselbe Liste wie beim letzten Build)
+    void Upload(const std::vector<GpuClusterLight>& lights);
+    // Bindet die Buffer samt Sampler-Uniforms an den aktiven Shader
+    void Bind(const Shader& shader) const;
+
+    size_t GetLightCount() const { return lightCount; }
+    size_t GetVisibleLightCount() const { return visibleCount; }
+    size_t GetIndexCount() const { return lightIndices.size(); }
+    double GetBuildMs() const { return buildMs; }
+
+    // Pro Cluster (offset, count) in lightIndices
+    const std::vector<uint32_t>& GetClusterRanges() const { return clusterRanges; }
+    const std::vector<uint32_t>& GetLightIndices() const { return lightIndices; }
+
+private:
+    struct TextureBuffer {
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+        size_t capacity = 0;            // Bytes
+        std::vector<unsigned char> shadow;
+
+        void Create(unsigned int internalFormat);
+        void Destroy();
+        // Upload nur bei Änderung; wächst bei Bedarf (glBufferData), sonst glBufferSubData
+        void Update(const void* data, size_t size, unsigned int internalFormat);
+    };
+
+    void UpdateClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+    uint32_t SliceForDepth(float depth) const;
+
+    // Cluster-AABBs im View-Space, neu berechnet nur wenn sich die Projektion ändert
+    std::vector<glm::vec3> clusterMin, clusterMax;
+    glm::mat4 boundsProjection{0.0f};
+    float boundsNear = 0.0f, boundsFar = 0.0f;
+    float sliceScale = 0.0f, sliceBias = 0.0f;
+
+    std::vector<glm::ivec4> lightBounds;    // pro Licht: min/max Kachel-x/y; (-1) = unsichtbar
+    std::vector<glm::ivec2> lightSlices;    // pro Licht: min/max Tiefenscheibe
+    std::vector<glm::vec4> lightSpheres;    // View-Space-Kugel
+    std::vector<uint32_t> lightOffsets;     // Startposition der (Cluster-)Einträge pro Licht
+    std::vector<uint32_t> pairClusters;     // Cluster-Index jedes (Licht, Cluster)-Paares
+    std::vector<uint32_t> clusterCursor;    // Schreibposition pro Cluster beim Einsortieren
+    std::vector<uint32_t> clusterRanges;
+    std::vector<uint32_t> lightIndices;
+
+    size_t lightCount = 0;
+    size_t visibleCount = 0;
+    double buildMs = 0.0;
+
+    TextureBuffer lightBuffer;
+    TextureBuffer rangeBuffer;
+    TextureBuffer indexBuffer;
+    int maxTexels = 0;
+    bool warnedOverflow = false;
+};
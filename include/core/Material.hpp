@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include "UniformBlocks.hpp"
+
+// Stabile Material-ID: Index in den Material-Buffer, 16 Bit im Sortier-Key der RenderQueue
+using MaterialId = uint16_t;
+
+// Platz einer Textur in den Texture-Array-Pools des ResourceManager; array < 0 = nicht geladen
+struct TextureLayer {
+    int16_t array = -1;
+    uint16_t layer = 0;
+};
+
+// Beschreibung eines Materials; gleiche Beschreibungen ergeben dasselbe Material-Objekt
+struct MaterialDesc {
+    std::string diffusePath;    // leer = weiß
+    std::string specularPath;   // leer = kein Glanzlicht
+    float shininess = 32.0f;
+
+    bool operator<(const MaterialDesc& o) const {
+        return std::tie(diffusePath, specularPath, shininess) < std::tie(o.diffusePath, o.specularPath, o.shininess);
+    }
+};
+
+// Vorkompiliertes Material-Asset (ResourceManager::GetMaterial). Die Texturen sind beim Anlegen einmal
+// in die Array-Pools aufgelöst, der GPU-Eintrag steht danach fest. Im Frame wird nur noch die ID
+// weitergereicht: Sortier-Key, Instanzdaten, Index in den Material-Buffer.
+class Material {
+public:
+    Material(MaterialId id, MaterialDesc desc, TextureLayer diffuse, TextureLayer specular)
+        : id(id), desc(std::move(desc)), diffuse(diffuse), specular(specular) {
+        gpu.layers = glm::vec4(diffuse.array, diffuse.layer, specular.array, specular.layer);
+        gpu.params = glm::vec4(this->desc.shininess, 0.0f, 0.0f, 0.0f);
+    }
+    Material(const Material&) = delete;
+    Material& operator=(const Material&) = delete;
+
+    MaterialId GetId() const { return id; }
+    const MaterialDesc& GetDesc() const { return desc; }
+    TextureLayer GetDiffuse() const { return diffuse; }
+    TextureLayer GetSpecular() const { return specular; }
+    float GetShininess() const { return desc.shininess; }
+    const GpuMaterial& GetGpuData() const { return gpu; }
+
+private:
+    MaterialId id;
+    MaterialDesc desc;
+    TextureLayer diffuse;
+    TextureLayer specular;
+    GpuMaterial gpu;
+};
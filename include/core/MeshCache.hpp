@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../objects/Mesh.hpp"
+
+// Gekochter Modell-Cache (.arkmesh): fertig aufbereitete Geometrie (nach MeshOptimizer, inkl. LOD-Kette)
+// bereits im Layout der GeometryArena (Vertex- und Positions-Stream, 16-/32-Bit-Indizes), dazu pro Mesh
+// Bounds, Occluder-Daten (float-Positionen, 32-Bit-Indizes) und Materialbeschreibung. Schlüssel sind der
+// Inhalts-Hash der Quelldatei und die Import-Einstellungen; die Dateien liegen unter <Projekt>/assets/cache.
+// Alle weiteren Dateien, die Assimp beim Import geöffnet hat (.mtl, .bin, ...), stehen mit Pfad und Hash im
+// Header und werden beim Öffnen geprüft. Texturen gehören nicht dazu, sie werden bei jedem Laden neu dekodiert.
+// Gelesen wird per Memory-Mapping ohne Parser: die Views zeigen direkt in die abgebildete Datei, der Upload
+// nimmt die Bytes unverändert. Das Format ist nativ (Endianness, Layouts der Arena), der Cache ist also pro
+// Rechner und nicht zum Verteilen.
+namespace MeshCache {
+    constexpr uint32_t FormatVersion = 3;
+
+    // Nur-Lese-Abbildung einer ganzen Datei
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // false, wenn die Datei fehlt oder leer ist
+        bool Open(const std::string& path);
+        void Close();
+        const unsigned char* Data() const { return data; }
+        size_t Size() const { return size; }
+
+    private:
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* file = nullptr;
+        void* mapping = nullptr;
+#endif
+    };
+
+    struct Key {
+        uint64_t source = 0;        // Inhalt der Quelldatei
+        uint64_t settings = 0;      // Import-Flags, Optimierer-/LOD-Parameter, FormatVersion
+    };
+    // false, wenn die Quelldatei nicht lesbar ist
+    bool ComputeKey(const std::string& sourcePath, uint64_t settings, Key& key);
+    // Inhalts-Hash einer Datei wie für Key::source; false, wenn sie nicht lesbar ist
+    bool HashFile(const std::string& path, uint64_t& hash);
+
+    // Weitere vom Import gelesene Datei, Pfad relativ zum Ordner der Quelle
+    struct Dependency {
+        std::string path;
+        uint64_t hash = 0;
+    };
+    // <cacheDirectory>/<Dateiname der Quelle>-<Hash>.arkmesh
+    std::string CachePath(const std::string& cacheDirectory, const std::string& sourcePath, const Key& key);
+    // assets/cache des aktuellen Projekts (ProjectManager), ohne Projekt relativ zum Arbeitsverzeichnis.
+    // Nur im Main-Thread aufrufen.
+    std::string CacheDirectory();
+
+    // Zeigt auf Daten, die jemand anderes hält: beim Schreiben die Import-Arrays, beim Lesen die Abbildung
+    struct LodView {
+        GeometryArena::EncodedGeometry geometry;
+        float error = 0.0f;
+    };
+    struct MeshView {
+        GeometryArena::EncodedGeometry geometry;    // volle Stufe, so wie sie in die Arena geht
+        // Volle Stufe für das Occlusion-Culling, gleiche Nummerierung wie geometry (vertexCount/indexCount)
+        const glm::vec3* occluderPositions = nullptr;
+        const uint32_t* occluderIndices = nullptr;
+        Bounds bounds;
+        MaterialDesc material;      // Texturpfade relativ zum Modellordner
+        std::vector<LodView> lods;
+    };
+
+    // Geöffnete .arkmesh-Datei; die Views bleiben gültig, solange das Objekt lebt
+    class CookedModel {
+    public:
+        // nullptr, wenn die Datei fehlt, zu einem anderen Schlüssel gehört, eine Abhängigkeit (relativ zu
+        // sourceDirectory) sich geändert hat oder die Datei beschädigt ist
+        static std::unique_ptr<CookedModel> Open(const std::string& path, const Key& key, const std::string& sourceDirectory);
+
+        const std::vector<MeshView>& GetMeshes() const { return meshes; }
+        const Bounds& GetBounds() const { return bounds; }
+        size_t GetFileSize() const { return file.Size(); }
+
+    private:
+        MappedFile file;
+        std::vector<MeshView> meshes;
+        Bounds bounds;
+    };
+
+    // Schreibt über eine temporäre Datei und rename, Leser sehen also nie eine halbe Datei
+    bool Write(const std::string& path, const Key& key, const std::vector<Dependency>& dependencies,
+               const std::vector<MeshView>& meshes, const Bounds& bounds);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "../objects/Mesh.hpp"
+
+// Umsortierung von Indizes und Vertices nach dem Import; die Dreiecke selbst bleiben unverändert
+// (gleiche Eckpunkte, gleiche Umlaufrichtung), nur ihre Reihenfolge und die Vertex-Nummerierung ändern sich.
+//   1. Post-Transform-Cache: Tipsify (Sander et al. 2007), Fächer um den zuletzt benutzten Vertex,
+//      linear in der Dreieckszahl
+//   2. Overdraw (optional): die Cluster aus 1. werden weiter geteilt, solange die ACMR höchstens um
+//      threshold steigt, und nach außen zeigend zuerst sortiert -> frühe Tiefentests verwerfen mehr
+//   3. Vertex-Fetch: Vertices in der Reihenfolge ihrer ersten Verwendung, unbenutzte fallen weg
+// Reine CPU-Arbeit ohne GL, läuft beim Import parallel pro Mesh.
+namespace MeshOptimizer {
+    constexpr unsigned int CacheSize = 16;     // FIFO-Größe für Tipsify und die Statistik
+
+    struct CacheStats {
+        size_t triangles = 0;
+        size_t vertices = 0;    // referenzierte Vertices
+        size_t misses = 0;      // Vertex-Shader-Aufrufe bei FIFO-Cache
+        // Average Cache Miss Ratio: Aufrufe pro Dreieck (0.5 ideal für große Gitter, 3 = kein Cache-Treffer)
+        double Acmr() const { return triangles ? static_cast<double>(misses) / triangles : 0.0; }
+        // Average Transformed Vertex Ratio: Aufrufe pro Vertex (1 = jeder Vertex genau einmal)
+        double Atvr() const { return vertices ? static_cast<double>(misses) / vertices : 0.0; }
+        CacheStats& operator+=(const CacheStats& o) {
+            triangles += o.triangles; vertices += o.vertices; misses += o.misses;
+            return *this;
+        }
+    };
+
+    CacheStats AnalyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                  unsigned int cacheSize = CacheSize);
+
+    // clusterStarts (optional) erhält den ersten Dreiecksindex jedes Clusters für OptimizeOverdraw
+    std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                                  unsigned int cacheSize = CacheSize,
+                                                  std::vector<unsigned int>* clusterStarts = nullptr);
+    void OptimizeOverdraw(std::vector<unsigned int>& indices, const Vertex* vertices, size_t vertexCount,
+                          const std::vector<unsigned int>& clusterStarts, float threshold = 1.05f);
+    void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+    struct Result {
+        CacheStats before;
+        CacheStats after;
+    };
+    // Alle Stufen nacheinander, in place
+    Result Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, bool overdraw = true);
+
+    // true, wenn beide Index-Buffer dieselbe Menge Dreiecke beschreiben (Eckpunkte bitgleich, gleiche Umlaufrichtung)
+    bool IsEquivalent(const std::vector<Vertex>& verticesA, const std::vector<unsigned int>& indicesA,
+                      const std::vector<Vertex>& verticesB, const std::vector<unsigned int>& indicesB);
+}
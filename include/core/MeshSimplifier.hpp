@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "../objects/Mesh.hpp"
+
+// Vereinfachung per Kantenkollaps mit Quadric Error Metric (Garland/Heckbert). Reine CPU-Arbeit ohne GL,
+// läuft beim Import parallel pro Mesh.
+//   - Vertices mit gleicher Position werden für die Topologie verschweißt, Attribute bleiben unverändert:
+//     ein Kollaps a -> b verschiebt a auf einen vorhandenen Vertex b (keine neuen Vertices).
+//   - Randkanten und Attribut-Nähte (gleiche Position, verschiedene Normale/UV) bleiben fest, damit
+//     weder Löcher noch aufgerissene UVs entstehen.
+//   - Kollapse, die ein Dreieck umklappen würden, werden verworfen.
+namespace MeshSimplifier {
+    // Liefert höchstens targetIndexCount Indizes (falls erreichbar, ohne targetError zu überschreiten).
+    // outError = größter angewendeter Fehler als Abstand in Modell-Einheiten.
+    std::vector<unsigned int> Simplify(const Vertex* vertices, size_t vertexCount,
+                                       const std::vector<unsigned int>& indices,
+                                       size_t targetIndexCount, float targetError, float* outError = nullptr);
+
+    struct LodLevel {
+        std::vector<Vertex> vertices;       // nur die benutzten Vertices
+        std::vector<unsigned int> indices;
+        float error = 0.0f;                 // geometrische Abweichung zur vollen Auflösung (Modell-Einheiten)
+    };
+
+    // Bis zu MaxLodLevels Stufen, jede mit etwa halber Dreieckszahl der vorigen. Leer für kleine Meshes
+    // oder wenn schon die erste Stufe kaum etwas einspart.
+    constexpr int MaxLodLevels = 4;
+    std::vector<LodLevel> BuildLodChain(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <chrono>
+#include <string>
 
 class MonitoringMetrics {
 public:
@@ -14,6 +15,24 @@ public:
     void UpdateProcessCpu();
     void UpdateMemory();
 
+    // Renderer-Statistiken (einmal pro Frame)
+    // batches = instanzierte Draws (gleiche Geometrie), drawCalls = GL-Aufrufe (mit MDI einer für alle Batches)
+    void RecordRenderQueue(double buildMs, double sortMs, size_t items, size_t batches, size_t drawCalls);
+    void RecordInstanceUpload(size_t bytes, int fenceWaits, double fenceWaitMs, int ringFallbacks);
+    void RecordCulling(size_t visible, size_t culled, double cullMs);
+    // occluded = frustum-sichtbare Objekte, die der OcclusionCuller zusätzlich verworfen hat
+    void RecordOcclusion(size_t occluded, size_t occluderTriangles, double rasterMs, double testMs);
+    // Dreiecke der gewählten LOD-Stufen gegenüber voller Auflösung (alle eingereihten Instanzen)
+    void RecordLod(size_t selectedTriangles, size_t fullTriangles, size_t reducedInstances);
+    void RecordTransformUpdate(size_t updatedNodes, double updateMs);
+    void RecordUniformUploads(size_t uniformCalls, size_t skippedCalls, size_t bufferUploads);
+    void RecordLightClusters(size_t lights, size_t visibleLights, size_t lightIndices, double buildMs);
+    // GPU-Zeit eines Render-Passes (GpuTimer); neue Namen legen eine eigene Reihe an
+    void RecordGpuPass(const char* name, double ms);
+    // Samples, die im Haupt-Pass den Tiefentest bestanden haben (= geshadete Fragmente), pro Viewport-Pixel
+    void RecordShadedFragments(long long samples, size_t pixels);
+    void RecordGeometryArena(size_t vaoBinds, size_t vertexBytes, size_t indexBytes);
+
     struct SampleSeries {
         std::vector<float> data; // ring buffer semantics
         size_t cursor = 0;
@@ -31,12 +50,59 @@ public:
     const SampleSeries& RamMB() const { return ramMBSeries; }
     const SampleSeries& VramMB() const { return vramMBSeries; }
     const SampleSeries& VramUsedMB() const { return vramUsedMBSeries; }
+    const SampleSeries& QueueBuildMs() const { return queueBuildMs; }
+    const SampleSeries& QueueSortMs() const { return queueSortMs; }
+    const SampleSeries& DrawCalls() const { return drawCallSeries; }
+    const SampleSeries& BatchingRatio() const { return batchingRatioSeries; }
+    const SampleSeries& InstanceUploadKB() const { return instanceUploadKB; }
+    const SampleSeries& FenceWaitMs() const { return fenceWaitMsSeries; }
+    const SampleSeries& CullMs() const { return cullMsSeries; }
+    const SampleSeries& VisibleObjects() const { return visibleSeries; }
+    const SampleSeries& OcclusionRasterMs() const { return occlusionRasterMs; }
+    const SampleSeries& OcclusionTestMs() const { return occlusionTestMs; }
+    const SampleSeries& LodTrianglesK() const { return lodTrianglesK; }
+    const SampleSeries& TransformUpdateMs() const { return transformUpdateMs; }
+    const SampleSeries& UniformCalls() const { return uniformCallSeries; }
+    const SampleSeries& LightClusterMs() const { return lightClusterMs; }
+    const SampleSeries& ShadedPerPixel() const { return shadedPerPixelSeries; }
+
+    struct GpuPassSeries {
+        std::string name;
+        SampleSeries ms;
+    };
+    const std::vector<GpuPassSeries>& GpuPasses() const { return gpuPasses; }
 
     float LastCpuUsage() const { return lastCpuUsage; }
     float LastRamMB() const { return lastRamMB; }
     float LastVramTotalMB() const { return lastVramTotalMB; }
     float LastVramUsedMB() const { return lastVramUsedMB; }
     float LastGpuFrameMs() const { return lastGpuFrameMs; }
+    size_t LastQueueItems() const { return lastQueueItems; }
+    float LastShadedPerPixel() const { return lastShadedPerPixel; }
+    size_t LastDrawCalls() const { return lastDrawCalls; }
+    size_t LastBatches() const { return lastBatches; }
+    // Objekte pro instanziertem Draw
+    double LastBatchingRatio() const { return lastBatches ? (double)lastQueueItems / (double)lastBatches : 0.0; }
+    int LastFenceWaits() const { return lastFenceWaits; }
+    // Frames, in denen der Ring-Buffer nicht gemappt werden konnte (seit Start)
+    size_t RingFallbackFrames() const { return ringFallbackFrames; }
+    size_t LastVisible() const { return lastVisible; }
+    size_t LastCulled() const { return lastCulled; }
+    size_t LastOccluded() const { return lastOccluded; }
+    size_t LastOccluderTriangles() const { return lastOccluderTriangles; }
+    size_t LastLodTriangles() const { return lastLodTriangles; }
+    size_t LastFullTriangles() const { return lastFullTriangles; }
+    size_t LastLodReduced() const { return lastLodReduced; }
+    size_t LastTransformUpdates() const { return lastTransformUpdates; }
+    size_t LastUniformCalls() const { return lastUniformCalls; }
+    size_t LastUniformBufferUploads() const { return lastUniformBufferUploads; }
+    size_t LastSkippedUniformCalls() const { return lastSkippedUniformCalls; }
+    size_t LastLights() const { return lastLights; }
+    size_t LastVisibleLights() const { return lastVisibleLights; }
+    size_t LastLightIndices() const { return lastLightIndices; }
+    size_t LastVaoBinds() const { return lastVaoBinds; }
+    size_t LastArenaVertexBytes() const { return lastArenaVertexBytes; }
+    size_t LastArenaIndexBytes() const { return lastArenaIndexBytes; }
 
 private:
     MonitoringMetrics();
@@ -62,11 +128,50 @@ private:
     SampleSeries ramMBSeries;
     SampleSeries vramMBSeries;      // total
     SampleSeries vramUsedMBSeries;  // used
+    SampleSeries queueBuildMs;
+    SampleSeries queueSortMs;
+    SampleSeries drawCallSeries;
+    SampleSeries batchingRatioSeries;
+    SampleSeries shadedPerPixelSeries;
+    SampleSeries instanceUploadKB;
+    SampleSeries fenceWaitMsSeries;
+    SampleSeries cullMsSeries;
+    SampleSeries visibleSeries;
+    SampleSeries occlusionRasterMs;
+    SampleSeries occlusionTestMs;
+    SampleSeries lodTrianglesK;     // gewählte Dreiecke in Tausend
+    SampleSeries transformUpdateMs;
+    SampleSeries uniformCallSeries;
+    SampleSeries lightClusterMs;
+    std::vector<GpuPassSeries> gpuPasses;
 
     float lastCpuUsage = 0.f;
     float lastRamMB = 0.f;
     float lastVramTotalMB = 0.f;
     float lastVramUsedMB = 0.f;
     float lastGpuFrameMs = 0.f;
+    size_t lastQueueItems = 0;
+    size_t lastDrawCalls = 0;
+    size_t lastBatches = 0;
+    float lastShadedPerPixel = 0.0f;
+    int lastFenceWaits = 0;
+    size_t ringFallbackFrames = 0;
+    size_t lastVisible = 0;
+    size_t lastCulled = 0;
+    size_t lastOccluded = 0;
+    size_t lastOccluderTriangles = 0;
+    size_t lastLodTriangles = 0;
+    size_t lastFullTriangles = 0;
+    size_t lastLodReduced = 0;
+    size_t lastTransformUpdates = 0;
+    size_t lastUniformCalls = 0;
+    size_t lastUniformBufferUploads = 0;
+    size_t lastSkippedUniformCalls = 0;
+    size_t lastLights = 0;
+    size_t lastVisibleLights = 0;
+    size_t lastLightIndices = 0;
+    size_t lastVaoBinds = 0;
+    size_t lastArenaVertexBytes = 0;
+    size_t lastArenaIndexBytes = 0;
     std::chrono::high_resolution_clock::time_point cpuFrameStart;
 };
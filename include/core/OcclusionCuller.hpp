@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Software-Occlusion-Culling: ausgewählte Occluder (Wände, Böden, große Objekte) werden auf der CPU in einen
+// kleinen Tiefenpuffer gerastert (Half-Space-Rasterisierung, 4 Pixel pro Schritt mit SSE, Zeilenbänder parallel
+// über das JobSystem). Aus dem Puffer entsteht eine Hi-Z-Pyramide (Maximum der Tiefe je 2x2), gegen die
+// Welt-AABBs getestet werden. Kein GL, läuft also auch headless (Benchmark).
+class OcclusionCuller {
+public:
+    static constexpr int Width = 256;
+    static constexpr int Height = 128;
+    static constexpr int BandHeight = 8;                    // Zeilen pro Job
+    static constexpr int BandCount = Height / BandHeight;
+    static constexpr int LevelCount = 9;                    // 256x128 ... 1x1
+
+    OcclusionCuller();
+
+    // Verwirft alle Occluder; viewProj gilt für Rasterisierung und Tests bis zum nächsten Begin
+    void Begin(const glm::mat4& viewProj);
+    // Merkt sich das Mesh nur (Positionen mit stride Bytes Abstand); die Daten müssen bis Rasterize() gültig bleiben
+    void AddOccluder(const glm::vec3* positions, size_t stride, size_t vertexCount,
+                     const uint32_t* indices, size_t indexCount, const glm::mat4& model);
+    // Transformiert und clippt die Dreiecke (parallel pro Occluder), rastert sie (parallel pro Band)
+    // und baut die Hi-Z-Pyramide
+    void Rasterize();
+
+    // true = die Welt-AABB liegt vollständig hinter den Occludern. Konservativ: Boxen, die die
+    // Near-Plane schneiden oder außerhalb des Bildes liegen, gelten als sichtbar.
+    bool IsOccluded(const glm::vec3& center, const glm::vec3& extents) const;
+
+    size_t GetOccluderCount() const { return occluders.size(); }
+    size_t GetTriangleCount() const { return triangleCount; }
+    double GetRasterMs() const { return rasterMs; }
+    // Tiefe in [0,1] (1 = nichts gerastert); Zeile 0 ist unten
+    float GetDepth(int x, int y) const { return depth[static_cast<size_t>(y) * Width + x]; }
+    float GetHiZ(int level, int x, int y) const;
+
+private:
+    struct Occluder {
+        const glm::vec3* positions;
+        size_t stride;
+        size_t vertexCount;
+        const uint32_t* indices;
+        size_t indexCount;
+        glm::mat4 mvp;
+    };
+    // Dreieck in Pixelkoordinaten, gegen den Uhrzeigersinn; Tiefe als Ebene z = z0 + dzdx * x + dzdy * y
+    struct ScreenTriangle {
+        float x[3], y[3];
+        float z0, dzdx, dzdy;
+        int minX, minY, maxX, maxY;
+    };
+
+    void SetupOccluder(const Occluder& occluder, std::vector<ScreenTriangle>& out) const;
+    void EmitTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c, std::vector<ScreenTriangle>& out) const;
+    void RasterizeBand(int band);
+    void BuildHiZ();
+
+    glm::mat4 viewProj{1.0f};
+    std::vector<Occluder> occluders;
+    std::vector<std::vector<ScreenTriangle>> occluderTriangles;    // pro Occluder, über Frames wiederverwendet
+    std::vector<const ScreenTriangle*> bands[BandCount];           // Dreiecke, deren Bounding-Box das Band trifft
+    std::vector<float> depth;                                       // Width * Height
+    std::vector<float> hiZ;                                         // alle Level hintereinander
+    int levelOffset[LevelCount] = {};
+    int levelWidth[LevelCount] = {};
+    int levelHeight[LevelCount] = {};
+    size_t triangleCount = 0;
+    double rasterMs = 0.0;
+};
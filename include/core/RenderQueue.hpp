@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "GeometryArena.hpp"
+#include "Material.hpp"
+
+class Mesh;
+
+// Ein Eintrag pro sichtbarer Instanz. Der Key bestimmt die Zeichenreihenfolge,
+// instanceIndex zeigt in RenderQueue::instances, material in die Material-Tabelle des ResourceManager.
+// geometry ist das Arena-Handle der gewählten LOD-Stufe des Meshes.
+struct DrawItem {
+    uint64_t key = 0;
+    Mesh* mesh = nullptr;
+    uint32_t geometry = 0;
+    uint32_t instanceIndex = 0;
+    MaterialId material = 0;
+};
+
+// Persistente Render-Queue: alle Buffer bleiben über Frames erhalten (Clear setzt nur die Größe zurück),
+// sortiert wird per LSD-Radix-Sort über die 64-Bit-Keys.
+//
+// Key-Layout (MSB -> LSB):
+//   [63..56] Shader    (8 Bit)
+//   [55..32] Geometrie (24 Bit, Handle in der GeometryArena)
+//   [31..16] Tiefe     (16 Bit, vorne -> hinten)
+//   [15.. 0] Material  (16 Bit)
+// Materialien kosten keinen State-Wechsel mehr (Texture-Arrays, Index pro Instanz), daher wird
+// nach Geometrie gruppiert: gleiche Geometrie mit verschiedenen Materialien ergibt einen Batch.
+// Innerhalb eines Batches liegen die Instanzen vorne -> hinten, BuildBatches ordnet die Batches
+// nach ihrer vordersten Instanz (frühe Tiefentests verwerfen dahinterliegende Fragmente).
+class RenderQueue {
+public:
+    static uint64_t MakeKey(uint32_t shaderId, uint32_t geometryId, MaterialId materialId, float depth01);
+
+    void Clear();
+    void Reserve(size_t count);
+    // Bei kompakten Vertex-Formaten wird die Dequantisierung der Positionen in die Instanz gefaltet
+    void Push(Mesh* mesh, uint32_t geometry, const InstanceData& instance, uint64_t key);
+    void Sort();
+
+    const std::vector<DrawItem>& Items() const { return items; }
+    const InstanceData& Instance(uint32_t index) const { return instances[index]; }
+    size_t Size() const { return items.size(); }
+
+    // Zusammenhängender Block gleicher Geometrie in der sortierten Reihenfolge.
+    // first/count beziehen sich auf die von WriteInstanceData geschriebenen Instanzen.
+    struct Batch {
+        Mesh* mesh = nullptr;           // Repräsentant (Bounds, Material)
+        uint32_t geometry = 0;          // gemeinsames Arena-Handle aller Items
+        VertexFormat format = VertexFormat::Standard;   // Pool in der GeometryArena (VAO, Index-Typ)
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t order = 0;             // Shader und Tiefe der vordersten Instanz
+    };
+
+    // Läuft einmal linear über die sortierten Items, fasst gleiche Geometrie zusammen und
+    // sortiert die Batches nach Vertex-Format (ein VAO-Bind pro Format) und pro Shader vorne -> hinten.
+    const std::vector<Batch>& BuildBatches();
+    const std::vector<Batch>& Batches() const { return batches; }
+
+    // Schreibt die Instanzdaten aller Items in sortierter Reihenfolge nach dst (Size() Einträge)
+    void WriteInstanceData(InstanceData* dst) const;
+
+private:
+    std::vector<DrawItem> items;
+    std::vector<DrawItem> scratch;      // Ping-Pong-Buffer für den Radix-Sort
+    std::vector<InstanceData> instances;
+    std::vector<Batch> batches;
+};
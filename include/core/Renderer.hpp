@@ -19,6 +19,15 @@
 #include "../objects/Grid.hpp"
 #include "InputSystem.hpp"
 #include "../objects/SpotLight.hpp"
+#include "RenderQueue.hpp"
+#include "InstanceRingBuffer.hpp"
+#include "FrustumCuller.hpp"
+#include "OcclusionCuller.hpp"
+#include "GpuCuller.hpp"
+#include "UniformBuffer.hpp"
+#include "UniformBlocks.hpp"
+#include "LightClusterer.hpp"
+#include "GpuTimer.hpp"
 
 class Renderer {
 public:
@@ -35,25 +44,86 @@ private:
     bool escPressedLastFrame = false; // unused now but kept if needed later
 
     std::vector<Mesh*> cachedMeshes;
-    bool meshesDirty = true;
+    uint64_t cachedMeshRevision = ~0ull; // Scene-Revision, zu der cachedMeshes gebaut wurde
+
+    RenderQueue renderQueue;
+    InstanceRingBuffer instanceRing;
+    // Multi-Draw-Indirect: ein Kommando pro Batch, pro Frame neu befüllt
+    GLuint indirectBuffer = 0;
+    std::vector<DrawElementsIndirectCommand> indirectCommands;
+    size_t instanceBaseOffset = 0;  // Offset der Instanzdaten des aktuellen Frames im Ring-Buffer
+    GLuint instanceSource = 0;      // Buffer, aus dem die Draws die Instanzen lesen (Ring, Ersatz-Buffer oder GPU-Culling)
+    std::vector<InstanceData> instanceStaging;  // nur wenn das Mapping des Ring-Buffers scheitert
+
+    // std140-Blöcke; Upload nur bei Änderung gegenüber dem letzten Frame
+    UniformBuffer cameraUbo;
+    UniformBuffer lightUbo;
+
+    // Punkt-/Spotlichter: pro Frame gepackt und in Cluster einsortiert, keine Obergrenze
+    LightClusterer lightClusterer;
+    std::vector<GpuClusterLight> clusterLights;
+
+    // Frustum-Culling: Kandidaten werden gesammelt, blockweise getestet und nur sichtbare in die Queue gelegt
+    bool frustumCulling = true;
+    FrustumCuller culler;
+    std::vector<Mesh*> cullMeshes;
+    // Einheitswürfel für Modelle, deren Asset noch importiert wird
+    std::shared_ptr<Mesh> modelPlaceholder;
+    std::vector<Entity> cullEntities;
+    std::vector<const WorldTransformComponent*> cullTransforms; // nur innerhalb eines Frames gültig
+    std::vector<uint32_t> cullVersions; // Transform-Version, mit der die AABB im Culler berechnet wurde
+    std::vector<uint8_t> cullVisibility;
+    std::vector<uint8_t> cullLods;          // zuletzt gewählte LOD-Stufe pro Eintrag (Hysterese)
+    // Occlusion-Culling (RenderSettings::occlusionCulling): Occluder-Meshes auf der CPU rastern,
+    // danach die übrigen frustum-sichtbaren Boxen gegen die Hi-Z-Pyramide testen
+    OcclusionCuller occlusionCuller;
+    std::vector<uint8_t> cullOccluders;     // 1 = Eintrag gehört zu einem Objekt mit OccluderComponent
+    // GPU-Culling (RenderSettings::gpuCulling, nur Compute-Pfad): ersetzt das Frustum-Culling auf der CPU
+    GpuCuller gpuCuller;
+    std::vector<InstanceData> gpuCullInstances;
+    std::vector<CullBounds> gpuCullBounds;
 
     GLuint viewportFBO = 0;
     GLuint viewportTexture = 0;
     GLuint viewportRBO = 0;
     int viewportWidth = 1280, viewportHeight = 720;
 
+    // Deferred-Pfad: G-Buffer in Viewport-Größe (Albedo + Specular, Normalen, Tiefe),
+    // Beleuchtung als Vollbild-Pass über die Lichtcluster
+    GLuint gBufferFBO = 0;
+    GLuint gAlbedoSpec = 0;
+    GLuint gNormal = 0;
+    GLuint gDepth = 0;
+    GLuint fullscreenVAO = 0;
+    std::shared_ptr<Shader> gBufferShader;
+    std::shared_ptr<Shader> deferredLightingShader;
+    // Depth-Pre-Pass (RenderSettings::depthPrepass)
+    std::shared_ptr<Shader> depthShader;
+
+    GpuTimer gpuTimer;
+
     unsigned int lightVAO = 0, lightVBO = 0;
 
     void CreateViewportFBO(int width, int height);
     void DeleteViewportFBO();
+    void CreateGBuffer(int width, int height);
+    void DeleteGBuffer();
     void UpdateFPS();
     void LimitFPS(double frameStart, double targetFPS);
     void UpdateMeshCache();
-    void RenderMeshes();
+    void BuildRenderQueue(float aspect);
+    bool UseGpuCulling() const;
+    // Baut Queue, Batches und Instanzdaten und zeichnet sie mit meshShader (GPU-Pass passName),
+    // bei aktivem Depth-Pre-Pass vorher nur die Tiefe
+    void RenderMeshes(float aspect, Shader& meshShader, const char* passName);
+    // Zeichnet die Batches des aktuellen Frames; liefert die Anzahl GL-Draw-Aufrufe
+    size_t DrawBatches(Shader& passShader, bool positionOnly);
+    void RenderForward(float aspect);
+    void RenderDeferred(float aspect);
     void RenderGrid(float aspect);
-    void SetProjectionMatrix(const glm::mat4& projection, const glm::mat4& view);
+    void UpdateCameraBlock(float aspect);
     void SetMaterials();
-    void SetLighting(Shader& shader);
+    void SetLighting(float aspect);
 
     Window& window;
     Scene& scene;
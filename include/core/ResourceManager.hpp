@@ -5,26 +5,112 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include "Shader.hpp"
-#include "../objects/Model.hpp"
+#include "Material.hpp"
+#include "UniformBlocks.hpp"
+#include "../objects/Mesh.hpp"
+#include "JobSystem.hpp"
 
-class Model;
+class ModelAsset;
 
 class ResourceManager {
 public:
+    // Pools: ein GL_TEXTURE_2D_ARRAY (RGBA8) pro quadratischer Größenklasse MinArraySize..MaxArraySize.
+    // Texturen werden auf ihre Klasse skaliert; größere auf MaxArraySize verkleinert.
+    static constexpr int MinArraySize = 64;
+    static constexpr int MaxArraySize = 2048;
+    static constexpr int TextureArrayCount = 6;
+    // Texture-Units der Pools (TextureArrayUnit + i) und des Material-Buffers
+    static constexpr int TextureArrayUnit = 3;
+    static constexpr int MaterialUnit = 11;
+    static constexpr size_t MaxMaterials = 0x10000;
+
     static unsigned int GetTexture(const std::string& path);
+    // Lädt eine Textur in den passenden Array-Pool (einmal pro Pfad)
+    static TextureLayer GetTextureLayer(const std::string& path);
+    // Dekodiert alle noch nicht geladenen Texturen parallel im JobSystem, Upload in die Pools danach im GL-Thread
+    static void PreloadTextures(const std::vector<std::string>& paths);
+    // RGBA8-Bild nach stbi_load, noch ohne GL-Objekt
+    struct DecodedTexture {
+        std::string path;
+        std::unique_ptr<unsigned char, void (*)(void*)> data{ nullptr, nullptr };
+        int width = 0, height = 0;
+    };
+    // Reine CPU-Arbeit ohne Zugriff auf den Cache, darf aus Worker-Threads kommen (z.B. Modell-Import)
+    static std::vector<DecodedTexture> DecodeTextures(const std::vector<std::string>& paths);
+    // Nur im Context-Thread: bisher nicht geladene Bilder in die Array-Pools
+    static void UploadTextures(std::vector<DecodedTexture>& decoded);
     static void ClearTextures();
 
+    // Material-Assets, interned über die Beschreibung. Texturen werden beim ersten Anlegen geladen.
+    // Über MaxMaterials hinaus gibt es das Standardmaterial (ID 0) zurück.
+    static std::shared_ptr<Material> GetMaterial(const MaterialDesc& desc);
+    // Weiß, ohne Texturen; hat immer die ID 0
+    static std::shared_ptr<Material> GetDefaultMaterial();
+    static size_t GetMaterialCount() { return materials.size(); }
+    // Einmal pro Frame vor dem Zeichnen: Material-Buffer hochladen und Mipmaps neu befüllter Pools erzeugen
+    static void UploadMaterials();
+    // Bindet alle Pools und den Material-Buffer samt Sampler-Uniforms an den aktiven Shader
+    static void BindMaterials(Shader& shader);
+    static size_t GetTextureArrayBytes();
+
     static std::shared_ptr<Shader> GetShader(const std::string& vertexPath, const std::string& fragmentPath);
     static void ClearShaders();
 
-    static std::shared_ptr<Model> GetModel(const std::string& path);
+    // Importierte Modelle, einmal pro Pfad. Szenenobjekte sind leichte Model-Instanzen darauf;
+    // nach ClearModels behalten bestehende Instanzen ihr Asset, neue importieren frisch.
+    // Der Import läuft im Hintergrund (JobSystem::RunBackground); das Asset ist sofort gültig, aber erst nach
+    // UpdateModelImports Ready.
+    static std::shared_ptr<ModelAsset> GetModelAsset(const std::string& path);
+    static size_t GetModelAssetCount() { return models.size(); }
     static void ClearModels();
+    // Einmal pro Frame im Context-Thread: GPU-Upload fertig geparster Modelle, höchstens budgetMs lang.
+    // Abgebrochene oder fehlgeschlagene Imports fallen aus dem Cache, ein erneuter Aufruf versucht es neu.
+    static void UpdateModelImports(double budgetMs = 4.0);
+    // Laufende Imports (für Fortschrittsanzeige und Abbrechen)
+    static const std::vector<std::shared_ptr<ModelAsset>>& GetModelImports() { return modelImports; }
+    // Bricht alle Imports ab und wartet auf die Worker; vor JobSystem::Shutdown aufrufen
+    static void CancelModelImports();
+
+    // Eingebaute Formen: ein Mesh pro Form und Material, geteilt von allen Objekten dieser Form
+    // (ein Mesh-Key, ein Batch). vertices/indices werden nur beim ersten Aufruf pro Paar aufgerufen.
+    enum class Primitive : uint8_t { Cube, Plane };
+    static std::shared_ptr<Mesh> GetPrimitiveMesh(Primitive primitive, const std::shared_ptr<Material>& material,
+                                                  std::vector<Vertex> (*vertices)(), std::vector<unsigned int> (*indices)());
+    static size_t GetPrimitiveMeshCount() { return primitives.size(); }
+    static void ClearPrimitives();
 
 
 private:
+    static unsigned int UploadTexture(unsigned char* data, int w, int h, int c);
+
+    struct TextureArrayPool {
+        unsigned int texture = 0;
+        uint32_t layers = 0;
+        uint32_t capacity = 0;
+        bool mipsDirty = false;
+    };
+    // data = RGBA8, w x h; skaliert per Blit auf die Größenklasse
+    static TextureLayer UploadTextureLayer(const unsigned char* data, int w, int h);
+    static void GrowTextureArray(int array, uint32_t newCapacity);
+
     static std::map<std::string, unsigned int> textures;
+    static std::map<std::string, TextureLayer> textureLayers;
+    static TextureArrayPool textureArrays[TextureArrayCount];
+    static unsigned int copyFramebuffers[2];     // Lese-/Schreib-FBO für Skalieren und Umkopieren
+
+    static std::map<MaterialDesc, std::shared_ptr<Material>> materialCache;
+    static std::vector<GpuMaterial> materials;     // Index = MaterialId
+    static unsigned int materialBuffer;
+    static unsigned int materialTexture;
+    static size_t materialCapacity;
+    static bool materialsDirty;
     static std::map<std::string, std::shared_ptr<Shader>> shaders;
-    static std::map<std::string, std::shared_ptr<Model>> models;
+    static std::map<std::string, std::shared_ptr<ModelAsset>> models;
+    static std::vector<std::shared_ptr<ModelAsset>> modelImports;
+    static JobCounter modelImportJobs;
+    static std::map<std::pair<Primitive, MaterialId>, std::shared_ptr<Mesh>> primitives;
 
 };
\ No newline at end of file
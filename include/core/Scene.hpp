@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <unordered_map>
 #include "../objects/GameObject.hpp"
 #include "../../include/core/Scene.hpp"
 #include "../../include/objects/Light.hpp"
@@ -17,12 +19,42 @@ public:
     void RemoveObjectAt(size_t index);
     void Clear();
 
+    // Objekte mit Mesh(es) als Occluder für das CPU-Occlusion-Culling markieren (OccluderComponent).
+    // Die Markierung gehört zur Scene und wird beim Entfernen des Objekts mit gelöscht.
+    void SetOccluder(const GameObject& obj, bool occluder);
+    bool IsOccluder(const GameObject& obj) const;
+
+    // Berechnet alle dirty Welt-Matrizen neu (Wurzeln zuerst, dann deren Kinder).
+    // Liefert die Anzahl aktualisierter Objekte.
+    size_t UpdateTransforms();
+
     std::vector<std::shared_ptr<GameObject>>& GetObjects();
     const std::vector<std::shared_ptr<GameObject>>& GetObjects() const;
 
+    // Index-Listen pro Kategorie (Indizes in GetObjects()), bei Add/Remove inkrementell gepflegt
+    const std::unordered_map<Mesh*, std::vector<size_t>>& GetRenderablesByMesh() const { return renderablesByMesh; }
+    const std::vector<size_t>& GetPointLights() const { return pointLights; }
+    const std::vector<size_t>& GetSpotLights() const { return spotLights; }
+    const std::vector<size_t>& GetDirectionalLights() const { return directionalLights; }
+    const std::vector<size_t>& GetModels() const { return models; }
+    // Wird bei jeder Änderung der Objektliste erhöht
+    uint64_t GetRevision() const { return revision; }
+
     void Save(const std::string& filename) const;
     bool Load(const std::string& filename);
 
 private:
+    // Trägt das Objekt in die Kategorie-Listen ein und hängt die passenden Komponenten an;
+    // Render-/Licht-Komponenten existieren nur, solange das Objekt in der Scene ist
+    void RegisterObject(size_t index);
+    void UnregisterObject(size_t index);
+    static void RemoveComponents(const GameObject& obj);
+
     std::vector<std::shared_ptr<GameObject>> objects;
+    std::unordered_map<Mesh*, std::vector<size_t>> renderablesByMesh;
+    std::vector<size_t> pointLights;
+    std::vector<size_t> spotLights;
+    std::vector<size_t> directionalLights;
+    std::vector<size_t> models;
+    uint64_t revision = 0;
 };
\ No newline at end of file
@@ -4,25 +4,101 @@
 #ifndef INC_3DRENDERER_SHADER_HPP
 #define INC_3DRENDERER_SHADER_HPP
 
+#include <cstdint>
+#include <initializer_list>
 #include <string>
+#include <vector>
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+// FNV-1a über den Uniform-Namen; constexpr, damit Handles im Hot-Path zur Compile-Zeit feststehen:
+//   static constexpr UniformId Shininess("material.shininess");
+struct UniformId {
+    uint32_t hash = 0;
+
+    constexpr UniformId() = default;
+    constexpr explicit UniformId(const char* name) : hash(Hash(name)) {}
+
+    static constexpr uint32_t Hash(const char* name) {
+        uint32_t h = 2166136261u;
+        for (; *name; ++name) {
+            h ^= static_cast<uint8_t>(*name);
+            h *= 16777619u;
+        }
+        return h ? h : 1u; // 0 markiert freie Slots
+    }
+    constexpr bool operator==(const UniformId& o) const { return hash == o.hash; }
+};
+
 class Shader
 {
 public:
     unsigned int ID;
     Shader(const char* vertexPath, const char* fragmentPath);
+    // Compute-Programm (GL 4.3 / ARB_compute_shader)
+    explicit Shader(const char* computePath);
+    // Programm ohne Fragment-Stufe: die Ausgaben des Geometry-Shaders gehen per Transform Feedback
+    // (interleaved, in der Reihenfolge von feedbackVaryings) in einen Buffer
+    Shader(const char* vertexPath, const char* geometryPath, const std::vector<const char*>& feedbackVaryings);
     void Use();
+
+    // Bequeme Variante: Hash des Namens zur Laufzeit, aber kein glGetUniformLocation
     void SetBool(const std::string &name, bool value) const;
     void SetInt(const std::string &name, int value) const;
     void SetFloat(const std::string &name, float value) const;
     void SetMat4(const std::string& name, const glm::mat4& mat) const;
     void SetVec3(const std::string& name, const glm::vec3& vec) const;
+
+    // Hot-Path: Integer-Lookup in der reflektierten Tabelle, keine Allokation.
+    // Unveränderte Werte werden nicht erneut hochgeladen.
+    void Set(UniformId id, int value) const;
+    void Set(UniformId id, float value) const;
+    void Set(UniformId id, const glm::vec3& value) const;
+    void Set(UniformId id, const glm::vec4& value) const;
+    void Set(UniformId id, const glm::mat4& value) const;
+
+    bool HasUniform(UniformId id) const { return FindUniform(id) != nullptr; }
+    int GetUniformLocation(UniformId id) const;
+    // Index des aktiven Uniform-Blocks oder -1
+    int GetUniformBlockIndex(UniformId id) const;
+
+    // Verbindet einen Uniform-Block mit einem Binding-Punkt (ignoriert, wenn der Block fehlt)
+    void BindUniformBlock(const char* blockName, unsigned int binding) const;
+
+    // Anzahl der glUniform*-Aufrufe aller Shader seit dem letzten Aufruf
+    static size_t ConsumeUniformCallCount();
+    // Anzahl der übersprungenen Aufrufe (Wert unverändert) seit dem letzten Aufruf
+    static size_t ConsumeSkippedUniformCount();
 private:
+    // Eintrag der offenen Hash-Tabelle (lineares Sondieren); hält den zuletzt gesetzten Wert
+    struct UniformSlot {
+        uint32_t hash = 0;
+        int location = -1;
+        unsigned int type = 0;
+        bool valid = false;     // value enthält den aktuellen Programmzustand
+        float value[16] = {};
+    };
+    struct UniformBlockInfo {
+        uint32_t hash = 0;
+        int index = -1;
+        int dataSize = 0;
+    };
+
+    void ReflectUniforms();
+    void InsertUniform(uint32_t hash, int location, unsigned int type);
+    UniformSlot* FindUniform(UniformId id) const;
+    // true, wenn sich der Wert geändert hat (und der Cache aktualisiert wurde)
+    bool UpdateCache(UniformSlot& slot, const void* data, size_t bytes) const;
+
+    mutable std::vector<UniformSlot> uniformTable; // Größe = Zweierpotenz
+    std::vector<UniformBlockInfo> uniformBlocks;
+
+    static size_t uniformCalls;
+    static size_t skippedUniformCalls;
+
     std::string LoadShaderCode(const char* path);
     unsigned int CompileShader(const char* code, int type);
-    void LinkProgram(unsigned int vertex, unsigned int fragment);
+    void LinkProgram(std::initializer_list<unsigned int> stages, const std::vector<const char*>& feedbackVaryings = {});
 };
 
 #endif //INC_3DRENDERER_SHADER_HPP
\ No newline at end of file
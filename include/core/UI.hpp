@@ -38,6 +38,7 @@ public:
     bool IsViewportHovered() const { return viewportHoveredFrame; }
 
     SelectionState& GetSelectionState() { return selectionState; }
+    RenderSettings& GetRenderSettings() { return renderSettings; }
 
 private:
     void SetStyle();
@@ -55,6 +56,7 @@ private:
     // Panel-Verwaltung
     std::vector<std::unique_ptr<IPanel>> panels;
     SelectionState selectionState; // nutzt Definition aus PanelContext.hpp
+    RenderSettings renderSettings;
     GLFWwindow* window;
     Window* windowObj;
 };
\ No newline at end of file
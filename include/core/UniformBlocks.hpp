@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include "glm/glm.hpp"
+
+// Feste Binding-Punkte der Uniform-Blöcke. Shader::LinkProgram verbindet gleichnamige Blöcke automatisch.
+namespace UniformBinding {
+    constexpr unsigned int Camera   = 0;
+    constexpr unsigned int Lights   = 1;
+}
+
+// CPU-Spiegel der std140-Blöcke in den Shadern. Nur vec4/mat4 (bzw. 4er-Gruppen von Skalaren),
+// damit das C++-Layout ohne manuelles Padding dem std140-Layout entspricht.
+
+struct CameraBlock {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 invViewProjection;
+    glm::vec4 position;     // xyz = Kamera in Weltkoordinaten
+    glm::vec4 clipPlanes;   // x = near, y = far, zw = Viewport-Größe in Pixeln
+};
+
+struct GpuDirLight {
+    glm::vec4 direction;    // xyz
+    glm::vec4 color;        // rgb, a = 1 wenn aktiv
+};
+
+// Punkt- und Spotlichter liegen nicht im UBO, sondern als 4 Texel pro Licht im Texture-Buffer
+// des Clustered Shading (siehe LightClusterer)
+struct GpuClusterLight {
+    glm::vec4 positionRange;        // xyz = Position, w = Reichweite
+    glm::vec4 colorType;            // rgb = Farbe, a = 0 Punkt / 1 Spot
+    glm::vec4 attenuationCutOff;    // constant, linear, quadratic, cos(inner)
+    glm::vec4 directionOuterCutOff; // xyz = Richtung, w = cos(outer)
+};
+
+struct LightBlock {
+    GpuDirLight dirLight;
+    int32_t counts[4];      // x = Lichter im Cluster-Buffer, y = davon sichtbar
+};
+
+// Materialien liegen als 2 Texel pro Eintrag im Material-Buffer (ResourceManager); der Index kommt
+// pro Instanz aus dem Ring-Buffer. Array-Index < 0 = keine Textur (Diffuse weiß, Specular schwarz).
+struct GpuMaterial {
+    glm::vec4 layers;       // Diffuse-Array, Diffuse-Layer, Specular-Array, Specular-Layer
+    glm::vec4 params;       // x = shininess
+};
+
+static_assert(sizeof(CameraBlock) == 4 * 64 + 2 * 16, "CameraBlock muss std140 entsprechen");
+static_assert(sizeof(GpuClusterLight) == 64, "GpuClusterLight muss 4 RGBA32F-Texeln entsprechen");
+static_assert(sizeof(LightBlock) == 32 + 16, "LightBlock muss std140 entsprechen");
+static_assert(sizeof(GpuMaterial) == 32, "GpuMaterial muss 2 RGBA32F-Texeln entsprechen");
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Uniform Buffer an einem festen Binding-Punkt. Update() vergleicht mit der zuletzt hochgeladenen
+// Kopie und ruft glBufferSubData nur bei tatsächlicher Änderung auf.
+class UniformBuffer {
+public:
+    UniformBuffer() = default;
+    ~UniformBuffer();
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void Init(size_t size, unsigned int binding);
+    void Shutdown();
+
+    // Liefert true, wenn hochgeladen wurde
+    bool Update(const void* data, size_t size);
+    template<typename T>
+    bool Update(const T& block) { return Update(&block, sizeof(T)); }
+
+    unsigned int GetBuffer() const { return buffer; }
+    unsigned int GetBinding() const { return binding; }
+
+    // Anzahl der Buffer-Uploads aller UBOs seit dem letzten Aufruf
+    static size_t ConsumeUploadCount();
+
+private:
+    unsigned int buffer = 0;
+    unsigned int binding = 0;
+    std::vector<unsigned char> shadow;
+    bool valid = false;
+
+    static size_t uploadCount;
+};
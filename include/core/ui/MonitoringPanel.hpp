@@ -1,11 +1,15 @@
 #pragma once
 #include "IPanel.hpp"
 #include "../MonitoringMetrics.hpp"
+#include "../Benchmarks.hpp"
+#include <vector>
 
 class MonitoringPanel : public IPanel {
 public:
     const char* Name() const override { return "Monitoring"; }
     void Draw(PanelContext& ctx) override;
 private:
+    std::vector<BenchmarkResult> benchmarkResults;
+    void DrawBenchmarks(PanelContext& ctx);
     void PlotSeries(const char* label, const MonitoringMetrics::SampleSeries& series, const char* unitFmt, float scale = 0.f, bool autoScale = true);
 };
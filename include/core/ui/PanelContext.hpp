@@ -5,8 +5,24 @@ struct Mesh; // forward
 
 struct SelectionState { int selectedObject = 0; };
 
+// Zur Laufzeit umschaltbare Renderer-Optionen; gehören der UI, der Renderer liest sie jeden Frame
+enum class RenderPath { Forward, Deferred };
+struct RenderSettings {
+    RenderPath path = RenderPath::Forward;
+    // Tiefe vorab mit reinem Positions-Stream, danach Shading nur für GL_EQUAL-Fragmente
+    bool depthPrepass = false;
+    // Objekte hinter Occludern (OccluderComponent) vor dem Einreihen verwerfen
+    bool occlusionCulling = false;
+    // Frustum-Culling pro Instanz auf der GPU (Compute bzw. Transform Feedback) statt auf der CPU
+    bool gpuCulling = false;
+    // LOD-Stufe pro Instanz nach projiziertem Fehler; lodErrorPixels = erlaubte Abweichung auf dem Bildschirm
+    bool lod = true;
+    float lodErrorPixels = 1.0f;
+};
+
 struct PanelContext {
     Scene* scene = nullptr;
     const std::vector<Mesh*>* meshes = nullptr; // optional
     SelectionState* selection = nullptr;        // gemeinsame Objektselektion
+    RenderSettings* renderSettings = nullptr;   // optional
 };
@@ -8,33 +8,22 @@
 
 class Cube : public Shapes {
 public:
-    Cube(const std::vector<Texture>& textures = {}) {
-        mesh = std::make_shared<Mesh>(
-                GetVertices(),
-                GetIndices(),
-                textures.empty() ? GetDefaultTextures() : textures
-        );
+    // Alle Würfel mit gleichem Material teilen sich einen Mesh (ResourceManager::GetPrimitiveMesh)
+    explicit Cube(std::shared_ptr<Material> material = nullptr) : Shapes(ObjectType::Cube) {
+        mesh = ResourceManager::GetPrimitiveMesh(ResourceManager::Primitive::Cube,
+                                                 material ? material : GetDefaultMaterial(),
+                                                 &GetVertices, &GetIndices);
     }
 private:
-    static std::vector<Texture> GetDefaultTextures() {
-        std::vector<Texture> textures;
-        // Diffuse-Textur
-        Texture diffuse;
-        diffuse.id = ResourceManager::GetTexture("resources/images/container2.png");
-        diffuse.type = "texture_diffuse";
-        diffuse.path = "resources/images/container2.png";
-        textures.push_back(diffuse);
-
-        // Specular-Textur
-        Texture specular;
-        specular.id = ResourceManager::GetTexture("resources/images/container2_specular.png");
-        specular.type = "texture_specular";
-        specular.path = "resources/images/container2_specular.png";
-        textures.push_back(specular);
-
-        return textures;
+    static std::shared_ptr<Material> GetDefaultMaterial() {
+        MaterialDesc desc;
+        desc.diffusePath = "resources/images/container2.png";
+        desc.specularPath = "resources/images/container2_specular.png";
+        return ResourceManager::GetMaterial(desc);
     }
 
+public:
+    // Rohdaten des Einheitswürfels; auch für Platzhalter anderer Objekte (Renderer, Modell-Import)
     static std::vector<Vertex> GetVertices() {
         static const float rawVertices[] = {
                 // Position         // Normal        // TexCoords
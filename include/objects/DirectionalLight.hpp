@@ -8,10 +8,9 @@ class DirectionalLight : public Light {
 public:
     DirectionalLight() : Light(Type::Directional) {}
 
-    void UploadToShader(Shader* shader, int index = -1) const override {
-        shader->SetVec3("dirLight.direction", direction);
-        shader->SetVec3("dirLight.ambient",  color * 0.1f);
-        shader->SetVec3("dirLight.diffuse",  color * 0.8f);
-        shader->SetVec3("dirLight.specular", color * 1.0f);
+    // Schreibt das Licht im std140-Layout des LightBlock
+    void Pack(GpuDirLight& out) const {
+        out.direction = glm::vec4(direction, 0.0f);
+        out.color = glm::vec4(color, 1.0f);
     }
 };
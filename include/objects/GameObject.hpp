@@ -2,34 +2,108 @@
 #include "glm/glm.hpp"
 #include "glm/gtc/quaternion.hpp"
 #include "glm/gtc/matrix_transform.hpp"
+#include "../core/EntityRegistry.hpp"
+#include "../core/Components.hpp"
+#include <cstdint>
 #include <ostream>
 #include <istream>
+#include <vector>
 
+// Typ-Tag für Dispatch per switch statt dynamic_cast
+enum class ObjectType : uint8_t {
+    Generic,
+    Shape,              // Shapes ohne eigenen Tag
+    Cube,
+    Plane,
+    Model,
+    PointLight,
+    DirectionalLight,
+    SpotLight
+};
+
+inline bool IsShapeType(ObjectType t) { return t == ObjectType::Shape || t == ObjectType::Cube || t == ObjectType::Plane; }
+inline bool IsLightType(ObjectType t) {
+    return t == ObjectType::PointLight || t == ObjectType::DirectionalLight || t == ObjectType::SpotLight;
+}
+
+// Fassade über eine Entity der EntityRegistry. Position/Rotation/Skalierung und die gecachten
+// Matrizen liegen in den Transform-Pools; Hierarchie und Dirty-Flags verwaltet das GameObject.
+// Setter markieren den Teilbaum dirty, Scene::UpdateTransforms() rechnet einmal pro Frame nach.
 class GameObject {
 public:
-    virtual ~GameObject() = default;
+    GameObject() : GameObject(ObjectType::Generic) {}
+    virtual ~GameObject();
 
-    glm::vec3 position = glm::vec3(0.0f);
-    glm::vec3 scale = glm::vec3(1.0f);
-    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    // Eltern/Kind-Zeiger und Entity lassen sich nicht sinnvoll kopieren
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+
+    Entity GetEntity() const { return entity; }
+    ObjectType GetType() const { return type; }
 
     // Position
-    void SetPosition(const glm::vec3& pos) { position = pos; }
-    void Move(const glm::vec3& offset) { position += offset; }
-    glm::vec3 GetPosition() const { return position; }
+    void SetPosition(const glm::vec3& pos) { Transform().position = pos; MarkDirty(); }
+    void Move(const glm::vec3& offset) { Transform().position += offset; MarkDirty(); }
+    glm::vec3 GetPosition() const { return Transform().position; }
 
     // Skalierung
-    void SetScale(const glm::vec3& s) { scale = s; }
-    void Scale(const glm::vec3& factor) { scale *= factor; }
-    glm::vec3 GetScale() const { return scale; }
+    void SetScale(const glm::vec3& s) { Transform().scale = s; MarkDirty(); }
+    void Scale(const glm::vec3& factor) { Transform().scale *= factor; MarkDirty(); }
+    glm::vec3 GetScale() const { return Transform().scale; }
 
     // Rotation
-    void SetRotation(const glm::quat& rot) { rotation = rot; }
+    void SetRotation(const glm::quat& rot) { Transform().rotation = rot; MarkDirty(); }
     void SetRotation(float angleDeg, const glm::vec3& axis) {
-        rotation = glm::angleAxis(glm::radians(angleDeg), glm::normalize(axis));
+        Transform().rotation = glm::angleAxis(glm::radians(angleDeg), glm::normalize(axis));
+        MarkDirty();
     }
     void Rotate(float angleDeg, const glm::vec3& axis) {
+        glm::quat& rotation = Transform().rotation;
         rotation = glm::normalize(glm::angleAxis(glm::radians(angleDeg), glm::normalize(axis)) * rotation);
+        MarkDirty();
     }
-    glm::quat GetRotation() const { return rotation; }
-};
\ No newline at end of file
+    glm::quat GetRotation() const { return Transform().rotation; }
+
+    // Hierarchie (nicht besitzend; die Scene hält die shared_ptr).
+    // Die lokale Transformation bleibt beim Umhängen erhalten.
+    void SetParent(GameObject* newParent);
+    GameObject* GetParent() const { return parent; }
+    const std::vector<GameObject*>& GetChildren() const { return children; }
+
+    // Gecachte Matrizen, gültig nach Scene::UpdateTransforms().
+    // Die Referenzen zeigen in den Pool und gelten nur bis zum nächsten Anlegen/Löschen eines Objekts.
+    const glm::mat4& GetLocalMatrix() const { return WorldTransform().local; }
+    const glm::mat4& GetWorldMatrix() const { return WorldTransform().world; }
+    glm::vec3 GetWorldPosition() const { return glm::vec3(WorldTransform().world[3]); }
+    // Wird bei jeder Neuberechnung der Welt-Matrix erhöht (Caches können so Änderungen erkennen)
+    uint32_t GetTransformVersion() const { return WorldTransform().version; }
+    bool IsTransformDirty() const { return localDirty || worldDirty; }
+
+    // Aktualisiert diesen Teilbaum; besucht nur Zweige, in denen etwas dirty ist.
+    // Liefert die Anzahl neu berechneter Welt-Matrizen.
+    size_t UpdateTransform();
+
+protected:
+    explicit GameObject(ObjectType type);
+
+private:
+    TransformComponent& Transform() const {
+        return EntityRegistry::Instance().Get<TransformComponent>(entity);
+    }
+    WorldTransformComponent& WorldTransform() const {
+        return EntityRegistry::Instance().Get<WorldTransformComponent>(entity);
+    }
+
+    void MarkDirty();
+    void MarkWorldDirty();
+    size_t UpdateTransform(const glm::mat4& parentWorld);
+
+    Entity entity = NullEntity;
+    ObjectType type = ObjectType::Generic;
+    GameObject* parent = nullptr;
+    std::vector<GameObject*> children;
+
+    bool localDirty = true;     // position/rotation/scale geändert
+    bool worldDirty = true;     // ein Vorfahre hat sich geändert
+    bool childDirty = false;    // irgendwo darunter ist ein Knoten dirty
+};
@@ -18,10 +18,10 @@ public:
     void Cleanup();
 
     // Grid-Parameter
-    void SetPlaneY(float y) { planeY = y; }
-    void SetMajorStep(float step) { majorStep = step; }
-    void SetThickness(float thickness) { thicknessPx = thickness; }
-    void SetFadeDistance(float start, float end) { fadeStart = start; fadeEnd = end; }
+    void SetPlaneY(float y) { planeY = y; paramsDirty = true; }
+    void SetMajorStep(float step) { majorStep = step; paramsDirty = true; }
+    void SetThickness(float thickness) { thicknessPx = thickness; paramsDirty = true; }
+    void SetFadeDistance(float start, float end) { fadeStart = start; fadeEnd = end; paramsDirty = true; }
 
 private:
     std::shared_ptr<Shader> gridShader;
@@ -34,6 +34,8 @@ private:
     float thicknessPx = 1.0f;
     float fadeStart = 50.0f;
     float fadeEnd = 200.0f;
+    // Uniforms bleiben im Programm erhalten, daher nur nach Änderung neu setzen
+    bool paramsDirty = true;
 
     void CreateFullscreenTriangle();
     void LoadShaders();
@@ -1,7 +1,11 @@
 // Light.hpp
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "glm/glm.hpp"
-#include "../core/Shader.hpp"
+#include "GameObject.hpp"
+#include "../core/UniformBlocks.hpp"
 
 class Light : public GameObject {
 public:
@@ -12,8 +16,28 @@ public:
     float constant = 1.0f, linear = 0.09f, quadratic = 0.032f;
     float cutOff = 0.0f, outerCutOff = 0.0f;
 
-    Light(Type t) : type(t) {}
+    Light(Type t) : GameObject(ToObjectType(t)), type(t) {}
     virtual ~Light() = default;
 
-    virtual void UploadToShader(Shader* shader, int index = -1) const = 0;
+    // Abstand, ab dem die Dämpfung die Lichtstärke unter ~2% drückt; Grundlage für das Cluster-Binning
+    float GetRange() const {
+        const float maxChannel = std::max(color.r, std::max(color.g, color.b));
+        const float cutoff = maxChannel * 256.0f / 5.0f;
+        if (quadratic > 0.0f) {
+            const float disc = linear * linear - 4.0f * quadratic * (constant - cutoff);
+            return disc > 0.0f ? (-linear + std::sqrt(disc)) / (2.0f * quadratic) : 0.0f;
+        }
+        if (linear > 0.0f) return std::max(0.0f, (cutoff - constant) / linear);
+        return std::numeric_limits<float>::max();
+    }
+
+private:
+    static ObjectType ToObjectType(Type t) {
+        switch (t) {
+            case Type::Directional: return ObjectType::DirectionalLight;
+            case Type::Point:       return ObjectType::PointLight;
+            case Type::Spot:        return ObjectType::SpotLight;
+        }
+        return ObjectType::Generic;
+    }
 };
\ No newline at end of file
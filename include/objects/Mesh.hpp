@@ -8,7 +8,11 @@
 #include "glm/glm.hpp"
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <memory>
 #include "../core/Shader.hpp"
+#include "../core/Material.hpp"
+#include "../core/GeometryArena.hpp"
 #include "../objects/GameObject.hpp"
 
 struct Vertex {
@@ -17,30 +21,100 @@ struct Vertex {
     glm::vec2 texCoords;
 };
 
-struct Texture {
-    unsigned int id;
-    std::string type;
-    std::string path;
+// Lokale Bounding-Volumes, einmalig beim Anlegen des Meshes berechnet
+struct Bounds {
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+};
+
+// Vereinfachte Stufe eines Meshes (MeshSimplifier), eigener Bereich in der GeometryArena
+struct MeshLod {
+    uint32_t geometry = GeometryArena::InvalidHandle;
+    uint32_t indexCount = 0;
+    float error = 0.0f;     // geometrische Abweichung zur vollen Auflösung (Modell-Einheiten)
 };
 
 class Mesh {
 public:
     std::vector<Vertex>       vertices;
     std::vector<unsigned int> indices;
-    std::vector<Texture>      textures;
-    std::vector<Texture> textures_loaded;
-    unsigned int VAO;
 
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
+    // material == nullptr -> Standardmaterial; compactVertices = CompactVertex-Layout in der GeometryArena
+    // (gilt auch für die LOD-Stufen)
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::shared_ptr<Material> material = nullptr,
+         bool compactVertices = false);
+    // Fertig kodierte Geometrie (gekochter Modell-Cache): Upload ohne Umkodieren, keine CPU-Kopie der Vertices.
+    // Bounds kommen mit; Occluder-Daten setzt der Aufrufer per SetExternalOccluder.
+    Mesh(const GeometryArena::EncodedGeometry& geometry, const Bounds& bounds, std::shared_ptr<Material> material = nullptr);
+    ~Mesh();
+    // Der Arena-Bereich gehört genau einem Mesh
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
+
+    // Einzelner Draw inkl. VAO-Bind; der Renderer bindet das VAO stattdessen einmal pro Frame
     void DrawInstanced(Shader& shader);
-    void SetModelMatrices(const std::vector<glm::mat4> &matrices);
+    // Instanzdaten liegen in einem externen Buffer (InstanceRingBuffer); byteOffset zeigt auf die erste InstanceData
+    void SetInstanceData(unsigned int buffer, size_t byteOffset, size_t count);
     Mesh* GetMesh() { return this; }
     const Mesh* GetMesh() const { return this; }
+
+    // Stabile IDs für die Sortier-Keys der RenderQueue
+    uint32_t GetMeshId() const { return meshId; }
+    MaterialId GetMaterialId() const { return materialId; }
+    const std::shared_ptr<Material>& GetMaterial() const { return material; }
+
+    const Bounds& GetBounds() const { return bounds; }
+    // Auch für gekochte Meshes, die ihre Bounds aus dem Modell-Cache bekommen
+    static Bounds ComputeBounds(const std::vector<Vertex>& vertices);
+    // Bereich in der GeometryArena (Offsets können sich beim Defragmentieren ändern -> pro Frame abfragen)
+    const GeometryArena::Range& GetGeometry() const { return GeometryArena::Instance().Get(geometry); }
+    // Meshes mit identischen Vertex-/Indexdaten teilen sich das Handle und damit einen Batch
+    uint32_t GetGeometryHandle() const { return geometry; }
+    // GPU-Speicher aller Stufen in der Arena bzw. im Standard-Layout mit 32-Bit-Indizes
+    size_t GetGpuBytes() const;
+    size_t GetUncompressedBytes() const;
+
+    // LOD-Kette: Stufe 0 ist das Mesh selbst, jede weitere hat etwa die halbe Dreieckszahl.
+    // Material und Bounds gelten für alle Stufen.
+    void AddLod(const std::vector<Vertex>& lodVertices, const std::vector<unsigned int>& lodIndices, float error);
+    void AddLod(const Vertex* lodVertices, size_t vertexCount, const unsigned int* lodIndices, size_t indexCount, float error);
+    // Bereits kodiert, direkt aus einer gemappten .arkmesh-Datei (MeshCache)
+    void AddLod(const GeometryArena::EncodedGeometry& lodGeometry, float error);
+    size_t GetLodCount() const { return 1 + lods.size(); }
+    uint32_t GetLodGeometry(size_t level) const { return level == 0 ? geometry : lods[level - 1].geometry; }
+    float GetLodError(size_t level) const { return level == 0 ? 0.0f : lods[level - 1].error; }
+    uint32_t GetLodIndexCount(size_t level) const {
+        return level == 0 ? GetGeometry().indexCount : lods[level - 1].indexCount;
+    }
+
+    // Volle Stufe als Occluder (OcclusionCuller::AddOccluder): Positionen mit Stride, 32-Bit-Indizes.
+    // positions == nullptr -> der Mesh hat keine CPU-Geometrie
+    struct Occluder {
+        const glm::vec3* positions = nullptr;
+        size_t stride = 0;
+        size_t vertexCount = 0;
+        const uint32_t* indices = nullptr;
+        size_t indexCount = 0;
+    };
+    Occluder GetOccluder() const;
+    // Occluder-Daten außerhalb des Meshes (z.B. in der Cache-Abbildung des ModelAssets); müssen den Mesh überleben
+    void SetExternalOccluder(const glm::vec3* positions, size_t vertexCount, const uint32_t* occluderIndices, size_t indexCount);
 private:
-    unsigned int VBO, EBO;
-    unsigned int instanceVBO = 0;
+    uint32_t meshId = 0;
+    std::shared_ptr<Material> material;
+    MaterialId materialId = 0;      // Kopie der ID, spart im Queue-Aufbau die Indirektion
+    Bounds bounds;
+    uint32_t geometry = GeometryArena::InvalidHandle;
+    bool compactVertices = false;
+    std::vector<MeshLod> lods;
+    Occluder externalOccluder;
+    unsigned int instanceBuffer = 0;
+    size_t instanceOffset = 0;
     size_t instanceCount = 0;
-    void SetupMesh();
 };
 
 #endif //INC_3DRENDERER_MESH_HPP
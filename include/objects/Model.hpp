@@ -5,37 +5,37 @@
 
 #include <vector>
 #include <string>
-#include <fstream>
+#include <memory>
 #include "Mesh.hpp"
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-#include <iostream>
+#include "ModelAsset.hpp"
 #include "../core/ResourceManager.hpp"
+#include "../core/InstanceRingBuffer.hpp"
 
+// Szenenobjekt eines importierten Modells: nur Transform und Verweis auf das geteilte ModelAsset.
+// Beliebig viele Instanzen desselben Pfads kosten einen Import und teilen sich die Meshes.
 class Model : public GameObject
 {
 public:
-    Model(const std::string& path)
-    {
-        loadModel(path);
-    }
-    void Draw(Shader &shader);
+    explicit Model(std::shared_ptr<ModelAsset> asset) : GameObject(ObjectType::Model), asset(std::move(asset)) {}
+    // Asset über den Cache des ResourceManagers (Import nur beim ersten Mal pro Pfad)
+    explicit Model(const std::string& path) : Model(ResourceManager::GetModelAsset(path)) {}
+
+    void Draw(Shader &shader, InstanceRingBuffer& instances);
+    // Solange das Asset im Import ist, hat die Instanz keine Meshes (Renderer zeigt einen Platzhalter)
+    ModelAsset::State GetState() const { return asset->GetState(); }
+    bool IsReady() const { return asset->IsReady(); }
     std::vector<Mesh*> GetMeshes() {
         std::vector<Mesh*> result;
-        for (auto& mesh : meshes) {
-            result.push_back(&mesh);
+        for (size_t i = 0; i < asset->GetMeshCount(); ++i) {
+            result.push_back(asset->GetMeshAt(i));
         }
         return result;
     }
+    size_t GetMeshCount() const { return asset->GetMeshCount(); }
+    const Bounds& GetBounds() const { return asset->GetBounds(); }
+    Mesh* GetMeshAt(size_t index) { return asset->GetMeshAt(index); }
+    const std::string& GetPath() const { return asset->GetPath(); }
+    const std::shared_ptr<ModelAsset>& GetAsset() const { return asset; }
 private:
-    std::vector<Mesh> meshes;
-    std::string directory;
-    std::vector<Texture> textures_loaded;
-
-    void loadModel(std::string path);
-    void processNode(aiNode *node, const aiScene *scene);
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene);
-    std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type,
-                                         std::string typeName);
+    std::shared_ptr<ModelAsset> asset;
 };
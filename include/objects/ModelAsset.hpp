@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include "Mesh.hpp"
+#include "../core/MeshSimplifier.hpp"
+#include "../core/MeshCache.hpp"
+#include "../core/ResourceManager.hpp"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+// Importierte Modelldaten (Meshes samt Materialien und Bounds), einmal pro Pfad über
+// ResourceManager::GetModelAsset. Nach dem Import unverändert und von allen Model-Instanzen geteilt:
+// gleiche Mesh-Zeiger -> die Instanzen landen im selben Batch, ein instanzierter Draw pro Teil-Mesh.
+//
+// Import in zwei Phasen:
+//   1. ImportCpu (Worker-Thread): Assimp, Konvertierung, Optimierung, LODs, Textur-Dekodierung. Kein GL.
+//      Passt eine gekochte .arkmesh-Datei zum Inhalt der Quelle und aller beim Import gelesenen Dateien,
+//      ersetzt sie Assimp und Aufbereitung.
+//   2. UploadStep (Context-Thread, pro Frame mit Zeitbudget): Texturen, Materialien, Meshes in die Arena.
+// Bis der Zustand Ready ist, sind Meshes und Bounds leer; nur der Context-Thread greift darauf zu.
+class ModelAsset
+{
+public:
+    enum class State : uint8_t { Loading, Ready, Failed, Cancelled };
+
+    // cacheDirectory: Ablage der gekochten .arkmesh-Dateien (MeshCache); leer = immer über Assimp
+    explicit ModelAsset(const std::string& path, std::string cacheDirectory = {});
+    ModelAsset(const ModelAsset&) = delete;
+    ModelAsset& operator=(const ModelAsset&) = delete;
+
+    void ImportCpu();
+    // true, sobald der Import abgeschlossen ist (Ready, Failed oder Cancelled)
+    bool UploadStep(double budgetMs);
+    // Wirkt beim nächsten Prüfpunkt: im Assimp-Parser, zwischen den Meshes oder vor dem Upload
+    void Cancel() { cancelRequested.store(true, std::memory_order_relaxed); }
+
+    State GetState() const { return state.load(std::memory_order_acquire); }
+    bool IsReady() const { return GetState() == State::Ready; }
+    // 0..1 über beide Phasen
+    float GetProgress() const { return progress.load(std::memory_order_relaxed); }
+
+    const std::string& GetPath() const { return path; }
+    size_t GetMeshCount() const { return meshes.size(); }
+    // Nicht-const, weil Draw-Aufrufe den Instanz-Buffer am Mesh setzen; die Geometrie selbst bleibt fest
+    Mesh* GetMeshAt(size_t index) { return &meshes[index]; }
+    const Bounds& GetBounds() const { return bounds; }
+private:
+    // Ergebnis von ImportCpu, wird von UploadStep abgearbeitet
+    struct ImportedMesh {
+        // Assimp-Pfad: volle Stufe und LODs als Vertex-Arrays, kodiert wird beim Upload
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<MeshSimplifier::LodLevel> lods;
+        // Cache-Pfad: fertig kodiert in der Abbildung (ImportData::cooked), sonst nullptr
+        const MeshCache::MeshView* cooked = nullptr;
+        MaterialDesc material;
+    };
+    struct ImportData {
+        std::vector<ImportedMesh> meshes;
+        std::vector<ResourceManager::DecodedTexture> textures;
+        Bounds bounds;
+        std::unique_ptr<MeshCache::CookedModel> cooked;
+        size_t uploaded = 0;
+    };
+
+    std::string path;
+    std::string cacheDirectory;
+    // Abbildung der .arkmesh-Datei nach einem Cache-Treffer: die Occluder-Daten der Meshes zeigen hinein
+    std::unique_ptr<MeshCache::CookedModel> cookedFile;
+    std::vector<Mesh> meshes;
+    std::string directory;
+    Bounds bounds; // Vereinigung aller Mesh-Bounds
+
+    std::unique_ptr<ImportData> pending;
+    std::atomic<bool> cpuDone{false};       // pending vollständig, Übergabe an den Context-Thread
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<State> state{State::Loading};
+    std::atomic<float> progress{0.0f};
+
+    std::unique_ptr<ImportData> loadModel();    // nullptr bei Fehler oder Abbruch
+    std::unique_ptr<ImportData> loadCooked(std::unique_ptr<MeshCache::CookedModel> cooked);
+    void Finish(State result);
+    void processNode(aiNode *node, const aiScene *scene, std::vector<aiMesh*>& out);
+    static void convertMesh(const aiMesh *mesh, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+    MaterialDesc materialDesc(const aiMesh *mesh, const aiScene *scene) const;
+    std::vector<std::string> collectTexturePaths(const aiScene *scene) const;
+    // Pfad der ersten Textur des Typs relativ zum Modell (leer, wenn keine)
+    std::string texturePath(const aiMaterial *mat, aiTextureType type) const;
+};
@@ -7,26 +7,19 @@
 
 class Plane : public Shapes {
 public:
-    Plane(const std::vector<Texture>& textures = {}) {
-        mesh = std::make_shared<Mesh>(GetVertices(),GetIndices(),textures.empty() ? GetDefaultTextures() : textures);
+    // Alle Ebenen mit gleichem Material teilen sich einen Mesh (ResourceManager::GetPrimitiveMesh)
+    explicit Plane(std::shared_ptr<Material> material = nullptr) : Shapes(ObjectType::Plane) {
+        mesh = ResourceManager::GetPrimitiveMesh(ResourceManager::Primitive::Plane,
+                                                 material ? material : GetDefaultMaterial(),
+                                                 &GetVertices, &GetIndices);
     }
 
 private:
-    static std::vector<Texture> GetDefaultTextures() {
-        std::vector<Texture> textures;
-        Texture diffuse;
-        diffuse.id = ResourceManager::GetTexture("resources/images/container2.png");
-        diffuse.type = "texture_diffuse";
-        diffuse.path = "resources/images/container2.png";
-        textures.push_back(diffuse);
-
-        Texture specular;
-        specular.id = ResourceManager::GetTexture("resources/images/container2_specular.png");
-        specular.type = "texture_specular";
-        specular.path = "resources/images/container2_specular.png";
-        textures.push_back(specular);
-
-        return textures;
+    static std::shared_ptr<Material> GetDefaultMaterial() {
+        MaterialDesc desc;
+        desc.diffusePath = "resources/images/container2.png";
+        desc.specularPath = "resources/images/container2_specular.png";
+        return ResourceManager::GetMaterial(desc);
     }
 
     static std::vector<Vertex> GetVertices() {
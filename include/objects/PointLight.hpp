@@ -3,20 +3,16 @@
 //
 #pragma once
 #include "Light.hpp"
-#include <string>
 
 class PointLight : public Light {
 public:
     PointLight() : Light(Type::Point) {}
 
-    void UploadToShader(Shader* shader, int index) const override {
-        std::string idx = "pointLights[" + std::to_string(index) + "]";
-        shader->SetVec3(idx + ".position", position);
-        shader->SetVec3(idx + ".ambient",  color * 0.1f);
-        shader->SetVec3(idx + ".diffuse",  color * 0.8f);
-        shader->SetVec3(idx + ".specular", color * 1.0f);
-        shader->SetFloat(idx + ".constant",  constant);
-        shader->SetFloat(idx + ".linear",    linear);
-        shader->SetFloat(idx + ".quadratic", quadratic);
+    // Schreibt das Licht im Texel-Layout des Cluster-Buffers
+    void Pack(GpuClusterLight& out) const {
+        out.positionRange = glm::vec4(GetWorldPosition(), GetRange());
+        out.colorType = glm::vec4(color, 0.0f);
+        out.attenuationCutOff = glm::vec4(constant, linear, quadratic, 0.0f);
+        out.directionOuterCutOff = glm::vec4(0.0f);
     }
 };
\ No newline at end of file
@@ -10,7 +10,7 @@ class Shapes : public GameObject {
 public:
     std::shared_ptr<Mesh> mesh;
 
-    Shapes() = default;
+    explicit Shapes(ObjectType type = ObjectType::Shape) : GameObject(type) {}
     virtual ~Shapes() = default;
 
     std::shared_ptr<Mesh> GetMesh() const { return mesh; }
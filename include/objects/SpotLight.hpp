@@ -21,17 +21,11 @@ public:
         outerCutOff = glm::cos(glm::radians(outerDeg));
     }
 
-    void UploadToShader(Shader* shader, int index) const override {
-        std::string base = "spotLights[" + std::to_string(index) + "]";
-        shader->SetVec3(base + ".position", position);
-        shader->SetVec3(base + ".direction", direction);
-        shader->SetFloat(base + ".cutOff", cutOff);
-        shader->SetFloat(base + ".outerCutOff", outerCutOff);
-        shader->SetFloat(base + ".constant", constant);
-        shader->SetFloat(base + ".linear", linear);
-        shader->SetFloat(base + ".quadratic", quadratic);
-        shader->SetVec3(base + ".ambient",  color * 0.1f);
-        shader->SetVec3(base + ".diffuse",  color * 0.8f);
-        shader->SetVec3(base + ".specular", color * 1.0f);
+    // Schreibt das Licht im Texel-Layout des Cluster-Buffers
+    void Pack(GpuClusterLight& out) const {
+        out.positionRange = glm::vec4(GetWorldPosition(), GetRange());
+        out.colorType = glm::vec4(color, 1.0f);
+        out.attenuationCutOff = glm::vec4(constant, linear, quadratic, cutOff);
+        out.directionOuterCutOff = glm::vec4(direction, outerCutOff);
     }
 };
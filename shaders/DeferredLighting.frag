@@ -0,0 +1,118 @@
+#version 330 core
+// Beleuchtungs-Pass des Deferred-Pfads: liest den G-Buffer und wertet pro Pixel nur die Lichter
+// seines Clusters aus. Beleuchtungsmodell entspricht StandardLit.frag.
+out vec4 FragColor;
+
+in vec2 TexCoord;
+
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection;
+    vec4 cameraPosition;
+    vec4 clipPlanes;
+};
+
+struct DirLight {
+    vec4 direction;
+    vec4 color;
+};
+
+layout (std140) uniform LightBlock {
+    DirLight dirLight;
+    ivec4 lightCounts;
+};
+
+uniform sampler2D gAlbedoSpec;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+uniform samplerBuffer clusterLightData;
+uniform usamplerBuffer clusterRanges;
+uniform usamplerBuffer clusterLightIndices;
+
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 diffuseColor, vec3 specularColor, float shininess)
+{
+    vec3 lightDir = normalize(-light.direction.xyz);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 ambient  = light.color.rgb * 0.1 * diffuseColor;
+    vec3 diffuse  = light.color.rgb * 0.8 * diff * diffuseColor;
+    vec3 specular = light.color.rgb * spec * specularColor;
+    return (ambient + diffuse + specular);
+}
+
+vec3 CalcClusterLight(int lightIndex, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 diffuseColor, vec3 specularColor,
+                      float shininess)
+{
+    vec4 positionRange        = texelFetch(clusterLightData, lightIndex * 4 + 0);
+    vec4 colorType            = texelFetch(clusterLightData, lightIndex * 4 + 1);
+    vec4 attenuationCutOff    = texelFetch(clusterLightData, lightIndex * 4 + 2);
+    vec4 directionOuterCutOff = texelFetch(clusterLightData, lightIndex * 4 + 3);
+
+    vec3 toLight = positionRange.xyz - fragPos;
+    float distance = length(toLight);
+    if (distance > positionRange.w) return vec3(0.0);
+    vec3 lightDir = toLight / max(distance, 0.0001);
+
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float attenuation = 1.0 / (attenuationCutOff.x + attenuationCutOff.y * distance +
+    attenuationCutOff.z * (distance * distance));
+
+    float intensity = 1.0;
+    if (colorType.a > 0.5) {
+        float theta = dot(lightDir, normalize(-directionOuterCutOff.xyz));
+        float epsilon = max(attenuationCutOff.w - directionOuterCutOff.w, 0.0001);
+        intensity = clamp((theta - directionOuterCutOff.w) / epsilon, 0.0, 1.0);
+    }
+
+    vec3 ambient  = colorType.rgb * 0.1 * diffuseColor;
+    vec3 diffuse  = colorType.rgb * 0.8 * diff * diffuseColor * intensity;
+    vec3 specular = colorType.rgb * spec * specularColor * intensity;
+    return (ambient + diffuse + specular) * attenuation;
+}
+
+uint ClusterIndex(vec3 fragPos)
+{
+    vec2 tile = clamp(gl_FragCoord.xy / clipPlanes.zw, 0.0, 0.9999) * vec2(CLUSTER_X, CLUSTER_Y);
+    float depth = max(-(view * vec4(fragPos, 1.0)).z, clipPlanes.x);
+    int slice = int(log(depth / clipPlanes.x) / log(clipPlanes.y / clipPlanes.x) * float(CLUSTER_Z));
+    slice = clamp(slice, 0, CLUSTER_Z - 1);
+    return uint((slice * CLUSTER_Y + int(tile.y)) * CLUSTER_X + int(tile.x));
+}
+
+void main()
+{
+    float depth = texture(gDepth, TexCoord).r;
+    // Kein Objekt -> Hintergrund (Grid) stehen lassen
+    if (depth >= 1.0) discard;
+
+    // Welt-Position aus der Tiefe rekonstruieren
+    vec4 clip = vec4(TexCoord * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 world = invViewProjection * clip;
+    vec3 fragPos = world.xyz / world.w;
+
+    vec4 albedoSpec = texture(gAlbedoSpec, TexCoord);
+    vec4 normalShininess = texture(gNormal, TexCoord);
+    vec3 norm = normalize(normalShininess.xyz);
+    float shininess = normalShininess.w;
+    vec3 viewDir = normalize(cameraPosition.xyz - fragPos);
+    vec3 diffuseColor = albedoSpec.rgb;
+    vec3 specularColor = vec3(albedoSpec.a);
+
+    vec3 result = CalcDirLight(dirLight, norm, viewDir, diffuseColor, specularColor, shininess);
+    uvec2 range = texelFetch(clusterRanges, int(ClusterIndex(fragPos))).xy;
+    for (uint i = 0u; i < range.y; ++i) {
+        int lightIndex = int(texelFetch(clusterLightIndices, int(range.x + i)).x);
+        result += CalcClusterLight(lightIndex, norm, fragPos, viewDir, diffuseColor, specularColor, shininess);
+    }
+
+    FragColor = vec4(result, 1.0);
+}
@@ -0,0 +1,6 @@
+#version 330 core
+// Nur Tiefe; Farbschreiben ist während des Pre-Pass per glColorMask aus
+
+void main()
+{
+}
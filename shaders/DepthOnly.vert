@@ -0,0 +1,28 @@
+#version 330 core
+// Depth-Pre-Pass: nur der Positions-Stream der GeometryArena und Position/Rotation/Skalierung der Instanz
+layout (location = 0) in vec3 aPos;
+layout (location = 3) in vec3 instancePosition;
+layout (location = 4) in vec4 instanceRotation;
+layout (location = 5) in vec3 instanceScale;
+
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection;
+    vec4 cameraPosition;
+    vec4 clipPlanes;
+};
+
+// Gleiche Rechnung wie in StandardLit.vert; invariant garantiert bitgleiche Tiefe für GL_EQUAL
+invariant gl_Position;
+
+vec3 QuatRotate(vec4 q, vec3 v) {
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main() {
+    vec4 rotation = normalize(instanceRotation);
+    vec3 worldPos = instancePosition + QuatRotate(rotation, instanceScale * aPos);
+    gl_Position = viewProjection * vec4(worldPos, 1.0);
+}
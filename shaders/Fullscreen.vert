@@ -0,0 +1,9 @@
+#version 330 core
+// Vollbild-Dreieck ohne Vertex-Buffer: IDs 0,1,2 -> (0,0), (2,0), (0,2)
+out vec2 TexCoord;
+
+void main() {
+    vec2 uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    TexCoord = uv;
+    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,49 @@
+#version 330 core
+// G-Buffer-Pass des Deferred-Pfads (Vertex-Shader: StandardLit.vert)
+layout (location = 0) out vec4 gAlbedoSpec;
+layout (location = 1) out vec4 gNormal;
+
+in vec3 myColor;
+in vec2 TexCoord;
+in vec3 Normal;
+in vec3 FragPos;
+flat in uint MaterialIndex;
+
+// Materialien wie in StandardLit.frag (ResourceManager): Texturen liegen in Texture-Arrays pro Größenklasse,
+// der Material-Buffer liefert pro Index Array/Layer von Diffuse und Specular sowie die Shininess
+uniform sampler2DArray textureArray0;
+uniform sampler2DArray textureArray1;
+uniform sampler2DArray textureArray2;
+uniform sampler2DArray textureArray3;
+uniform sampler2DArray textureArray4;
+uniform sampler2DArray textureArray5;
+uniform samplerBuffer materialData;     // 2 Texel pro Material (GpuMaterial)
+
+// Gradienten kommen von außen: der Array-Index ist pro Instanz verschieden, implizite
+// Ableitungen innerhalb der Verzweigung wären undefiniert
+vec4 SampleMaterialTexture(float array, float layer, vec2 uv, vec2 dx, vec2 dy, vec4 fallback)
+{
+    vec3 coord = vec3(uv, layer);
+    switch (int(array)) {
+        case 0: return textureGrad(textureArray0, coord, dx, dy);
+        case 1: return textureGrad(textureArray1, coord, dx, dy);
+        case 2: return textureGrad(textureArray2, coord, dx, dy);
+        case 3: return textureGrad(textureArray3, coord, dx, dy);
+        case 4: return textureGrad(textureArray4, coord, dx, dy);
+        case 5: return textureGrad(textureArray5, coord, dx, dy);
+    }
+    return fallback;
+}
+
+void main()
+{
+    vec4 materialLayers = texelFetch(materialData, int(MaterialIndex) * 2 + 0);
+    float shininess = texelFetch(materialData, int(MaterialIndex) * 2 + 1).x;
+    vec2 dx = dFdx(TexCoord);
+    vec2 dy = dFdy(TexCoord);
+    vec3 diffuseColor = SampleMaterialTexture(materialLayers.x, materialLayers.y, TexCoord, dx, dy, vec4(1.0)).rgb;
+    // Specular-Maps sind graustufig -> ein Kanal reicht
+    float specular = SampleMaterialTexture(materialLayers.z, materialLayers.w, TexCoord, dx, dy, vec4(0.0)).r;
+    gAlbedoSpec = vec4(diffuseColor, specular);
+    gNormal = vec4(normalize(Normal), shininess);
+}
@@ -0,0 +1,50 @@
+#version 330 core
+// GPU-Culling (GpuCuller, Transform-Feedback-Pfad): ein Punkt pro Instanz; der Geometry-Shader
+// gibt nur sichtbare Instanzen weiter, Transform Feedback schreibt sie lückenlos hintereinander.
+layout (location = 0) in vec3 instancePosition;
+layout (location = 1) in uint instanceMaterial;
+layout (location = 2) in vec3 instanceScale;
+layout (location = 3) in vec4 instanceRotation;     // normalisierte Shorts, zum Testen
+layout (location = 4) in uvec2 instanceRotationBits; // dieselben Bytes roh, zum bitgenauen Weitergeben
+layout (location = 5) in vec3 boundsCenter;         // lokale AABB des Meshes
+layout (location = 6) in vec3 boundsExtents;
+
+uniform vec4 frustumPlanes[6];
+
+out VertexData {
+    vec3 position;
+    flat uint material;
+    vec3 scale;
+    flat uvec2 rotation;
+    flat int visible;
+} vs_out;
+
+mat3 QuatToMat3(vec4 q) {
+    vec3 q2 = q.xyz * 2.0;
+    float xx = q.x * q2.x, yy = q.y * q2.y, zz = q.z * q2.z;
+    float xy = q.x * q2.y, xz = q.x * q2.z, yz = q.y * q2.z;
+    float wx = q.w * q2.x, wy = q.w * q2.y, wz = q.w * q2.z;
+    return mat3(1.0 - yy - zz, xy + wz, xz - wy,
+                xy - wz, 1.0 - xx - zz, yz + wx,
+                xz + wy, yz - wx, 1.0 - xx - yy);
+}
+
+void main() {
+    // Arvo: Zentrum transformieren, Extents mit |R| * |S|
+    mat3 rotation = QuatToMat3(normalize(instanceRotation));
+    vec3 center = instancePosition + rotation * (instanceScale * boundsCenter);
+    vec3 extents = abs(rotation[0]) * abs(instanceScale.x * boundsExtents.x) +
+                   abs(rotation[1]) * abs(instanceScale.y * boundsExtents.y) +
+                   abs(rotation[2]) * abs(instanceScale.z * boundsExtents.z);
+    int visible = 1;
+    for (int i = 0; i < 6; ++i) {
+        vec4 plane = frustumPlanes[i];
+        if (dot(plane.xyz, center) + plane.w + dot(abs(plane.xyz), extents) < 0.0) visible = 0;
+    }
+    vs_out.position = instancePosition;
+    vs_out.material = instanceMaterial;
+    vs_out.scale = instanceScale;
+    vs_out.rotation = instanceRotationBits;
+    vs_out.visible = visible;
+    gl_Position = vec4(0.0);
+}
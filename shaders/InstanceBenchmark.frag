@@ -0,0 +1,14 @@
+#version 330 core
+// Nur für Benchmarks::InstanceTransforms: liest alle Ausgaben von StandardLit.vert bzw. InstanceMatrix.vert,
+// damit der Linker nichts davon wegoptimiert, ohne selbst nennenswert zu kosten
+in vec3 myColor;
+in vec2 TexCoord;
+in vec3 Normal;
+in vec3 FragPos;
+flat in uint MaterialIndex;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(normalize(Normal) + FragPos * 1e-3 + myColor, TexCoord.x + float(MaterialIndex));
+}
@@ -0,0 +1,34 @@
+#version 330 core
+// Nur für Benchmarks::InstanceTransforms: der frühere Instanz-Pfad als Vergleich
+// (volle Model-Matrix pro Instanz, Normalen-Matrix per inverse() pro Vertex)
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in mat4 instanceModel;
+layout (location = 7) in uint instanceMaterial;
+
+uniform vec3 uniColor;
+
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection;
+    vec4 cameraPosition;
+    vec4 clipPlanes;
+};
+
+out vec3 myColor;
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 FragPos;
+flat out uint MaterialIndex;
+
+void main() {
+    gl_Position = viewProjection * instanceModel * vec4(aPos, 1.0);
+    myColor = uniColor;
+    TexCoord = aTexCoord;
+    Normal = mat3(transpose(inverse(instanceModel))) * aNormal;
+    FragPos = vec3(instanceModel * vec4(aPos, 1.0));
+    MaterialIndex = instanceMaterial;
+}
@@ -5,118 +5,134 @@ in vec3 myColor;
 in vec2 TexCoord;
 in vec3 Normal;
 in vec3 FragPos;
-uniform vec3 viewPos;
-
-struct Material {
-    sampler2D texture_diffuse1;
-    sampler2D texture_diffuse2;
-    sampler2D texture_diffuse3;
-    sampler2D texture_specular1;
-    sampler2D texture_specular2;
-    float shininess;
+flat in uint MaterialIndex;
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection;
+    vec4 cameraPosition;
+    vec4 clipPlanes;
 };
 
-uniform Material material;
+// Materialien (ResourceManager): Texturen liegen in Texture-Arrays pro Größenklasse,
+// der Material-Buffer liefert pro Index Array/Layer von Diffuse und Specular sowie die Shininess
+uniform sampler2DArray textureArray0;
+uniform sampler2DArray textureArray1;
+uniform sampler2DArray textureArray2;
+uniform sampler2DArray textureArray3;
+uniform sampler2DArray textureArray4;
+uniform sampler2DArray textureArray5;
+uniform samplerBuffer materialData;     // 2 Texel pro Material (GpuMaterial)
 
+// Gradienten kommen von außen: der Array-Index ist pro Instanz verschieden, implizite
+// Ableitungen innerhalb der Verzweigung wären undefiniert
+vec4 SampleMaterialTexture(float array, float layer, vec2 uv, vec2 dx, vec2 dy, vec4 fallback)
+{
+    vec3 coord = vec3(uv, layer);
+    switch (int(array)) {
+        case 0: return textureGrad(textureArray0, coord, dx, dy);
+        case 1: return textureGrad(textureArray1, coord, dx, dy);
+        case 2: return textureGrad(textureArray2, coord, dx, dy);
+        case 3: return textureGrad(textureArray3, coord, dx, dy);
+        case 4: return textureGrad(textureArray4, coord, dx, dy);
+        case 5: return textureGrad(textureArray5, coord, dx, dy);
+    }
+    return fallback;
+}
+
+// Layout entspricht GpuDirLight in UniformBlocks.hpp
 struct DirLight {
-    vec3 direction;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-uniform DirLight dirLight;
-
-struct PointLight {
-    vec3 position;
-    float constant;
-    float linear;
-    float quadratic;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
+    vec4 direction;
+    vec4 color;
 };
 
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-    float constant;
-    float linear;
-    float quadratic;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
+layout (std140) uniform LightBlock {
+    DirLight dirLight;
+    ivec4 lightCounts; // x = Lichter im Cluster-Buffer, y = davon sichtbar
 };
 
-#define NR_POINT_LIGHTS 32
-#define NR_SPOT_LIGHTS 16
-uniform int numPointLights;
-uniform int numSpotLights;
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-uniform SpotLight spotLights[NR_SPOT_LIGHTS];
+// Clustered Shading (LightClusterer): Raster und Texel-Layout müssen zur C++-Seite passen
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+uniform samplerBuffer clusterLightData;     // 4 Texel pro Licht (GpuClusterLight)
+uniform usamplerBuffer clusterRanges;       // pro Cluster: offset, count
+uniform usamplerBuffer clusterLightIndices;
 
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 diffuseColor, vec3 specularColor, float shininess)
 {
-    vec3 lightDir = normalize(-light.direction);
+    vec3 lightDir = normalize(-light.direction.xyz);
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    vec3 ambient  = light.ambient  * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 specular = light.specular * spec * vec3(texture(material.texture_specular1, TexCoord));
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 ambient  = light.color.rgb * 0.1 * diffuseColor;
+    vec3 diffuse  = light.color.rgb * 0.8 * diff * diffuseColor;
+    vec3 specular = light.color.rgb * spec * specularColor;
     return (ambient + diffuse + specular);
 }
 
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
+// Punkt- und Spotlicht aus dem Cluster-Buffer; Spots (colorType.a = 1) zusätzlich mit Kegel
+vec3 CalcClusterLight(int lightIndex, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 diffuseColor, vec3 specularColor,
+                      float shininess)
 {
-    vec3 lightDir = normalize(light.position - fragPos);
+    vec4 positionRange        = texelFetch(clusterLightData, lightIndex * 4 + 0);
+    vec4 colorType            = texelFetch(clusterLightData, lightIndex * 4 + 1);
+    vec4 attenuationCutOff    = texelFetch(clusterLightData, lightIndex * 4 + 2);
+    vec4 directionOuterCutOff = texelFetch(clusterLightData, lightIndex * 4 + 3);
+
+    vec3 toLight = positionRange.xyz - fragPos;
+    float distance = length(toLight);
+    if (distance > positionRange.w) return vec3(0.0);
+    vec3 lightDir = toLight / max(distance, 0.0001);
+
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    float distance    = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance +
-    light.quadratic * (distance * distance));
-    vec3 ambient  = light.ambient  * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 specular = light.specular * spec * vec3(texture(material.texture_specular1, TexCoord));
-    ambient  *= attenuation;
-    diffuse  *= attenuation;
-    specular *= attenuation;
-    return (ambient + diffuse + specular);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float attenuation = 1.0 / (attenuationCutOff.x + attenuationCutOff.y * distance +
+    attenuationCutOff.z * (distance * distance));
+
+    float intensity = 1.0;
+    if (colorType.a > 0.5) {
+        float theta = dot(lightDir, normalize(-directionOuterCutOff.xyz));
+        float epsilon = max(attenuationCutOff.w - directionOuterCutOff.w, 0.0001);
+        intensity = clamp((theta - directionOuterCutOff.w) / epsilon, 0.0, 1.0);
+    }
+
+    vec3 ambient  = colorType.rgb * 0.1 * diffuseColor;
+    vec3 diffuse  = colorType.rgb * 0.8 * diff * diffuseColor * intensity;
+    vec3 specular = colorType.rgb * spec * specularColor * intensity;
+    return (ambient + diffuse + specular) * attenuation;
 }
 
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
-    float theta = dot(lightDir, normalize(-light.direction));
-    float epsilon = max(light.cutOff - light.outerCutOff, 0.0001);
-    float intensity = clamp((theta - light.outerCutOff)/epsilon, 0.0, 1.0);
-    float diff = max(dot(normal, lightDir), 0.0);
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
-    vec3 ambient  = light.ambient  * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 diffuse  = light.diffuse  * diff * vec3(texture(material.texture_diffuse1, TexCoord));
-    vec3 specular = light.specular * spec * vec3(texture(material.texture_specular1, TexCoord));
-    diffuse  *= intensity;
-    specular *= intensity;
-    ambient  *= attenuation;
-    diffuse  *= attenuation;
-    specular *= attenuation;
-    return ambient + diffuse + specular;
+uint ClusterIndex(vec3 fragPos)
+{
+    vec2 tile = clamp(gl_FragCoord.xy / clipPlanes.zw, 0.0, 0.9999) * vec2(CLUSTER_X, CLUSTER_Y);
+    // Exponentielle Tiefenscheiben: slice = log(d / near) / log(far / near) * CLUSTER_Z
+    float depth = max(-(view * vec4(fragPos, 1.0)).z, clipPlanes.x);
+    int slice = int(log(depth / clipPlanes.x) / log(clipPlanes.y / clipPlanes.x) * float(CLUSTER_Z));
+    slice = clamp(slice, 0, CLUSTER_Z - 1);
+    return uint((slice * CLUSTER_Y + int(tile.y)) * CLUSTER_X + int(tile.x));
 }
 
 void main()
 {
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+
+    vec4 materialLayers = texelFetch(materialData, int(MaterialIndex) * 2 + 0);
+    float shininess = texelFetch(materialData, int(MaterialIndex) * 2 + 1).x;
+    vec2 dx = dFdx(TexCoord);
+    vec2 dy = dFdy(TexCoord);
+    vec3 diffuseColor = SampleMaterialTexture(materialLayers.x, materialLayers.y, TexCoord, dx, dy, vec4(1.0)).rgb;
+    vec3 specularColor = SampleMaterialTexture(materialLayers.z, materialLayers.w, TexCoord, dx, dy, vec4(0.0)).rgb;
 
-    vec3 result = CalcDirLight(dirLight, norm, viewDir);
-    for(int i = 0; i < numPointLights; ++i)
-        result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);
-    for(int i = 0; i < numSpotLights; ++i)
-        result += CalcSpotLight(spotLights[i], norm, FragPos, viewDir);
+    vec3 result = CalcDirLight(dirLight, norm, viewDir, diffuseColor, specularColor, shininess);
+    uvec2 range = texelFetch(clusterRanges, int(ClusterIndex(FragPos))).xy;
+    for (uint i = 0u; i < range.y; ++i) {
+        int lightIndex = int(texelFetch(clusterLightIndices, int(range.x + i)).x);
+        result += CalcClusterLight(lightIndex, norm, FragPos, viewDir, diffuseColor, specularColor, shininess);
+    }
 
     FragColor = vec4(result, 1.0);
 }
\ No newline at end of file
@@ -2,22 +2,54 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in mat4 instanceModel;
-layout (location = 4) in vec3 lightColor;
+// InstanceData: Position, Rotation (Quaternion, normalisierte Shorts), Skalierung, Material
+layout (location = 3) in vec3 instancePosition;
+layout (location = 4) in vec4 instanceRotation;
+layout (location = 5) in vec3 instanceScale;
+layout (location = 7) in uint instanceMaterial;
 
 uniform vec3 uniColor;
-uniform mat4 view;
-uniform mat4 projection;
+// 1: CompactVertex-Layout, aNormal.xy ist oktaedrisch kodiert (Position kommt normalisiert, die
+// Dequantisierung steckt in den Instanzdaten)
+uniform int compactVertex;
+
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection;
+    vec4 cameraPosition;
+    vec4 clipPlanes;
+};
 
 out vec3 myColor;
 out vec2 TexCoord;
 out vec3 Normal;
 out vec3 FragPos;
+flat out uint MaterialIndex;
+
+// Muss zu DepthOnly.vert passen (Depth-Pre-Pass mit GL_EQUAL)
+invariant gl_Position;
+
+vec3 OctDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+vec3 QuatRotate(vec4 q, vec3 v) {
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
 
 void main() {
-    gl_Position = projection * view * instanceModel * vec4(aPos, 1.0);
+    vec4 rotation = normalize(instanceRotation);
+    vec3 worldPos = instancePosition + QuatRotate(rotation, instanceScale * aPos);
+    gl_Position = viewProjection * vec4(worldPos, 1.0);
     myColor = uniColor;
     TexCoord = aTexCoord;
-    Normal = mat3(transpose(inverse(instanceModel))) * aNormal;
-    FragPos = vec3(instanceModel * vec4(aPos, 1.0));
-}
\ No newline at end of file
+    // Normalen-Matrix von R * S ist R * S^-1; normalisiert wird im Fragment-Shader
+    vec3 normal = compactVertex != 0 ? OctDecode(aNormal.xy) : aNormal;
+    Normal = QuatRotate(rotation, normal / instanceScale);
+    FragPos = worldPos;
+    MaterialIndex = instanceMaterial;
+}
@@ -3,8 +3,14 @@ out vec4 FragColor;
 
 in vec2 vScreenUV;
 
-uniform mat4 uInvViewProj;  // inverse(P * V)
-uniform vec3 uCameraPos;    // Kameraposition in Weltkoords
+layout (std140) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 invViewProjection; // inverse(P * V)
+    vec4 cameraPosition;    // Kameraposition in Weltkoords
+    vec4 clipPlanes;
+};
 uniform float uPlaneY = 0.0; // Ebene: y = uPlaneY (Standard: 0)
 
 uniform vec3 uGridColorMinor = vec3(0.55);     // Grau für kleine Linien
@@ -25,7 +31,7 @@ uniform vec3 uAxisOrigin = vec3(1.0);
 //
 vec3 ndcToWorld(vec2 uv, float ndcZ) {
     vec4 ndc = vec4(uv * 2.0 - 1.0, ndcZ, 1.0);
-    vec4 w = uInvViewProj * ndc;
+    vec4 w = invViewProjection * ndc;
     return w.xyz / w.w;
 }
 
@@ -53,7 +59,7 @@ void main() {
     // Ray aus Kamera durch Pixel (verwende nahe & ferne Punkte in Welt, um Richtung zu bilden)
     vec3 worldNear = ndcToWorld(vScreenUV, -1.0);
     vec3 worldFar  = ndcToWorld(vScreenUV,  1.0);
-    vec3 ro = uCameraPos;
+    vec3 ro = cameraPosition.xyz;
     vec3 rd = normalize(worldFar - worldNear);
 
     // Schnitt mit y-Ebene
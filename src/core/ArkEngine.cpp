@@ -3,6 +3,7 @@
 //
 #include "../../include/core/ArkEngine.hpp"
 #include "../../include/core/InputSystem.hpp"
+#include "../../include/core/JobSystem.hpp"
 
 ArkEngine::ArkEngine() {}
 
@@ -10,6 +11,9 @@ ArkEngine::~ArkEngine() {}
 
 void ArkEngine::Run() {
 
+    // Worker-Anzahl: Standard = Kerne - 1, überschreibbar per ARK_WORKER_THREADS
+    JobSystem::Instance().Initialize();
+
     ProjectManager& pm = ProjectManager::Instance();
     pm.CreateProject("TestProject");
 
@@ -28,4 +32,8 @@ void ArkEngine::Run() {
     Renderer renderer(window, scene, shader, camera, ui, &inputSystem);
     renderer.InitializeGrid();
     renderer.Render();
+
+    // Laufende Modell-Importe halten Worker belegt
+    ResourceManager::CancelModelImports();
+    JobSystem::Instance().Shutdown();
 }
\ No newline at end of file
@@ -0,0 +1,751 @@
+#include "glad/glad.h"
+#include "../../include/core/Benchmarks.hpp"
+#include "../../include/core/FrustumCuller.hpp"
+#include "../../include/core/JobSystem.hpp"
+#include "../../include/core/EntityRegistry.hpp"
+#include "../../include/core/Components.hpp"
+#include "../../include/core/Scene.hpp"
+#include "../../include/core/LightClusterer.hpp"
+#include "../../include/core/OcclusionCuller.hpp"
+#include "../../include/core/GpuCuller.hpp"
+#include "../../include/core/MeshOptimizer.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include "../../include/core/ResourceManager.hpp"
+#include "../../include/core/Shader.hpp"
+#include "../../include/objects/Cube.hpp"
+#include "../../include/objects/ModelAsset.hpp"
+#include "../../include/objects/Plane.hpp"
+#include "../../include/objects/PointLight.hpp"
+#include "../../include/objects/SpotLight.hpp"
+#include "../../include/objects/DirectionalLight.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <random>
+
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+
+    template<typename Fn>
+    double MedianMs(int runs, Fn&& fn) {
+        std::vector<double> times;
+        times.reserve(runs);
+        for (int i = 0; i < runs; ++i) {
+            auto start = Clock::now();
+            fn();
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    std::string Format(const char* fmt, double a, double b = 0.0) {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), fmt, a, b);
+        return buf;
+    }
+}
+
+BenchmarkResult Benchmarks::FrustumCulling(size_t boxCount, int runs) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> ext(0.1f, 2.0f);
+
+    FrustumCuller culler;
+    culler.Reserve(boxCount);
+    for (size_t i = 0; i < boxCount; ++i) {
+        culler.AddWorld(glm::vec3(pos(rng), pos(rng), pos(rng)), glm::vec3(ext(rng), ext(rng), ext(rng)));
+    }
+
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::FromMatrix(proj * view);
+
+    std::vector<uint8_t> visible;
+    size_t numVisible = 0;
+    double ms = MedianMs(runs, [&] { numVisible = culler.Cull(frustum, visible); });
+
+    BenchmarkResult r;
+    r.name = "Frustum Culling (" + std::to_string(boxCount) + " boxes)";
+    r.ms = ms;
+    r.detail = Format("%.1f Mboxes/s, %.0f visible", boxCount / (ms * 1000.0), (double)numVisible);
+    return r;
+}
+
+std::vector<BenchmarkResult> Benchmarks::JobSystemScaling(size_t itemCount, int runs) {
+    // Gleiche Arbeit wie Renderer::BuildRenderQueue: Model-Matrix bauen und AABB transformieren
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+    std::vector<glm::vec3> positions(itemCount);
+    for (auto& p : positions) p = glm::vec3(pos(rng), pos(rng), pos(rng));
+
+    FrustumCuller culler;
+    culler.Resize(itemCount);
+    const glm::vec3 localMin(-0.5f), localMax(0.5f);
+
+    JobSystem& jobs = JobSystem::Instance();
+    const unsigned maxThreads = jobs.IsInitialized() ? jobs.ThreadCount() : 1;
+
+    std::vector<BenchmarkResult> results;
+    double singleMs = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+        double ms = MedianMs(runs, [&] {
+            jobs.ParallelFor(0, itemCount, 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i]);
+                    model = glm::rotate(model, positions[i].x * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+                    culler.Set(i, localMin, localMax, model);
+                }
+            }, threads);
+        });
+        if (threads == 1) singleMs = ms;
+
+        BenchmarkResult r;
+        r.name = "JobSystem ParallelFor (" + std::to_string(itemCount) + " items, "
+                 + std::to_string(threads) + (threads == 1 ? " thread)" : " threads)");
+        r.ms = ms;
+        r.detail = Format("speedup %.2fx, efficiency %.0f%%", singleMs / ms, 100.0 * singleMs / (ms * threads));
+        results.push_back(r);
+    }
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::EntityIteration(size_t entityCount, int runs) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+
+    // Eigene Registry, damit die Engine-Entities unberührt bleiben
+    EntityRegistry registry;
+    registry.Pool<TransformComponent>().Reserve(entityCount);
+    registry.Pool<WorldTransformComponent>().Reserve(entityCount);
+    for (size_t i = 0; i < entityCount; ++i) {
+        Entity e = registry.Create();
+        registry.Add<TransformComponent>(e, { glm::vec3(pos(rng), pos(rng), pos(rng)) });
+        registry.Add<WorldTransformComponent>(e);
+    }
+
+    // Vergleich: einzeln allokiert und gemischt, wie vector<shared_ptr<GameObject>>
+    std::vector<std::shared_ptr<TransformComponent>> scattered;
+    scattered.reserve(entityCount);
+    for (size_t i = 0; i < entityCount; ++i) {
+        scattered.push_back(std::make_shared<TransformComponent>(TransformComponent{ glm::vec3(pos(rng), pos(rng), pos(rng)) }));
+    }
+    std::shuffle(scattered.begin(), scattered.end(), rng);
+
+    std::vector<BenchmarkResult> results;
+    const std::string count = std::to_string(entityCount);
+    auto addResult = [&](const std::string& name, double ms, double bytes, double checksum) {
+        BenchmarkResult r;
+        r.name = name + " (" + count + " entities)";
+        r.ms = ms;
+        r.detail = Format("%.2f GB/s, checksum %.0f", bytes / (ms * 1.0e6), checksum);
+        results.push_back(r);
+    };
+
+    // Nur lesen: reine Speicherbandbreite über das dichte Transform-Array
+    glm::vec3 sum(0.0f);
+    double ms = MedianMs(runs, [&] {
+        sum = glm::vec3(0.0f);
+        registry.View<TransformComponent>().Each([&](Entity, TransformComponent& t) { sum += t.position; });
+    });
+    addResult("ECS View<Transform> read", ms, double(entityCount) * sizeof(TransformComponent), sum.x);
+
+    ms = MedianMs(runs, [&] {
+        sum = glm::vec3(0.0f);
+        for (const auto& t : scattered) sum += t->position;
+    });
+    addResult("shared_ptr scan read", ms, double(entityCount) * sizeof(TransformComponent), sum.x);
+
+    // Transform-System: Welt-Matrix aus TRS schreiben (zwei Pools in gleicher Reihenfolge)
+    ms = MedianMs(runs, [&] {
+        registry.View<TransformComponent, WorldTransformComponent>().Each(
+            [](Entity, TransformComponent& t, WorldTransformComponent& w) {
+                w.local = glm::translate(glm::mat4(1.0f), t.position) * glm::mat4_cast(t.rotation);
+                w.local = glm::scale(w.local, t.scale);
+                w.world = w.local;
+                ++w.version;
+            });
+    });
+    addResult("ECS View<Transform, World> update", ms,
+              double(entityCount) * (sizeof(TransformComponent) + sizeof(WorldTransformComponent)),
+              registry.Pool<WorldTransformComponent>().Data()[0].world[3].x);
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::SceneDispatch(size_t objectCount, int runs) {
+    // Ein echter Mesh, den alle Shapes teilen; die Objekte selbst sind reine CPU-Daten
+    auto cube = std::make_shared<Cube>();
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> kind(0, 99);
+
+    Scene scene;
+    auto addStart = Clock::now();
+    for (size_t i = 0; i < objectCount; ++i) {
+        const int k = kind(rng);
+        std::shared_ptr<GameObject> obj;
+        if (k < 70) {
+            auto shape = std::make_shared<Shapes>();
+            shape->mesh = cube->mesh;
+            obj = shape;
+        } else if (k < 85) obj = std::make_shared<PointLight>();
+        else if (k < 95) obj = std::make_shared<SpotLight>();
+        else if (k < 96) obj = std::make_shared<DirectionalLight>();
+        else obj = std::make_shared<GameObject>();
+        scene.AddObject(obj);
+    }
+    const double addMs = std::chrono::duration<double, std::milli>(Clock::now() - addStart).count();
+
+    std::vector<Mesh*> meshes;
+    std::vector<Light*> pointLights, spotLights;
+    Light* dirLight = nullptr;
+    meshes.reserve(objectCount);
+
+    // Bisheriger Weg: jedes Objekt per dynamic_cast einordnen (SetLighting + BuildRenderQueue)
+    double oldMs = MedianMs(runs, [&] {
+        meshes.clear(); pointLights.clear(); spotLights.clear(); dirLight = nullptr;
+        for (const auto& obj : scene.GetObjects()) {
+            if (auto* light = dynamic_cast<Light*>(obj.get())) {
+                switch (light->type) {
+                    case Light::Type::Point: pointLights.push_back(light); break;
+                    case Light::Type::Spot: spotLights.push_back(light); break;
+                    case Light::Type::Directional: if (!dirLight) dirLight = light; break;
+                }
+            }
+            if (auto* shape = dynamic_cast<Shapes*>(obj.get())) {
+                if (shape->mesh) meshes.push_back(shape->mesh.get());
+            } else if (auto* model = dynamic_cast<Model*>(obj.get())) {
+                for (size_t m = 0; m < model->GetMeshCount(); ++m) meshes.push_back(model->GetMeshAt(m));
+            }
+        }
+    });
+    const size_t oldCount = meshes.size() + pointLights.size() + spotLights.size();
+
+    // Neuer Weg: Lichter aus dem LightComponent-Pool (wie SetLighting), Meshes aus den Kategorielisten der Scene
+    double newMs = MedianMs(runs, [&] {
+        meshes.clear(); pointLights.clear(); spotLights.clear(); dirLight = nullptr;
+        const auto& objects = scene.GetObjects();
+        EntityRegistry::Instance().View<LightComponent>().Each([&](Entity, LightComponent& component) {
+            switch (component.light->type) {
+                case Light::Type::Point: pointLights.push_back(component.light); break;
+                case Light::Type::Spot: spotLights.push_back(component.light); break;
+                case Light::Type::Directional: if (!dirLight) dirLight = component.light; break;
+            }
+        });
+        for (const auto& [mesh, indices] : scene.GetRenderablesByMesh()) meshes.insert(meshes.end(), indices.size(), mesh);
+        for (size_t index : scene.GetModels()) {
+            auto* model = static_cast<Model*>(objects[index].get());
+            for (size_t m = 0; m < model->GetMeshCount(); ++m) meshes.push_back(model->GetMeshAt(m));
+        }
+    });
+    const size_t newCount = meshes.size() + pointLights.size() + spotLights.size();
+
+    const std::string count = std::to_string(objectCount);
+    std::vector<BenchmarkResult> results;
+    BenchmarkResult r;
+    r.name = "Scene dispatch dynamic_cast (" + count + " objects)";
+    r.ms = oldMs;
+    r.detail = Format("%.0f collected", (double)oldCount);
+    results.push_back(r);
+    r.name = "Scene dispatch registries (" + count + " objects)";
+    r.ms = newMs;
+    r.detail = Format("%.0f collected, %.1fx faster", (double)newCount, oldMs / newMs);
+    results.push_back(r);
+    r.name = "Scene::AddObject (" + count + " objects)";
+    r.ms = addMs;
+    r.detail = "one-off, includes registration";
+    results.push_back(r);
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::LightClustering(const std::vector<size_t>& lightCounts, int runs) {
+    // Gleiche Kamera wie der Editor-Start; Lichter verteilt auf eine 120 x 120 Fläche vor der Kamera
+    const float nearPlane = 0.1f, farPlane = 100.0f;
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, nearPlane, farPlane);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 8.0f, 20.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    std::vector<BenchmarkResult> results;
+    for (size_t lightCount : lightCounts) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> pos(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> height(0.2f, 4.0f);
+        std::uniform_real_distribution<float> range(1.0f, 6.0f);
+        std::vector<GpuClusterLight> lights(lightCount);
+        for (auto& light : lights) {
+            light.positionRange = glm::vec4(pos(rng), height(rng), pos(rng), range(rng));
+            light.colorType = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+        }
+
+        LightClusterer clusterer;
+        clusterer.Build(lights, view, proj, nearPlane, farPlane); // Cluster-AABBs vorab
+        double ms = MedianMs(runs, [&] { clusterer.Build(lights, view, proj, nearPlane, farPlane); });
+
+        BenchmarkResult r;
+        r.name = "Light clustering (" + std::to_string(lightCount) + " lights)";
+        r.ms = ms;
+        r.detail = Format("%.0f visible, %.0f indices", (double)clusterer.GetVisibleLightCount(),
+                          (double)clusterer.GetIndexCount());
+        results.push_back(r);
+    }
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::OcclusionCulling(size_t objectCount, int runs) {
+    // Einheitswürfel als Occluder-Mesh, per Model-Matrix zu Wänden und Boden skaliert
+    const glm::vec3 cubeVertices[8] = {
+        {-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f},
+        {-0.5f, -0.5f,  0.5f}, {0.5f, -0.5f,  0.5f}, {0.5f, 0.5f,  0.5f}, {-0.5f, 0.5f,  0.5f},
+    };
+    const uint32_t cubeIndices[36] = {
+        0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+        3, 6, 2, 3, 7, 6,   0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5,
+    };
+    std::vector<glm::mat4> occluders;
+    // Drei Wandreihen mit 1 m breiten Durchgängen alle 8 m
+    for (int row = 0; row < 3; ++row) {
+        const float z = -10.0f - 15.0f * row;
+        for (float x = -40.0f; x < 40.0f; x += 8.0f) {
+            glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(x + 4.0f + row, 2.0f, z));
+            occluders.push_back(glm::scale(m, glm::vec3(7.0f, 4.0f, 0.4f)));
+        }
+    }
+    occluders.push_back(glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.1f, -40.0f)),
+                                   glm::vec3(100.0f, 0.2f, 100.0f)));
+
+    std::mt19937 rng(2468);
+    std::uniform_real_distribution<float> px(-40.0f, 40.0f), py(0.0f, 3.0f), pz(-80.0f, -1.0f), ext(0.3f, 1.0f);
+    FrustumCuller boxes;
+    boxes.Reserve(objectCount);
+    for (size_t i = 0; i < objectCount; ++i) {
+        boxes.AddWorld(glm::vec3(px(rng), py(rng), pz(rng)), glm::vec3(ext(rng), ext(rng), ext(rng)));
+    }
+
+    // Seitenverhältnis des Tiefenpuffers, Augenhöhe
+    const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 200.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 0.0f), glm::vec3(0.0f, 1.7f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 viewProj = proj * view;
+    std::vector<uint8_t> visible;
+    const size_t frustumVisible = boxes.Cull(Frustum::FromMatrix(viewProj), visible);
+
+    OcclusionCuller culler;
+    double rasterMs = MedianMs(runs, [&] {
+        culler.Begin(viewProj);
+        for (const glm::mat4& m : occluders) culler.AddOccluder(cubeVertices, sizeof(glm::vec3), 8, cubeIndices, 36, m);
+        culler.Rasterize();
+    });
+
+    JobSystem& jobs = JobSystem::Instance();
+    std::atomic<size_t> occluded{0};
+    double testMs = MedianMs(runs, [&] {
+        occluded = 0;
+        jobs.ParallelFor(0, objectCount, 1024, [&](size_t begin, size_t end) {
+            size_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                if (visible[i] && culler.IsOccluded(boxes.GetCenter(i), boxes.GetExtents(i))) ++local;
+            }
+            occluded += local;
+        });
+    });
+
+    std::vector<BenchmarkResult> results;
+    BenchmarkResult raster;
+    raster.name = "Occlusion Raster (" + std::to_string(culler.GetTriangleCount()) + " triangles)";
+    raster.ms = rasterMs;
+    raster.detail = std::to_string(OcclusionCuller::Width) + "x" + std::to_string(OcclusionCuller::Height) + " depth, " +
+                    std::to_string(jobs.ThreadCount()) + " threads";
+    results.push_back(raster);
+
+    BenchmarkResult test;
+    test.name = "Occlusion Test (" + std::to_string(objectCount) + " boxes)";
+    test.ms = testMs;
+    test.detail = Format("%.1f%% of %.0f frustum-visible occluded",
+                         frustumVisible ? 100.0 * occluded / frustumVisible : 0.0, (double)frustumVisible);
+    results.push_back(test);
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::GpuCulling(size_t instanceCount, int runs) {
+    // Gleiche Verteilung wie FrustumCulling, aber als Instanzen eines Einheitswürfels
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> size(0.2f, 4.0f);
+    std::vector<InstanceData> instances(instanceCount);
+    std::vector<glm::mat4> models(instanceCount);
+    std::vector<CullBounds> bounds(instanceCount, CullBounds{ glm::vec3(0.0f), 0u, glm::vec3(0.5f), 0.0f });
+    for (size_t i = 0; i < instanceCount; ++i) {
+        const glm::vec3 position(pos(rng), pos(rng), pos(rng));
+        const glm::vec3 scale(size(rng), size(rng), size(rng));
+        instances[i] = InstanceData::Make(position, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), scale, 0);
+        models[i] = glm::scale(glm::translate(glm::mat4(1.0f), position), scale);
+    }
+
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::FromMatrix(proj * view);
+
+    std::vector<BenchmarkResult> results;
+    const std::string suffix = " (" + std::to_string(instanceCount) + " instances)";
+
+    // CPU-Pfad des Renderers: Welt-AABBs parallel berechnen, dann SIMD-Test
+    FrustumCuller cpu;
+    cpu.Resize(instanceCount);
+    std::vector<uint8_t> visible;
+    size_t cpuVisible = 0;
+    JobSystem& jobs = JobSystem::Instance();
+    double cpuMs = MedianMs(runs, [&] {
+        jobs.ParallelFor(0, instanceCount, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) cpu.Set(i, glm::vec3(-0.5f), glm::vec3(0.5f), models[i]);
+        });
+        cpuVisible = cpu.Cull(frustum, visible);
+    });
+    results.push_back({ "CPU Culling" + suffix, cpuMs, Format("%.0f visible, %.0f threads", (double)cpuVisible, jobs.ThreadCount()) });
+
+    // Ein Batch über alle Instanzen; gemessen wird bis glFinish, Upload eingeschlossen
+    std::vector<RenderQueue::Batch> batches(1);
+    batches[0].first = 0;
+    batches[0].count = static_cast<uint32_t>(instanceCount);
+    GLuint indirect = 0;
+    glGenBuffers(1, &indirect);
+    const GLCapabilities& caps = GLCapabilities::Get();
+    for (bool compute : { true, false }) {
+        if (compute && !(caps.computeShader && caps.multiDrawIndirect)) continue;
+        GpuCuller culler;
+        culler.Init(compute);
+        const DrawElementsIndirectCommand reset = { 36, 0, 0, 0, 0 };
+        double ms = MedianMs(runs, [&] {
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(reset), &reset, GL_STREAM_DRAW);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            culler.Upload(instances.data(), bounds.data(), instanceCount);
+            culler.Cull(frustum, batches, indirect);
+            glFinish();
+        });
+
+        size_t gpuVisible = 0;
+        if (culler.GetMode() == GpuCuller::Mode::Compute) {
+            DrawElementsIndirectCommand result{};
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+            glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(result), &result);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            gpuVisible = result.instanceCount;
+        } else if (!culler.ReadVisibleCounts().empty()) {
+            gpuVisible = culler.ReadVisibleCounts()[0];
+        }
+        results.push_back({ std::string("GPU Culling, ") + GpuCuller::ModeName(culler.GetMode()) + suffix, ms,
+                            Format("%.0f visible (CPU %.0f)", (double)gpuVisible, (double)cpuVisible) });
+    }
+    glDeleteBuffers(1, &indirect);
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::InstanceTransforms(size_t instanceCount, int runs) {
+    // UV-Kugel, 64 x 32 Segmente
+    const int segments = 64, rings = 32;
+    std::vector<Vertex> vertices;
+    for (int r = 0; r <= rings; ++r) {
+        for (int s = 0; s <= segments; ++s) {
+            const float theta = glm::radians(180.0f) * r / rings;
+            const float phi = 2.0f * glm::radians(180.0f) * s / segments;
+            const glm::vec3 p(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            vertices.push_back({ p, p, glm::vec2(static_cast<float>(s) / segments, static_cast<float>(r) / rings) });
+        }
+    }
+    std::vector<unsigned int> indices;
+    for (int r = 0; r < rings; ++r) {
+        for (int s = 0; s < segments; ++s) {
+            const unsigned int a = r * (segments + 1) + s;
+            const unsigned int b = a + 1, c = a + segments + 1, d = c + 1;
+            for (unsigned int v : { a, b, c, b, d, c }) indices.push_back(v);
+        }
+    }
+
+    // Zufällige Position, Rotation und Skalierung; beide Layouts beschreiben dieselben Instanzen
+    struct MatrixInstance {
+        glm::mat4 model;
+        uint32_t material;
+    };
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::vector<MatrixInstance> matrixInstances(instanceCount);
+    std::vector<InstanceData> instances(instanceCount);
+    for (size_t i = 0; i < instanceCount; ++i) {
+        const glm::vec3 position(pos(rng), pos(rng), pos(rng));
+        const glm::quat rotation = glm::angleAxis(glm::radians(angle(rng)), glm::normalize(glm::vec3(pos(rng), pos(rng), 1.0f)));
+        const glm::vec3 scale(size(rng), size(rng), size(rng));
+        instances[i] = InstanceData::Make(position, rotation, scale, 0);
+        matrixInstances[i].model = glm::scale(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation), scale);
+        matrixInstances[i].material = 0;
+    }
+
+    GLuint vbo = 0, ebo = 0, instanceBuffers[2] = { 0, 0 }, vaos[2] = { 0, 0 };
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenBuffers(2, instanceBuffers);
+    glGenVertexArrays(2, vaos);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+    // [0] = Model-Matrix (Locations 3-6, 7), [1] = InstanceData wie GeometryArena::SetInstanceBuffer
+    for (int layout = 0; layout < 2; ++layout) {
+        glBindVertexArray(vaos[layout]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        if (layout == 0) glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        for (int i = 0; i < 3; ++i) glEnableVertexAttribArray(i);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffers[layout]);
+        if (layout == 0) {
+            for (int i = 0; i < 4; ++i) {
+                glEnableVertexAttribArray(3 + i);
+                glVertexAttribDivisor(3 + i, 1);
+                glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(MatrixInstance), (void*)(sizeof(float) * i * 4));
+            }
+            glVertexAttribIPointer(7, 1, GL_UNSIGNED_INT, sizeof(MatrixInstance), (void*)offsetof(MatrixInstance, material));
+        } else {
+            for (int location : { 3, 4, 5 }) {
+                glEnableVertexAttribArray(location);
+                glVertexAttribDivisor(location, 1);
+            }
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, position));
+            glVertexAttribPointer(4, 4, GL_SHORT, GL_TRUE, sizeof(InstanceData), (void*)offsetof(InstanceData, rotation));
+            glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, scale));
+            glVertexAttribIPointer(7, 1, GL_UNSIGNED_INT, sizeof(InstanceData), (void*)offsetof(InstanceData, material));
+        }
+        glEnableVertexAttribArray(7);
+        glVertexAttribDivisor(7, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Das Fragment-Programm liest alle Ausgaben, damit der Linker nichts (z.B. das inverse()) wegoptimiert
+    Shader matrixShader("shaders/InstanceMatrix.vert", "shaders/InstanceBenchmark.frag");
+    Shader compactShader("shaders/StandardLit.vert", "shaders/InstanceBenchmark.frag");
+    Shader* shaders[2] = { &matrixShader, &compactShader };
+    const char* names[2] = { "mat4 + inverse()", "Position/Quaternion/Scale" };
+    const void* data[2] = { matrixInstances.data(), instances.data() };
+    const size_t strides[2] = { sizeof(MatrixInstance), sizeof(InstanceData) };
+
+    std::vector<BenchmarkResult> results;
+    const std::string suffix = " (" + std::to_string(instanceCount) + " instances)";
+    double vertexMs[2] = { 0.0, 0.0 };
+    for (int layout = 0; layout < 2; ++layout) {
+        const size_t bytes = instanceCount * strides[layout];
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffers[layout]);
+        const double uploadMs = MedianMs(runs, [&] {
+            glBufferData(GL_ARRAY_BUFFER, bytes, data[layout], GL_STREAM_DRAW);
+            glFinish();
+        });
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        results.push_back({ std::string("Instance Upload, ") + names[layout] + suffix, uploadMs,
+                            Format("%.0f B/instance, %.2f MB", (double)strides[layout], bytes / (1024.0 * 1024.0)) });
+
+        // Nur die Vertex-Stufe: ohne Rasterizer fallen Fragment-Kosten und Overdraw weg
+        shaders[layout]->Use();
+        glBindVertexArray(vaos[layout]);
+        glEnable(GL_RASTERIZER_DISCARD);
+        vertexMs[layout] = MedianMs(runs, [&] {
+            glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr,
+                                    static_cast<GLsizei>(instanceCount));
+            glFinish();
+        });
+        glDisable(GL_RASTERIZER_DISCARD);
+        glBindVertexArray(0);
+        results.push_back({ std::string("Vertex Shader, ") + names[layout] + suffix, vertexMs[layout],
+                            Format("%.1f M vertices, %.2f ns/vertex", vertices.size() * instanceCount / 1e6,
+                                   vertexMs[layout] * 1e6 / (double(vertices.size()) * instanceCount)) });
+    }
+    if (vertexMs[1] > 0.0) results.back().detail += Format(", %.2fx vs. mat4", vertexMs[0] / vertexMs[1]);
+
+    glDeleteVertexArrays(2, vaos);
+    glDeleteBuffers(2, instanceBuffers);
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &vbo);
+    glDeleteProgram(matrixShader.ID);
+    glDeleteProgram(compactShader.ID);
+    glUseProgram(0);
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::MeshOptimization(size_t triangleCount, int runs) {
+    // UV-Kugel mit Naht, Dreiecke und Vertices zufällig gemischt (ungünstigster Fall einer Import-Reihenfolge)
+    const int segments = std::max(8, static_cast<int>(std::sqrt(triangleCount)));
+    const int rings = std::max(4, segments / 2);
+    std::vector<Vertex> vertices;
+    for (int r = 0; r <= rings; ++r) {
+        for (int s = 0; s <= segments; ++s) {
+            const float theta = glm::radians(180.0f) * r / rings;
+            const float phi = 2.0f * glm::radians(180.0f) * s / segments;
+            const glm::vec3 p(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            vertices.push_back({ p, p, glm::vec2(static_cast<float>(s) / segments, static_cast<float>(r) / rings) });
+        }
+    }
+    std::mt19937 rng(1357);
+    std::vector<unsigned int> vertexOrder(vertices.size());
+    std::iota(vertexOrder.begin(), vertexOrder.end(), 0u);
+    std::shuffle(vertexOrder.begin(), vertexOrder.end(), rng);
+    std::vector<Vertex> shuffledVertices(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) shuffledVertices[vertexOrder[i]] = vertices[i];
+
+    std::vector<unsigned int> quads(static_cast<size_t>(rings) * segments);
+    std::iota(quads.begin(), quads.end(), 0u);
+    std::shuffle(quads.begin(), quads.end(), rng);
+    std::vector<unsigned int> indices;
+    indices.reserve(quads.size() * 6);
+    for (unsigned int q : quads) {
+        const unsigned int a = (q / segments) * (segments + 1) + q % segments;
+        const unsigned int b = a + 1, c = a + segments + 1, d = c + 1;
+        for (unsigned int v : { a, b, c, b, d, c }) indices.push_back(vertexOrder[v]);
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (bool overdraw : { false, true }) {
+        std::vector<Vertex> optimizedVertices;
+        std::vector<unsigned int> optimizedIndices;
+        MeshOptimizer::Result stats;
+        const double ms = MedianMs(runs, [&] {
+            optimizedVertices = shuffledVertices;
+            optimizedIndices = indices;
+            stats = MeshOptimizer::Optimize(optimizedVertices, optimizedIndices, overdraw);
+        });
+        const bool identical = MeshOptimizer::IsEquivalent(shuffledVertices, indices, optimizedVertices, optimizedIndices);
+
+        BenchmarkResult result;
+        result.name = std::string(overdraw ? "Vertex Cache + Overdraw" : "Vertex Cache") + " (" +
+                      std::to_string(indices.size() / 3) + " triangles)";
+        result.ms = ms;
+        result.detail = Format("ACMR %.3f -> %.3f", stats.before.Acmr(), stats.after.Acmr()) + ", " +
+                        Format("ATVR %.3f -> %.3f", stats.before.Atvr(), stats.after.Atvr()) +
+                        (identical ? ", geometry identical" : ", GEOMETRY MISMATCH");
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmarks::ModelCache(const std::string& modelDirectory, int runs) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(modelDirectory, error)) {
+        const std::string ext = entry.path().extension().string();
+        if (entry.is_regular_file() && (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb")) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::vector<BenchmarkResult> results;
+    BenchmarkResult r;
+    if (paths.empty()) {
+        r.name = "Model cache";
+        r.detail = "no models in " + modelDirectory;
+        results.push_back(r);
+        return results;
+    }
+
+    // Eigener Cache-Ordner, damit der Projekt-Cache unberührt bleibt: kalt = geleert (Assimp + Kochen),
+    // warm = vom kalten Lauf gefüllt (Mapping). Nur die CPU-Phase, der GPU-Upload ist in beiden Fällen gleich.
+    const std::string cacheDirectory = (std::filesystem::temp_directory_path(error) / "arkmesh-benchmark").string();
+    auto importAll = [&] {
+        for (const std::string& path : paths) ModelAsset(path, cacheDirectory).ImportCpu();
+    };
+    std::vector<double> cold, warm;
+    for (int i = 0; i < runs; ++i) {
+        std::filesystem::remove_all(cacheDirectory, error);
+        auto start = Clock::now();
+        importAll();
+        cold.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        start = Clock::now();
+        importAll();
+        warm.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(cold.begin(), cold.end());
+    std::sort(warm.begin(), warm.end());
+    const double coldMs = cold[cold.size() / 2];
+    const double warmMs = warm[warm.size() / 2];
+
+    size_t cacheBytes = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory, error)) {
+        if (entry.is_regular_file()) cacheBytes += static_cast<size_t>(entry.file_size(error));
+    }
+    std::filesystem::remove_all(cacheDirectory, error);
+
+    const std::string count = std::to_string(paths.size());
+    r.name = "Model import cold (" + count + " models)";
+    r.ms = coldMs;
+    r.detail = "Assimp + optimize + LODs + write .arkmesh";
+    results.push_back(r);
+    r.name = "Model import warm (" + count + " models)";
+    r.ms = warmMs;
+    r.detail = Format("mmap .arkmesh, %.1f MB, %.1fx faster", cacheBytes / (1024.0 * 1024.0), coldMs / warmMs);
+    results.push_back(r);
+    return results;
+}
+
+void Benchmarks::BuildLightScene(Scene& scene, size_t lightCount) {
+    scene.Clear();
+    std::mt19937 rng(99);
+
+    auto floor = std::make_shared<Plane>();
+    floor->SetScale(glm::vec3(120.0f, 1.0f, 120.0f));
+    scene.AddObject(floor);
+
+    // Würfelraster; alle Würfel teilen sich einen Mesh -> wenige Draw Calls, die Kosten liegen im Shading
+    for (int x = -10; x <= 10; ++x) {
+        for (int z = -10; z <= 10; ++z) {
+            auto cube = std::make_shared<Cube>();
+            cube->SetPosition(glm::vec3(x * 5.0f, 0.5f, z * 5.0f));
+            scene.AddObject(cube);
+        }
+    }
+
+    auto sun = std::make_shared<DirectionalLight>();
+    sun->color = glm::vec3(0.1f);
+    sun->direction = glm::vec3(-0.3f, -1.0f, -0.2f);
+    scene.AddObject(sun);
+
+    std::uniform_real_distribution<float> pos(-55.0f, 55.0f);
+    std::uniform_real_distribution<float> height(0.3f, 3.0f);
+    std::uniform_real_distribution<float> channel(0.2f, 1.0f);
+    for (size_t i = 0; i < lightCount; ++i) {
+        auto light = std::make_shared<PointLight>();
+        light->SetPosition(glm::vec3(pos(rng), height(rng), pos(rng)));
+        light->color = glm::vec3(channel(rng), channel(rng), channel(rng));
+        // Reichweite ~5 Einheiten (siehe Light::GetRange)
+        light->linear = 0.7f;
+        light->quadratic = 1.8f;
+        scene.AddObject(light);
+    }
+}
+
+void Benchmarks::BuildMaterialScene(Scene& scene, size_t objectCount) {
+    scene.Clear();
+
+    const std::vector<MaterialDesc> materialSets = {
+        { "resources/images/container2.png", "resources/images/container2_specular.png", 32.0f },
+        { "resources/images/container.jpg", "", 16.0f },
+        { "resources/images/awesomeface.png", "", 32.0f },
+        { "resources/images/container.jpg", "resources/images/container2_specular.png", 64.0f },
+    };
+    // Ein Mesh pro Material (Primitive-Registry); die GeometryArena legt die identischen Vertexdaten zusammen
+    std::vector<std::shared_ptr<Material>> materials;
+    for (const auto& desc : materialSets) materials.push_back(ResourceManager::GetMaterial(desc));
+
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(objectCount))));
+    for (size_t i = 0; i < objectCount; ++i) {
+        auto cube = std::make_shared<Cube>(materials[i % materials.size()]);
+        const int x = static_cast<int>(i) % side - side / 2;
+        const int z = static_cast<int>(i) / side - side / 2;
+        cube->SetPosition(glm::vec3(x * 2.0f, 0.5f, z * 2.0f));
+        scene.AddObject(cube);
+    }
+
+    auto sun = std::make_shared<DirectionalLight>();
+    sun->direction = glm::vec3(-0.3f, -1.0f, -0.2f);
+    scene.AddObject(sun);
+}
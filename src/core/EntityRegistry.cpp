@@ -0,0 +1,52 @@
+#include "../../include/core/EntityRegistry.hpp"
+
+EntityRegistry& EntityRegistry::Instance() {
+    // Absichtlich nie zerstört: GameObjects in statischen Caches (ResourceManager) melden sich
+    // beim Programmende noch ab, wenn lokale Statics bereits abgebaut sein können.
+    static EntityRegistry* instance = new EntityRegistry();
+    return *instance;
+}
+
+size_t EntityRegistry::NextTypeId() {
+    static size_t next = 0;
+    return next++;
+}
+
+Entity EntityRegistry::Create() {
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(generations.size());
+        generations.push_back(0);
+    }
+    return (static_cast<uint32_t>(generations[index]) << 24) | index;
+}
+
+void EntityRegistry::Destroy(Entity e) {
+    if (!IsAlive(e)) return;
+    for (auto& pool : pools) {
+        if (pool) pool->Remove(e);
+    }
+    const uint32_t index = EntityIndex(e);
+    ++generations[index];
+    freeIndices.push_back(index);
+}
+
+bool EntityRegistry::IsAlive(Entity e) const {
+    const uint32_t index = EntityIndex(e);
+    return e != NullEntity && index < generations.size() && generations[index] == EntityGeneration(e);
+}
+
+void EntityRegistry::Clear() {
+    for (auto& pool : pools) {
+        if (pool) pool->Clear();
+    }
+    // Generationen weiterzählen, damit alte Handles ungültig bleiben
+    freeIndices.clear();
+    for (uint32_t i = 0; i < generations.size(); ++i) {
+        ++generations[i];
+        freeIndices.push_back(i);
+    }
+}
@@ -0,0 +1,185 @@
+#include "../../include/core/FrustumCuller.hpp"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ARK_CULL_SSE 1
+#include <immintrin.h>
+#endif
+// AVX ohne -mavx bzw. /arch:AVX: nur der 8er-Kernel wird für AVX übersetzt und zur Laufzeit gewählt,
+// wenn CPU und Betriebssystem es unterstützen. Der Rest der Datei bleibt beim Basis-Befehlssatz.
+#if ARK_CULL_SSE && (defined(__GNUC__) || defined(_MSC_VER))
+#define ARK_CULL_AVX 1
+#if defined(__GNUC__)
+#define ARK_TARGET_AVX __attribute__((target("avx")))
+#else
+#define ARK_TARGET_AVX
+#include <intrin.h>
+#endif
+#endif
+
+#if ARK_CULL_AVX
+namespace {
+    bool CpuHasAvx() {
+#if defined(__GNUC__)
+        return __builtin_cpu_supports("avx");
+#else
+        // OSXSAVE + AVX, und das Betriebssystem sichert die YMM-Register (XCR0 Bits 1 und 2)
+        int info[4];
+        __cpuid(info, 1);
+        const bool cpu = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+        return cpu && (_xgetbv(0) & 0x6) == 0x6;
+#endif
+    }
+
+    // Volle 8er-Blöcke ab i; i zeigt danach auf den ersten nicht verarbeiteten Index
+    ARK_TARGET_AVX size_t CullAvx(const Frustum& frustum, const float* cx, const float* cy, const float* cz,
+                                  const float* ex, const float* ey, const float* ez, uint8_t* out, size_t& i, size_t end) {
+        size_t numVisible = 0;
+        for (; i + 8 <= end; i += 8) {
+            const __m256 pcx = _mm256_loadu_ps(cx + i), pcy = _mm256_loadu_ps(cy + i), pcz = _mm256_loadu_ps(cz + i);
+            const __m256 pex = _mm256_loadu_ps(ex + i), pey = _mm256_loadu_ps(ey + i), pez = _mm256_loadu_ps(ez + i);
+            __m256 outside = _mm256_setzero_ps();
+            for (const auto& p : frustum.planes) {
+                // d = n·c + w, r = |n|·e; außerhalb, wenn d + r < 0
+                __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.x), pcx),
+                                                       _mm256_mul_ps(_mm256_set1_ps(p.y), pcy)),
+                                         _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.z), pcz), _mm256_set1_ps(p.w)));
+                __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(p.x)), pex),
+                                                       _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.y)), pey)),
+                                         _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.z)), pez));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+            int mask = _mm256_movemask_ps(outside);
+            for (int k = 0; k < 8; ++k) {
+                uint8_t v = (mask >> k) & 1 ? 0 : 1;
+                out[i + k] = v;
+                numVisible += v;
+            }
+        }
+        return numVisible;
+    }
+}
+#endif
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+    // Gribb/Hartmann: Zeilen der (spaltenweise gespeicherten) Matrix kombinieren
+    auto row = [&](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum f;
+    f.planes[0] = r3 + r0; // links
+    f.planes[1] = r3 - r0; // rechts
+    f.planes[2] = r3 + r1; // unten
+    f.planes[3] = r3 - r1; // oben
+    f.planes[4] = r3 + r2; // nah
+    f.planes[5] = r3 - r2; // fern
+    for (auto& p : f.planes) {
+        float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) p = p / len;
+    }
+    return f;
+}
+
+void FrustumCuller::Clear() {
+    cx.clear(); cy.clear(); cz.clear();
+    ex.clear(); ey.clear(); ez.clear();
+    count = 0;
+}
+
+void FrustumCuller::Reserve(size_t n) {
+    cx.reserve(n); cy.reserve(n); cz.reserve(n);
+    ex.reserve(n); ey.reserve(n); ez.reserve(n);
+}
+
+void FrustumCuller::Resize(size_t n) {
+    cx.resize(n); cy.resize(n); cz.resize(n);
+    ex.resize(n); ey.resize(n); ez.resize(n);
+    count = n;
+}
+
+uint32_t FrustumCuller::Add(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model) {
+    Resize(count + 1);
+    Set(count - 1, localMin, localMax, model);
+    return static_cast<uint32_t>(count - 1);
+}
+
+uint32_t FrustumCuller::AddWorld(const glm::vec3& center, const glm::vec3& extents) {
+    Resize(count + 1);
+    SetWorld(count - 1, center, extents);
+    return static_cast<uint32_t>(count - 1);
+}
+
+void FrustumCuller::Set(size_t index, const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& model) {
+    // Arvo: Center transformieren, Extents mit |M| (oberes 3x3) transformieren
+    const glm::vec3 c = (localMin + localMax) * 0.5f;
+    const glm::vec3 e = (localMax - localMin) * 0.5f;
+    glm::vec3 wc(model[3]);
+    glm::vec3 we(0.0f);
+    for (int col = 0; col < 3; ++col) {
+        for (int r = 0; r < 3; ++r) {
+            wc[r] += model[col][r] * c[col];
+            we[r] += std::fabs(model[col][r]) * e[col];
+        }
+    }
+    SetWorld(index, wc, we);
+}
+
+void FrustumCuller::SetWorld(size_t index, const glm::vec3& center, const glm::vec3& extents) {
+    cx[index] = center.x; cy[index] = center.y; cz[index] = center.z;
+    ex[index] = extents.x; ey[index] = extents.y; ez[index] = extents.z;
+}
+
+size_t FrustumCuller::CullScalar(const Frustum& frustum, uint8_t* visible, size_t begin, size_t end) const {
+    size_t numVisible = 0;
+    for (size_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (const auto& p : frustum.planes) {
+            float d = p.x * cx[i] + p.y * cy[i] + p.z * cz[i] + p.w;
+            float r = std::fabs(p.x) * ex[i] + std::fabs(p.y) * ey[i] + std::fabs(p.z) * ez[i];
+            if (d < -r) { inside = false; break; }
+        }
+        visible[i] = inside ? 1 : 0;
+        numVisible += inside ? 1 : 0;
+    }
+    return numVisible;
+}
+
+size_t FrustumCuller::Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const {
+    visible.resize(count);
+    return CullRange(frustum, visible.data(), 0, count);
+}
+
+size_t FrustumCuller::CullRange(const Frustum& frustum, uint8_t* out, size_t begin, size_t end) const {
+    size_t numVisible = 0;
+    size_t i = begin;
+
+#if ARK_CULL_AVX
+    static const bool hasAvx = CpuHasAvx();
+    if (hasAvx) {
+        numVisible += CullAvx(frustum, cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data(), out, i, end);
+    }
+#endif
+#if ARK_CULL_SSE
+    for (; i + 4 <= end; i += 4) {
+        const __m128 pcx = _mm_loadu_ps(&cx[i]), pcy = _mm_loadu_ps(&cy[i]), pcz = _mm_loadu_ps(&cz[i]);
+        const __m128 pex = _mm_loadu_ps(&ex[i]), pey = _mm_loadu_ps(&ey[i]), pez = _mm_loadu_ps(&ez[i]);
+        __m128 outside = _mm_setzero_ps();
+        for (const auto& p : frustum.planes) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), pcx), _mm_mul_ps(_mm_set1_ps(p.y), pcy)),
+                                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.z), pcz), _mm_set1_ps(p.w)));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(p.x)), pex),
+                                             _mm_mul_ps(_mm_set1_ps(std::fabs(p.y)), pey)),
+                                  _mm_mul_ps(_mm_set1_ps(std::fabs(p.z)), pez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(outside);
+        for (int k = 0; k < 4; ++k) {
+            uint8_t v = (mask >> k) & 1 ? 0 : 1;
+            out[i + k] = v;
+            numVisible += v;
+        }
+    }
+#endif
+    numVisible += CullScalar(frustum, out, i, end);
+    return numVisible;
+}
@@ -0,0 +1,55 @@
+#include "glad/glad.h"
+#include "../../include/core/GLCapabilities.hpp"
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+    std::thread::id contextThread;
+}
+
+// Extension-Erkennung ohne GLAD Variablen
+bool GLCapabilities::HasExtension(const char* name) {
+    if (!name) return false;
+    GLint numExt = 0;
+    if (glGetStringi) {
+        glGetIntegerv(GL_NUM_EXTENSIONS, &numExt);
+        for (GLint i=0;i<numExt;++i) {
+            const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (ext && std::strcmp(ext, name)==0) return true;
+        }
+        return false;
+    }
+    // Fallback (älter): gesamter String (deprecated, aber als Rückfallebene ok)
+    const char* all = (const char*)glGetString(GL_EXTENSIONS);
+    if (!all) return false;
+    std::string s(all);
+    std::string needle(name);
+    needle.push_back(' ');
+    if (s.rfind(needle, 0) == 0) return true; // ganz vorne
+    return s.find(std::string(" ")+needle) != std::string::npos;
+}
+
+const GLCapabilities& GLCapabilities::Get() {
+    static GLCapabilities caps = [] {
+        GLCapabilities c;
+        c.bufferStorage = glBufferStorage && (GLAD_GL_VERSION_4_4 || HasExtension("GL_ARB_buffer_storage"));
+        // baseInstance im Kommando wird gebraucht, damit jeder Batch seine Matrizen findet
+        c.multiDrawIndirect = glMultiDrawElementsIndirect &&
+                              (GLAD_GL_VERSION_4_3 || HasExtension("GL_ARB_multi_draw_indirect")) &&
+                              (GLAD_GL_VERSION_4_2 || HasExtension("GL_ARB_base_instance"));
+        c.computeShader = glDispatchCompute && glMemoryBarrier &&
+                          (GLAD_GL_VERSION_4_3 || (HasExtension("GL_ARB_compute_shader") &&
+                                                   HasExtension("GL_ARB_shader_storage_buffer_object")));
+        return c;
+    }();
+    return caps;
+}
+
+void GLCapabilities::SetContextThread() {
+    contextThread = std::this_thread::get_id();
+}
+
+bool GLCapabilities::IsContextThread() {
+    return std::this_thread::get_id() == contextThread;
+}
@@ -0,0 +1,554 @@
+#include "glad/glad.h"
+#include "../../include/core/GeometryArena.hpp"
+#include "../../include/objects/Mesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Startgrößen pro Format; danach Verdopplung
+    constexpr uint32_t InitialVertexCapacity = 1u << 18;
+    constexpr uint32_t InitialIndexCapacity = 1u << 20;
+
+    // 128-Bit-Inhaltshash über Vertex- und Indexdaten, zwei unabhängige Multiplikations-Lanes über 8-Byte-Worte.
+    // Breit genug, dass ein Treffer als gleich gilt: kein Readback aus der Arena zum Vergleichen.
+    struct ContentHash {
+        uint64_t low = 0x9E3779B97F4A7C15ull;
+        uint64_t high = 0xC2B2AE3D27D4EB4Full;
+
+        void Add(const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                Mix(word);
+            }
+            uint64_t tail = 0;
+            if (size > i) std::memcpy(&tail, bytes + i, size - i);
+            // Länge einmischen, damit die Grenze zwischen Vertex- und Indexdaten zählt
+            Mix(tail ^ (static_cast<uint64_t>(size) << 3));
+        }
+        void Mix(uint64_t word) {
+            low = (low ^ word) * 0x100000001B3ull;
+            low ^= low >> 29;
+            high = (high + word) * 0xFF51AFD7ED558CCDull;
+            high = (high << 31) | (high >> 33);
+        }
+        static uint64_t Finalize(uint64_t h) {
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ull;
+            return h ^ (h >> 33);
+        }
+    };
+
+    // IEEE-754 binary16, rundet zum nächsten Wert; zu große Werte werden unendlich
+    uint16_t FloatToHalf(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const uint32_t exponentBits = (bits >> 23) & 0xFFu;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+        if (exponentBits == 0xFFu) return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+        const int exponent = static_cast<int>(exponentBits) - 127 + 15;
+        if (exponent >= 31) return static_cast<uint16_t>(sign | 0x7C00u);
+        if (exponent <= 0) {
+            // Subnormal bzw. 0
+            if (exponent < -10) return static_cast<uint16_t>(sign);
+            mantissa |= 0x800000u;
+            const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1u) ++half;
+            return static_cast<uint16_t>(sign | half);
+        }
+        uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if (mantissa & 0x1000u) ++half;     // Übertrag in den Exponenten ist korrekt
+        return static_cast<uint16_t>(half);
+    }
+
+    int16_t ToSnorm16(float value) {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    // Oktaeder-Abbildung der Einheitskugel auf [-1,1]^2 (Gegenstück: OctDecode in StandardLit.vert)
+    glm::vec2 OctEncode(const glm::vec3& n) {
+        const float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (sum <= 0.0f) return glm::vec2(0.0f);   // dekodiert zu +Z
+        glm::vec2 p(n.x / sum, n.y / sum);
+        if (n.z < 0.0f) {
+            const glm::vec2 folded((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                                   (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+            p = folded;
+        }
+        return p;
+    }
+
+    // Kodiert die Vertices des Formats; liefert Offset/Skalierung der Positionen (Compact) zurück
+    void EncodeVertices(VertexFormat format, const Vertex* vertices, size_t count, std::vector<unsigned char>& vertexBytes,
+                        std::vector<unsigned char>& positionBytes, glm::vec3& offset, glm::vec3& scale) {
+        if (!IsCompactFormat(format)) {
+            vertexBytes.resize(count * sizeof(Vertex));
+            if (count > 0) std::memcpy(vertexBytes.data(), vertices, count * sizeof(Vertex));
+            positionBytes.resize(count * sizeof(glm::vec3));
+            auto* positions = reinterpret_cast<glm::vec3*>(positionBytes.data());
+            for (size_t i = 0; i < count; ++i) positions[i] = vertices[i].position;
+            offset = glm::vec3(0.0f);
+            scale = glm::vec3(1.0f);
+            return;
+        }
+
+        glm::vec3 mn(0.0f), mx(0.0f);
+        if (count > 0) mn = mx = vertices[0].position;
+        for (size_t i = 0; i < count; ++i) {
+            mn = glm::min(mn, vertices[i].position);
+            mx = glm::max(mx, vertices[i].position);
+        }
+        // Flache Achsen (Ebenen) bekommen eine kleine Ausdehnung, damit die Skalierung der Instanz nicht 0 wird
+        const glm::vec3 extent = mx - mn;
+        const float minExtent = std::max(std::max(extent.x, std::max(extent.y, extent.z)) * 1e-4f, 1e-6f);
+        offset = mn;
+        scale = glm::max(extent, glm::vec3(minExtent));
+
+        vertexBytes.resize(count * sizeof(CompactVertex));
+        positionBytes.resize(count * sizeof(uint16_t) * 4);
+        auto* out = reinterpret_cast<CompactVertex*>(vertexBytes.data());
+        auto* positions = reinterpret_cast<uint16_t*>(positionBytes.data());
+        for (size_t i = 0; i < count; ++i) {
+            const Vertex& v = vertices[i];
+            CompactVertex& c = out[i];
+            for (int k = 0; k < 3; ++k) {
+                const float t = std::clamp((v.position[k] - offset[k]) / scale[k], 0.0f, 1.0f);
+                c.position[k] = static_cast<uint16_t>(std::lround(t * 65535.0f));
+                positions[i * 4 + k] = c.position[k];
+            }
+            c.position[3] = positions[i * 4 + 3] = 0;
+            // Die Instanz enthält die Skalierung S der Dequantisierung; der Shader teilt die Normale durch
+            // die Skalierung -> hier S * n ablegen, die Richtung stimmt danach wieder
+            const glm::vec3 scaled = v.normal * scale;
+            const float length = glm::length(scaled);
+            const glm::vec2 oct = OctEncode(length > 0.0f ? scaled * (1.0f / length) : glm::vec3(0.0f, 0.0f, 1.0f));
+            c.normal[0] = ToSnorm16(oct.x);
+            c.normal[1] = ToSnorm16(oct.y);
+            c.texCoords[0] = FloatToHalf(v.texCoords.x);
+            c.texCoords[1] = FloatToHalf(v.texCoords.y);
+        }
+    }
+}
+
+// ==================== InstanceData ====================
+
+InstanceData InstanceData::Make(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+                                uint32_t material) {
+    InstanceData instance;
+    instance.position = position;
+    instance.material = material;
+    instance.scale = scale;
+    const glm::quat q = glm::normalize(rotation);
+    instance.rotation[0] = ToSnorm16(q.x);
+    instance.rotation[1] = ToSnorm16(q.y);
+    instance.rotation[2] = ToSnorm16(q.z);
+    instance.rotation[3] = ToSnorm16(q.w);
+    return instance;
+}
+
+glm::quat InstanceData::Rotation() const {
+    // Wie die GL-Konvertierung normalisierter Shorts: max(v / 32767, -1)
+    auto decode = [](int16_t v) { return std::max(static_cast<float>(v) / 32767.0f, -1.0f); };
+    return glm::normalize(glm::quat(decode(rotation[3]), decode(rotation[0]), decode(rotation[1]), decode(rotation[2])));
+}
+
+// ==================== RangeAllocator ====================
+
+void RangeAllocator::Reset(uint32_t newCapacity) {
+    ResetCompacted(0, newCapacity);
+}
+
+void RangeAllocator::ResetCompacted(uint32_t used, uint32_t newCapacity) {
+    capacity = newCapacity;
+    freeBlocks.clear();
+    if (used < capacity) freeBlocks.push_back({ used, capacity - used });
+    freeCount = capacity - used;
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t count) {
+    if (count == 0) return 0;
+    for (size_t i = 0; i < freeBlocks.size(); ++i) {
+        Block& block = freeBlocks[i];
+        if (block.count < count) continue;
+        const uint32_t offset = block.offset;
+        block.offset += count;
+        block.count -= count;
+        if (block.count == 0) freeBlocks.erase(freeBlocks.begin() + i);
+        freeCount -= count;
+        return offset;
+    }
+    return Invalid;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t count) {
+    if (count == 0) return;
+    auto it = std::lower_bound(freeBlocks.begin(), freeBlocks.end(), offset,
+                               [](const Block& b, uint32_t o) { return b.offset < o; });
+    it = freeBlocks.insert(it, { offset, count });
+    freeCount += count;
+
+    // Mit Nachfolger und Vorgänger verschmelzen
+    auto next = it + 1;
+    if (next != freeBlocks.end() && it->offset + it->count == next->offset) {
+        it->count += next->count;
+        freeBlocks.erase(next);
+    }
+    if (it != freeBlocks.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->count == it->offset) {
+            prev->count += it->count;
+            freeBlocks.erase(it);
+        }
+    }
+}
+
+void RangeAllocator::Grow(uint32_t newCapacity) {
+    if (newCapacity <= capacity) return;
+    const uint32_t added = newCapacity - capacity;
+    if (!freeBlocks.empty() && freeBlocks.back().offset + freeBlocks.back().count == capacity) {
+        freeBlocks.back().count += added;
+    } else {
+        freeBlocks.push_back({ capacity, added });
+    }
+    freeCount += added;
+    capacity = newCapacity;
+}
+
+uint32_t RangeAllocator::LargestFreeBlock() const {
+    uint32_t largest = 0;
+    for (const Block& b : freeBlocks) largest = std::max(largest, b.count);
+    return largest;
+}
+
+// ==================== GeometryArena ====================
+
+size_t GeometryArena::bindCount = 0;
+
+InstanceData GeometryArena::Range::Dequantize(const InstanceData& instance) const {
+    InstanceData result = instance;
+    result.position += instance.Rotation() * (instance.scale * positionOffset);
+    result.scale = instance.scale * positionScale;
+    return result;
+}
+
+GeometryArena& GeometryArena::Instance() {
+    // Bewusst nie zerstört: Meshes in statischen Caches (ResourceManager) geben ihre Bereiche
+    // noch bei der Programmende-Zerstörung frei
+    static GeometryArena* instance = new GeometryArena();
+    return *instance;
+}
+
+GeometryArena::Pool& GeometryArena::GetPool(VertexFormat format) {
+    Pool& pool = pools[static_cast<size_t>(format)];
+    if (pool.vao) return pool;
+
+    pool.stride = static_cast<uint32_t>(GetVertexSize(format));
+    pool.positionStride = static_cast<uint32_t>(GetPositionSize(format));
+    pool.indexSize = static_cast<uint32_t>(GetIndexSize(format));
+    glGenVertexArrays(1, &pool.vao);
+    glGenVertexArrays(1, &pool.positionVao);
+    glGenBuffers(1, &pool.vbo);
+    glGenBuffers(1, &pool.positionVbo);
+    glGenBuffers(1, &pool.ebo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(InitialVertexCapacity) * pool.stride, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.positionVbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(InitialVertexCapacity) * pool.positionStride, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(InitialIndexCapacity) * pool.indexSize, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    pool.vertices.Reset(InitialVertexCapacity);
+    pool.indices.Reset(InitialIndexCapacity);
+    SetupVertexArray(pool, format);
+    return pool;
+}
+
+unsigned int GeometryArena::GetIndexType(VertexFormat format) {
+    return HasShortIndices(format) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+size_t GeometryArena::GetVertexSize(VertexFormat format) {
+    return IsCompactFormat(format) ? sizeof(CompactVertex) : sizeof(Vertex);
+}
+
+size_t GeometryArena::GetPositionSize(VertexFormat format) {
+    return IsCompactFormat(format) ? sizeof(uint16_t) * 4 : sizeof(glm::vec3);
+}
+
+void GeometryArena::SetupVertexArray(Pool& pool, VertexFormat format) {
+    const bool compact = IsCompactFormat(format);
+    glBindVertexArray(pool.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.ebo);
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    if (compact) {
+        // Normalisierte Integer: der Shader sieht Positionen in [0,1] und die Oktaeder-Normale in [-1,1]
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, position));
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, normal));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, texCoords));
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+    }
+
+    // Position, Rotation, Skalierung (3-5) plus Material-Index (7); der Buffer wird erst beim Zeichnen gesetzt (Ring-Buffer)
+    auto enableInstanceAttributes = []() {
+        for (int location : { 3, 4, 5, 7 }) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+    };
+    enableInstanceAttributes();
+
+    // Positions-Stream: gleicher Index-Buffer, nur Location 0
+    glBindVertexArray(pool.positionVao);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.positionVbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.ebo);
+    glEnableVertexAttribArray(0);
+    if (compact) {
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, pool.positionStride, (void*)0);
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, pool.positionStride, (void*)0);
+    }
+    enableInstanceAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::Compact(std::initializer_list<CompactTarget> targets, RangeAllocator& allocator, uint32_t newCapacity,
+                            VertexFormat format, uint32_t Range::*offset, uint32_t Range::*count) {
+    // Lebende Bereiche in Offset-Reihenfolge hintereinander kopieren
+    std::vector<uint32_t> order;
+    for (uint32_t h = 0; h < ranges.size(); ++h) {
+        if (ranges[h].alive && ranges[h].format == format && ranges[h].*count > 0) order.push_back(h);
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return ranges[a].*offset < ranges[b].*offset; });
+
+    for (const CompactTarget& target : targets) {
+        const size_t elementSize = target.elementSize;
+        unsigned int newBuffer = 0;
+        glGenBuffers(1, &newBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity) * elementSize, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, *target.buffer);
+        uint32_t cursor = 0;
+        for (uint32_t h : order) {
+            const Range& r = ranges[h];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(r.*offset) * elementSize,
+                                static_cast<GLintptr>(cursor) * elementSize, static_cast<GLsizeiptr>(r.*count) * elementSize);
+            cursor += r.*count;
+        }
+        glDeleteBuffers(1, target.buffer);
+        *target.buffer = newBuffer;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    // Offsets erst nach allen Buffern umschreiben, die Kopien lesen die alten
+    uint32_t cursor = 0;
+    for (uint32_t h : order) {
+        ranges[h].*offset = cursor;
+        cursor += ranges[h].*count;
+    }
+    allocator.ResetCompacted(cursor, newCapacity);
+}
+
+GeometryArena::EncodedMesh GeometryArena::Encode(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData,
+                                                 size_t indexCount, bool compact) {
+    // Indizes sind mesh-lokal (BaseVertex) -> 16 Bit reichen bis 65536 Vertices
+    const bool shortIndices = vertexCount <= 65536;
+    EncodedMesh mesh;
+    mesh.format = compact ? (shortIndices ? VertexFormat::Compact16 : VertexFormat::Compact)
+                          : (shortIndices ? VertexFormat::Standard16 : VertexFormat::Standard);
+    mesh.vertexCount = static_cast<uint32_t>(vertexCount);
+    mesh.indexCount = static_cast<uint32_t>(indexCount);
+    EncodeVertices(mesh.format, vertexData, vertexCount, mesh.vertices, mesh.positions, mesh.positionOffset, mesh.positionScale);
+    mesh.indices.resize(indexCount * GetIndexSize(mesh.format));
+    if (shortIndices) {
+        auto* out = reinterpret_cast<uint16_t*>(mesh.indices.data());
+        for (size_t i = 0; i < indexCount; ++i) out[i] = static_cast<uint16_t>(indexData[i]);
+    } else if (indexCount > 0) {
+        std::memcpy(mesh.indices.data(), indexData, indexCount * sizeof(uint32_t));
+    }
+    return mesh;
+}
+
+uint32_t GeometryArena::Allocate(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount,
+                                 bool compact) {
+    return Allocate(Encode(vertexData, vertexCount, indexData, indexCount, compact).View());
+}
+
+uint32_t GeometryArena::Allocate(const EncodedGeometry& geometry) {
+    const VertexFormat format = geometry.format;
+    Pool& pool = GetPool(format);
+    const uint32_t vc = geometry.vertexCount;
+    const uint32_t ic = geometry.indexCount;
+    const size_t vertexBytes = static_cast<size_t>(vc) * pool.stride;
+    const size_t positionBytes = static_cast<size_t>(vc) * pool.positionStride;
+    const size_t indexBytes = static_cast<size_t>(ic) * pool.indexSize;
+
+    // Identische Geometrie (z.B. jede Cube-Instanz) nur einmal ablegen
+    ContentHash content;
+    content.Add(geometry.vertices, vertexBytes);
+    content.Add(geometry.indices, indexBytes);
+    const uint64_t hash = ContentHash::Finalize(content.low);
+    const uint64_t check = ContentHash::Finalize(content.high);
+    auto [first, last] = contentIndex.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        Range& existing = ranges[it->second];
+        if (existing.format == format && existing.vertexCount == vc && existing.indexCount == ic &&
+            existing.positionOffset == geometry.positionOffset && existing.positionScale == geometry.positionScale &&
+            existing.contentCheck == check) {
+            ++existing.refCount;
+            return it->second;
+        }
+    }
+
+    uint32_t baseVertex = pool.vertices.Allocate(vc);
+    if (baseVertex == RangeAllocator::Invalid) {
+        // Kompaktieren und dabei mindestens verdoppeln
+        const uint32_t capacity = std::max(pool.vertices.Capacity() * 2, pool.vertices.Capacity() - pool.vertices.FreeCount() + vc);
+        Compact({ { &pool.vbo, pool.stride }, { &pool.positionVbo, pool.positionStride } }, pool.vertices, capacity, format,
+                &Range::baseVertex, &Range::vertexCount);
+        SetupVertexArray(pool, format);
+        baseVertex = pool.vertices.Allocate(vc);
+    }
+    uint32_t firstIndex = pool.indices.Allocate(ic);
+    if (firstIndex == RangeAllocator::Invalid) {
+        const uint32_t capacity = std::max(pool.indices.Capacity() * 2, pool.indices.Capacity() - pool.indices.FreeCount() + ic);
+        Compact({ { &pool.ebo, pool.indexSize } }, pool.indices, capacity, format, &Range::firstIndex, &Range::indexCount);
+        SetupVertexArray(pool, format);
+        firstIndex = pool.indices.Allocate(ic);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(baseVertex) * pool.stride,
+                    static_cast<GLsizeiptr>(vertexBytes), geometry.vertices);
+    // Positions-Stream für Tiefen-Passes
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.positionVbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(baseVertex) * pool.positionStride,
+                    static_cast<GLsizeiptr>(positionBytes), geometry.positions);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(firstIndex) * pool.indexSize,
+                    static_cast<GLsizeiptr>(indexBytes), geometry.indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    uint32_t handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<uint32_t>(ranges.size());
+        ranges.emplace_back();
+    }
+    Range& r = ranges[handle];
+    r.baseVertex = baseVertex;
+    r.vertexCount = vc;
+    r.firstIndex = firstIndex;
+    r.indexCount = ic;
+    r.format = format;
+    r.alive = true;
+    r.refCount = 1;
+    r.contentHash = hash;
+    r.contentCheck = check;
+    r.positionOffset = geometry.positionOffset;
+    r.positionScale = geometry.positionScale;
+    contentIndex.emplace(hash, handle);
+    return handle;
+}
+
+void GeometryArena::Free(uint32_t handle) {
+    if (handle >= ranges.size() || !ranges[handle].alive) return;
+    Range& r = ranges[handle];
+    if (--r.refCount > 0) return;
+    auto [first, last] = contentIndex.equal_range(r.contentHash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == handle) {
+            contentIndex.erase(it);
+            break;
+        }
+    }
+    Pool& pool = pools[static_cast<size_t>(r.format)];
+    pool.vertices.Free(r.baseVertex, r.vertexCount);
+    pool.indices.Free(r.firstIndex, r.indexCount);
+    r.alive = false;
+    freeHandles.push_back(handle);
+}
+
+size_t GeometryArena::GetRangeBytes(uint32_t handle) const {
+    const Range& r = ranges[handle];
+    return static_cast<size_t>(r.vertexCount) * (GetVertexSize(r.format) + GetPositionSize(r.format)) +
+           static_cast<size_t>(r.indexCount) * GetIndexSize(r.format);
+}
+
+void GeometryArena::BindVertexFormat(VertexFormat format) {
+    glBindVertexArray(GetPool(format).vao);
+    ++bindCount;
+}
+
+void GeometryArena::BindPositionStream(VertexFormat format) {
+    glBindVertexArray(GetPool(format).positionVao);
+    ++bindCount;
+}
+
+void GeometryArena::SetInstanceBuffer(unsigned int buffer, size_t byteOffset) {
+    // Offset ändert sich pro Frame bzw. Batch -> nur die Attribut-Pointer, kein VAO-Wechsel
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(byteOffset + offsetof(InstanceData, position)));
+    glVertexAttribPointer(4, 4, GL_SHORT, GL_TRUE, sizeof(InstanceData), (void*)(byteOffset + offsetof(InstanceData, rotation)));
+    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(byteOffset + offsetof(InstanceData, scale)));
+    glVertexAttribIPointer(7, 1, GL_UNSIGNED_INT, sizeof(InstanceData), (void*)(byteOffset + offsetof(InstanceData, material)));
+}
+
+void GeometryArena::Maintain() {
+    // Nur wenn viel frei ist und der größte Block weniger als die Hälfte davon ausmacht
+    auto fragmented = [](const RangeAllocator& a) {
+        return a.FreeCount() > a.Capacity() / 4 && a.LargestFreeBlock() < a.FreeCount() / 2;
+    };
+    for (size_t f = 0; f < static_cast<size_t>(VertexFormat::Count); ++f) {
+        const Pool& pool = pools[f];
+        if (pool.vao && (fragmented(pool.vertices) || fragmented(pool.indices))) {
+            Defragment(static_cast<VertexFormat>(f));
+        }
+    }
+}
+
+void GeometryArena::Defragment(VertexFormat format) {
+    Pool& pool = GetPool(format);
+    Compact({ { &pool.vbo, pool.stride }, { &pool.positionVbo, pool.positionStride } }, pool.vertices,
+            pool.vertices.Capacity(), format, &Range::baseVertex, &Range::vertexCount);
+    Compact({ { &pool.ebo, pool.indexSize } }, pool.indices, pool.indices.Capacity(), format,
+            &Range::firstIndex, &Range::indexCount);
+    SetupVertexArray(pool, format);
+}
+
+size_t GeometryArena::GetVertexBytes() const {
+    size_t bytes = 0;
+    for (const Pool& pool : pools) {
+        bytes += static_cast<size_t>(pool.vertices.Capacity()) * (pool.stride + pool.positionStride);
+    }
+    return bytes;
+}
+
+size_t GeometryArena::GetIndexBytes() const {
+    size_t bytes = 0;
+    for (const Pool& pool : pools) bytes += static_cast<size_t>(pool.indices.Capacity()) * pool.indexSize;
+    return bytes;
+}
+
+size_t GeometryArena::ConsumeBindCount() {
+    size_t count = bindCount;
+    bindCount = 0;
+    return count;
+}
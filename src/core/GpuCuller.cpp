@@ -0,0 +1,158 @@
+#include "glad/glad.h"
+#include "../../include/core/GpuCuller.hpp"
+#include "../../include/core/Shader.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    constexpr UniformId FrustumPlanes[6] = {
+        UniformId("frustumPlanes[0]"), UniformId("frustumPlanes[1]"), UniformId("frustumPlanes[2]"),
+        UniformId("frustumPlanes[3]"), UniformId("frustumPlanes[4]"), UniformId("frustumPlanes[5]"),
+    };
+    constexpr UniformId InstanceCount("instanceCount");
+    constexpr unsigned int WorkGroupSize = 64;     // local_size_x in GpuCull.comp
+}
+
+GpuCuller::GpuCuller() = default;
+
+GpuCuller::~GpuCuller() {
+    Shutdown();
+}
+
+const char* GpuCuller::ModeName(Mode mode) {
+    switch (mode) {
+        case Mode::Compute: return "Compute";
+        case Mode::TransformFeedback: return "Transform Feedback";
+        default: return "None";
+    }
+}
+
+void GpuCuller::Init(bool preferCompute) {
+    Shutdown();
+    glGenBuffers(1, &inputBuffer);
+    glGenBuffers(1, &boundsBuffer);
+    glGenBuffers(1, &outputBuffer);
+
+    // Compute schreibt die Anzahl direkt ins Indirect-Kommando, braucht also auch Multi-Draw-Indirect
+    const GLCapabilities& caps = GLCapabilities::Get();
+    if (preferCompute && caps.computeShader && caps.multiDrawIndirect) {
+        program = std::make_unique<Shader>("shaders/GpuCull.comp");
+        mode = Mode::Compute;
+    } else {
+        program = std::make_unique<Shader>("shaders/GpuCull.vert", "shaders/GpuCull.geom",
+            std::vector<const char*>{ "outPosition", "outMaterial", "outScale", "outRotation" });
+        glGenVertexArrays(1, &feedbackVao);
+        SetupFeedbackInput();
+        mode = Mode::TransformFeedback;
+    }
+    std::cout << "[GpuCuller] " << ModeName(mode) << " path" << std::endl;
+}
+
+void GpuCuller::Shutdown() {
+    if (!queries.empty()) glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    queries.clear();
+    visibleCounts.clear();
+    pendingQueries = 0;
+    if (feedbackVao) glDeleteVertexArrays(1, &feedbackVao);
+    if (inputBuffer) glDeleteBuffers(1, &inputBuffer);
+    if (boundsBuffer) glDeleteBuffers(1, &boundsBuffer);
+    if (outputBuffer) glDeleteBuffers(1, &outputBuffer);
+    feedbackVao = inputBuffer = boundsBuffer = outputBuffer = 0;
+    program.reset();
+    outputCapacity = count = 0;
+    mode = Mode::None;
+}
+
+void GpuCuller::SetupFeedbackInput() {
+    // Gleiche Attribut-Belegung wie GpuCull.vert: Position 0, Material 1, Skalierung 2, Rotation 3 (normalisiert)
+    // und 4 (roh, für die bitgenaue Ausgabe), AABB 5-6
+    glBindVertexArray(feedbackVao);
+    glBindBuffer(GL_ARRAY_BUFFER, inputBuffer);
+    for (int i = 0; i < 5; ++i) glEnableVertexAttribArray(i);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, position));
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(InstanceData), (void*)offsetof(InstanceData, material));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, scale));
+    glVertexAttribPointer(3, 4, GL_SHORT, GL_TRUE, sizeof(InstanceData), (void*)offsetof(InstanceData, rotation));
+    glVertexAttribIPointer(4, 2, GL_UNSIGNED_INT, sizeof(InstanceData), (void*)offsetof(InstanceData, rotation));
+    glBindBuffer(GL_ARRAY_BUFFER, boundsBuffer);
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(CullBounds), (void*)offsetof(CullBounds, center));
+    glEnableVertexAttribArray(6);
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(CullBounds), (void*)offsetof(CullBounds, extents));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GpuCuller::Upload(const InstanceData* instances, const CullBounds* bounds, size_t n) {
+    if (mode == Mode::None) return;
+    count = n;
+    // Jeden Frame komplett neu (Orphaning), die Ausgabe wächst nur
+    glBindBuffer(GL_ARRAY_BUFFER, inputBuffer);
+    glBufferData(GL_ARRAY_BUFFER, n * sizeof(InstanceData), instances, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, boundsBuffer);
+    glBufferData(GL_ARRAY_BUFFER, n * sizeof(CullBounds), bounds, GL_STREAM_DRAW);
+    if (n > outputCapacity) {
+        outputCapacity = std::max(n, outputCapacity * 2);
+        glBindBuffer(GL_ARRAY_BUFFER, outputBuffer);
+        glBufferData(GL_ARRAY_BUFFER, outputCapacity * sizeof(InstanceData), nullptr, GL_DYNAMIC_COPY);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GpuCuller::Cull(const Frustum& frustum, const std::vector<RenderQueue::Batch>& batches, unsigned int indirectBuffer) {
+    if (mode == Mode::None || count == 0 || batches.empty()) return;
+    program->Use();
+    for (int i = 0; i < 6; ++i) program->Set(FrustumPlanes[i], frustum.planes[i]);
+
+    if (mode == Mode::Compute) {
+        program->Set(InstanceCount, static_cast<int>(count));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, inputBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, boundsBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, outputBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, indirectBuffer);
+        glDispatchCompute(static_cast<GLuint>((count + WorkGroupSize - 1) / WorkGroupSize), 1, 1);
+        // Draw liest danach instanceCount (Indirect) und die Instanzdaten (Vertex-Attribute)
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+        for (GLuint binding = 0; binding < 4; ++binding) glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+        return;
+    }
+
+    if (queries.size() < batches.size()) {
+        const size_t old = queries.size();
+        queries.resize(batches.size());
+        glGenQueries(static_cast<GLsizei>(batches.size() - old), queries.data() + old);
+    }
+
+    // Pro Batch ein Punkt-Draw über seine Instanzen, Ausgabe ab batch.first -> baseInstance bleibt gültig
+    glBindVertexArray(feedbackVao);
+    glEnable(GL_RASTERIZER_DISCARD);
+    for (size_t i = 0; i < batches.size(); ++i) {
+        const RenderQueue::Batch& batch = batches[i];
+        glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0, outputBuffer, batch.first * sizeof(InstanceData),
+                          batch.count * sizeof(InstanceData));
+        glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, queries[i]);
+        glBeginTransformFeedback(GL_POINTS);
+        glDrawArrays(GL_POINTS, static_cast<GLint>(batch.first), static_cast<GLsizei>(batch.count));
+        glEndTransformFeedback();
+        glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+    }
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    // Kein Zurücklesen hier: die GPU arbeitet die Passes am Stück ab, ReadVisibleCounts() holt die Anzahl bei Bedarf
+    pendingQueries = batches.size();
+}
+
+const std::vector<uint32_t>& GpuCuller::ReadVisibleCounts() {
+    if (pendingQueries > 0) {
+        visibleCounts.assign(pendingQueries, 0);
+        for (size_t i = 0; i < pendingQueries; ++i) {
+            GLuint written = 0;
+            glGetQueryObjectuiv(queries[i], GL_QUERY_RESULT, &written);
+            visibleCounts[i] = written;
+        }
+        pendingQueries = 0;
+    }
+    return visibleCounts;
+}
@@ -0,0 +1,80 @@
+#include "glad/glad.h"
+#include "../../include/core/GpuTimer.hpp"
+
+GpuTimer::~GpuTimer() {
+    Shutdown();
+}
+
+void GpuTimer::Init() {
+    Shutdown();
+    initialized = true;
+}
+
+void GpuTimer::Shutdown() {
+    for (Frame& frame : frames) {
+        for (Query& q : frame.queries) {
+            if (q.id) glDeleteQueries(1, &q.id);
+            if (q.samplesId) glDeleteQueries(1, &q.samplesId);
+        }
+        frame.queries.clear();
+        frame.used = 0;
+    }
+    results.clear();
+    active = false;
+    initialized = false;
+}
+
+void GpuTimer::BeginFrame() {
+    if (!initialized) return;
+    if (active) End();
+    current = (current + 1) % Latency;
+    Frame& frame = frames[current];
+
+    // Noch nicht fertige Queries verwerfen statt zu warten
+    results.clear();
+    for (size_t i = 0; i < frame.used; ++i) {
+        const Query& q = frame.queries[i];
+        GLint available = 0;
+        glGetQueryObjectiv(q.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(q.id, GL_QUERY_RESULT, &elapsed);
+        long long samples = -1;
+        if (q.countSamples) {
+            // Beide Queries enden am selben Punkt; ist die Zeit da, ist es der Zähler auch
+            GLuint64 passed = 0;
+            glGetQueryObjectui64v(q.samplesId, GL_QUERY_RESULT, &passed);
+            samples = static_cast<long long>(passed);
+        }
+        results.push_back({ q.name, elapsed / 1000000.0, samples });
+    }
+    frame.used = 0;
+}
+
+void GpuTimer::Begin(const char* pass, bool countSamples) {
+    if (!initialized || active) return;
+    Frame& frame = frames[current];
+    if (frame.used == frame.queries.size()) {
+        Query q;
+        glGenQueries(1, &q.id);
+        frame.queries.push_back(q);
+    }
+    Query& q = frame.queries[frame.used++];
+    q.name = pass;
+    q.countSamples = countSamples;
+    glBeginQuery(GL_TIME_ELAPSED, q.id);
+    if (countSamples) {
+        if (!q.samplesId) glGenQueries(1, &q.samplesId);
+        glBeginQuery(GL_SAMPLES_PASSED, q.samplesId);
+    }
+    active = true;
+    activeSamples = countSamples;
+}
+
+void GpuTimer::End() {
+    if (!active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    if (activeSamples) glEndQuery(GL_SAMPLES_PASSED);
+    active = false;
+    activeSamples = false;
+}
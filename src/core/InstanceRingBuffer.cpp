@@ -0,0 +1,154 @@
+#include "glad/glad.h"
+#include "../../include/core/InstanceRingBuffer.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include <chrono>
+#include <iostream>
+
+InstanceRingBuffer::~InstanceRingBuffer() {
+    Shutdown();
+}
+
+void InstanceRingBuffer::Init(size_t bytesPerFrame) {
+    persistent = GLCapabilities::Get().bufferStorage;
+    Allocate(bytesPerFrame);
+    std::cout << "[InstanceRingBuffer] " << (persistent ? "persistent mapped" : "glMapBufferRange")
+              << ", " << FramesInFlight << " x " << regionSize / 1024 << " KB" << std::endl;
+}
+
+void InstanceRingBuffer::Shutdown() {
+    Release();
+    if (fallbackBuffer) glDeleteBuffers(1, &fallbackBuffer);
+    fallbackBuffer = 0;
+}
+
+void InstanceRingBuffer::Allocate(size_t bytesPerFrame) {
+    // Regionen auf 256 Byte ausrichten, damit Offsets für alle Attributformate passen
+    regionSize = (bytesPerFrame + 255) & ~static_cast<size_t>(255);
+    const size_t total = regionSize * FramesInFlight;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags);
+        persistentPtr = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags));
+        if (!persistentPtr) {
+            // Treiber verweigert persistentes Mapping -> auf klassischen Pfad zurückfallen
+            std::cout << "[InstanceRingBuffer] persistent mapping failed, falling back" << std::endl;
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+            persistent = false;
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW);
+        }
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    region = 0;
+    cursor = 0;
+}
+
+void InstanceRingBuffer::Release() {
+    for (GLsync& fence : fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (buffer) {
+        if (persistentPtr) {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    persistentPtr = nullptr;
+    regionSize = 0;
+}
+
+void InstanceRingBuffer::WaitForFence(int index) {
+    GLsync& fence = fences[index];
+    if (!fence) return;
+
+    // Erst ohne Timeout prüfen: im Normalfall ist die Region längst frei
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        ++fenceWaits;
+        auto start = std::chrono::high_resolution_clock::now();
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        } while (status == GL_TIMEOUT_EXPIRED);
+        fenceWaitMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void InstanceRingBuffer::BeginFrame() {
+    fenceWaits = 0;
+    fenceWaitMs = 0.0;
+    fallbacks = 0;
+    cursor = 0;
+    WaitForFence(region);
+}
+
+void InstanceRingBuffer::EndFrame() {
+    if (cursor > 0) {
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    region = (region + 1) % FramesInFlight;
+}
+
+void InstanceRingBuffer::Reserve(size_t bytes) {
+    const size_t needed = ((cursor + 15) & ~static_cast<size_t>(15)) + bytes;
+    if (needed <= regionSize) return;
+
+    // Buffer muss wachsen: alle Regionen abwarten, dann neu anlegen.
+    // Bereits in diesem Frame geschriebene Daten gehen verloren, daher vor dem ersten Map() aufrufen.
+    for (int i = 0; i < FramesInFlight; ++i) WaitForFence(i);
+    size_t newSize = regionSize + regionSize / 2;
+    if (newSize < needed) newSize = needed;
+    Release();
+    Allocate(newSize);
+}
+
+void* InstanceRingBuffer::Map(size_t bytes, size_t& outOffset) {
+    size_t aligned = (cursor + 15) & ~static_cast<size_t>(15);
+    if (bytes == 0 || aligned + bytes > regionSize) return nullptr;
+
+    outOffset = region * regionSize + aligned;
+    cursor = aligned + bytes;
+
+    if (persistent) return persistentPtr + outOffset;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    void* ptr = glMapBufferRange(GL_ARRAY_BUFFER, outOffset, bytes,
+                                 GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    mapped = ptr != nullptr;
+    if (!mapped) glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return ptr;
+}
+
+void InstanceRingBuffer::Unmap() {
+    if (persistent || !mapped) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    mapped = false;
+}
+
+unsigned int InstanceRingBuffer::UploadFallback(const void* data, size_t bytes) {
+    if (!fallbackLogged) {
+        std::cout << "[InstanceRingBuffer] Map failed, uploading instances via glBufferSubData" << std::endl;
+        fallbackLogged = true;
+    }
+    ++fallbacks;
+    if (!fallbackBuffer) glGenBuffers(1, &fallbackBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, fallbackBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return fallbackBuffer;
+}
@@ -0,0 +1,362 @@
+#include "../../include/core/JobSystem.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct Job {
+    std::function<void()> task;
+    JobCounter* counter = nullptr;
+    bool background = false;
+};
+
+namespace {
+    // Index der Deque des aktuellen Threads, -1 = fremder Thread
+    thread_local int tlsWorkerIndex = -1;
+    thread_local uint32_t tlsRandom = 0x9E3779B9u;
+    // Läuft gerade ein Hintergrund-Job? Was er einplant, bleibt ebenfalls Hintergrundarbeit
+    thread_local bool tlsBackgroundJob = false;
+
+    uint32_t NextRandom() {
+        // xorshift32 für die Opferwahl beim Stehlen
+        uint32_t x = tlsRandom;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        tlsRandom = x;
+        return x;
+    }
+}
+
+// ==================== JobDeque ====================
+
+bool JobDeque::Push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= Capacity) return false;
+    buffer[b & Mask].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Job* JobDeque::Pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+        // leer
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = buffer[b & Mask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // letztes Element: gegen Diebe um top konkurrieren
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobDeque::Steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+    Job* job = buffer[t & Mask].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr; // anderer Thread war schneller
+    }
+    return job;
+}
+
+// ==================== JobSystem ====================
+
+JobSystem& JobSystem::Instance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Initialize(unsigned workerThreads) {
+    if (initialized) return;
+
+    if (const char* env = std::getenv("ARK_WORKER_THREADS")) {
+        workerThreads = static_cast<unsigned>(std::max(0, std::atoi(env)));
+    } else if (workerThreads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerThreads = hw > 1 ? hw - 1 : 0;
+    }
+
+    quit = false;
+    deques.clear();
+    for (unsigned i = 0; i < workerThreads + 1; ++i) {
+        deques.push_back(std::make_unique<JobDeque>());
+    }
+
+    tlsWorkerIndex = 0;
+    SetCurrentThreadName("ArkMain");
+    for (unsigned i = 1; i <= workerThreads; ++i) {
+        workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+    if (workerThreads == 0) backgroundThread = std::thread([this] { BackgroundLoop(); });
+    initialized = true;
+    std::cout << "[JobSystem] " << workerThreads << " worker threads" << std::endl;
+}
+
+void JobSystem::Shutdown() {
+    if (!initialized) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+    if (backgroundThread.joinable()) backgroundThread.join();
+
+    // Nicht gestartete Jobs verwerfen
+    for (auto& d : deques) {
+        while (Job* job = d->Steal()) delete job;
+    }
+    for (Job* job : injectionQueue) delete job;
+    injectionQueue.clear();
+    for (Job* job : backgroundQueue) delete job;
+    backgroundQueue.clear();
+    backgroundJobs = 0;
+    deques.clear();
+    queuedJobs = 0;
+    tlsWorkerIndex = -1;
+    initialized = false;
+}
+
+void JobSystem::SetCurrentThreadName(const char* name) {
+#ifdef _WIN32
+    std::wstring wide(name, name + std::strlen(name));
+    SetThreadDescription(GetCurrentThread(), wide.c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name);
+#else
+    char shortName[16] = {}; // Linux erlaubt max. 15 Zeichen
+    std::snprintf(shortName, sizeof(shortName), "%s", name);
+    pthread_setname_np(pthread_self(), shortName);
+#endif
+}
+
+void JobSystem::WorkerLoop(unsigned index) {
+    tlsWorkerIndex = static_cast<int>(index);
+    tlsRandom = 0x9E3779B9u * (index + 1);
+    SetCurrentThreadName(("ArkWorker " + std::to_string(index)).c_str());
+
+    while (!quit.load(std::memory_order_acquire)) {
+        if (Job* job = FindJob(index)) {
+            Execute(job);
+            continue;
+        }
+        // Hintergrund-Jobs erst, wenn sonst nichts zu tun ist
+        if (Job* job = FindBackgroundJob()) {
+            Execute(job);
+            continue;
+        }
+        // Kurz weitersuchen, bevor der Thread schlafen geht
+        bool found = false;
+        for (int spin = 0; spin < 64 && !found; ++spin) {
+            if (queuedJobs.load(std::memory_order_acquire) > 0) found = true;
+            else std::this_thread::yield();
+        }
+        if (found) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        ++sleepingWorkers;
+        wakeCondition.wait(lock, [this] {
+            return quit.load() || queuedJobs.load() > 0 || backgroundJobs.load() > 0;
+        });
+        --sleepingWorkers;
+    }
+}
+
+void JobSystem::BackgroundLoop() {
+    // Fremder Thread: Run() von hier landet in der Injection-Queue, ParallelFor läuft synchron
+    SetCurrentThreadName("ArkBackground");
+    while (!quit.load(std::memory_order_acquire)) {
+        if (Job* job = FindBackgroundJob()) {
+            Execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        ++sleepingWorkers;
+        wakeCondition.wait(lock, [this] { return quit.load() || backgroundJobs.load() > 0; });
+        --sleepingWorkers;
+    }
+}
+
+Job* JobSystem::FindJob(unsigned self) {
+    Job* job = nullptr;
+    if (self < deques.size()) job = deques[self]->Pop();
+
+    // Stehlen: bei zufälligem Opfer beginnen, alle anderen Deques einmal durchgehen
+    const unsigned count = static_cast<unsigned>(deques.size());
+    if (!job && count > 1) {
+        unsigned start = NextRandom() % count;
+        for (unsigned i = 0; i < count && !job; ++i) {
+            unsigned victim = (start + i) % count;
+            if (victim == self) continue;
+            job = deques[victim]->Steal();
+        }
+    }
+    if (!job) {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        if (!injectionQueue.empty()) {
+            job = injectionQueue.front();
+            injectionQueue.pop_front();
+        }
+    }
+    if (job) queuedJobs.fetch_sub(1);
+    return job;
+}
+
+Job* JobSystem::FindBackgroundJob() {
+    if (backgroundJobs.load(std::memory_order_acquire) == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(backgroundMutex);
+    if (backgroundQueue.empty()) return nullptr;
+    Job* job = backgroundQueue.front();
+    backgroundQueue.pop_front();
+    backgroundJobs.fetch_sub(1);
+    return job;
+}
+
+void JobSystem::Schedule(Job* job) {
+    if (job->background) {
+        // Nicht in die Deques: Wait() im Main-Thread könnte sie sonst stehlen
+        {
+            std::lock_guard<std::mutex> lock(backgroundMutex);
+            backgroundQueue.push_back(job);
+        }
+        // seq_cst wie unten; Wecken unter sleepMutex, damit der Hintergrund-Thread es nicht verpasst
+        backgroundJobs.fetch_add(1);
+        if (sleepingWorkers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wakeCondition.notify_one();
+        }
+        return;
+    }
+    // seq_cst: passt zum Inkrement von sleepingWorkers im WorkerLoop (kein verlorenes Wecken)
+    queuedJobs.fetch_add(1);
+    const int index = tlsWorkerIndex;
+    if (index < 0 || index >= static_cast<int>(deques.size()) || !deques[index]->Push(job)) {
+        // Fremder Thread oder volle Deque
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injectionQueue.push_back(job);
+    }
+    if (sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+void JobSystem::Execute(Job* job) {
+    const bool outer = tlsBackgroundJob;
+    tlsBackgroundJob = job->background;
+    job->task();
+    tlsBackgroundJob = outer;
+    JobCounter* counter = job->counter;
+    delete job;
+    if (counter) Finish(counter);
+}
+
+void JobSystem::Finish(JobCounter* counter) {
+    // Dekrement unter dem Lock: Wait() synchronisiert sich über denselben Mutex, bevor der
+    // (oft auf dem Stack liegende) Counter zerstört werden darf
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        // Counter ist auf 0 gefallen -> wartende Continuations einplanen
+        ready.swap(counter->continuations);
+    }
+    for (Job* job : ready) Instance().Schedule(job);
+}
+
+void JobSystem::Run(std::function<void()> task, JobCounter* counter, JobCounter* dependency) {
+    if (!initialized) {
+        // Ohne Initialize (z.B. Tools) synchron ausführen
+        task();
+        return;
+    }
+    Job* job = new Job{ std::move(task), counter, tlsBackgroundJob };
+    if (counter) counter->pending.fetch_add(1, std::memory_order_acq_rel);
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (dependency->pending.load(std::memory_order_acquire) > 0) {
+            dependency->continuations.push_back(job);
+            return;
+        }
+    }
+    Schedule(job);
+}
+
+void JobSystem::RunBackground(std::function<void()> task, JobCounter* counter) {
+    if (!initialized) {
+        task();
+        return;
+    }
+    Job* job = new Job{ std::move(task), counter, true };
+    if (counter) counter->pending.fetch_add(1, std::memory_order_acq_rel);
+    Schedule(job);
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    const int self = tlsWorkerIndex;
+    while (counter.Pending() > 0) {
+        Job* job = FindJob(self >= 0 ? static_cast<unsigned>(self) : static_cast<unsigned>(deques.size()));
+        // Wartet ein Hintergrund-Job (z.B. ParallelFor im Import), liegen seine Teilaufgaben in der Hintergrund-Queue
+        if (!job && tlsBackgroundJob) job = FindBackgroundJob();
+        if (job) Execute(job);
+        else std::this_thread::yield();
+    }
+    // Letztes Finish() hat den Mutex evtl. noch -> abwarten, danach darf der Counter sterben
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t)>& fn, unsigned maxParallelism) {
+    if (end <= begin) return;
+    const size_t count = end - begin;
+    grain = std::max<size_t>(grain, 1);
+
+    unsigned threads = initialized ? ThreadCount() : 1;
+    if (maxParallelism > 0) threads = std::min(threads, maxParallelism);
+    if (threads <= 1 || count <= grain) {
+        fn(begin, end);
+        return;
+    }
+
+    // Höchstens 4 Blöcke pro Thread, damit Stealing Ungleichgewichte ausgleichen kann
+    size_t blocks = std::min<size_t>((count + grain - 1) / grain, static_cast<size_t>(threads) * 4);
+    if (maxParallelism > 0) blocks = std::min<size_t>(blocks, maxParallelism);
+    const size_t blockSize = (count + blocks - 1) / blocks;
+
+    JobCounter counter;
+    // Ersten Block selbst ausführen, Rest verteilen
+    for (size_t b = begin + blockSize; b < end; b += blockSize) {
+        size_t e = std::min(end, b + blockSize);
+        Run([&fn, b, e] { fn(b, e); }, &counter);
+    }
+    fn(begin, std::min(end, begin + blockSize));
+    Wait(counter);
+}
@@ -0,0 +1,284 @@
+#include "glad/glad.h"
+#include "../../include/core/LightClusterer.hpp"
+#include "../../include/core/Shader.hpp"
+#include "../../include/core/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+    constexpr size_t LightGrain = 256;
+
+    bool SphereIntersectsBox(const glm::vec4& sphere, const glm::vec3& bmin, const glm::vec3& bmax) {
+        const glm::vec3 center(sphere);
+        const glm::vec3 closest = glm::clamp(center, bmin, bmax);
+        const glm::vec3 d = center - closest;
+        return glm::dot(d, d) <= sphere.w * sphere.w;
+    }
+
+    uint32_t ClusterIndex(uint32_t x, uint32_t y, uint32_t z) {
+        return (z * LightClusterer::GridY + y) * LightClusterer::GridX + x;
+    }
+}
+
+// ==================== TextureBuffer ====================
+
+void LightClusterer::TextureBuffer::Create(unsigned int internalFormat) {
+    glGenBuffers(1, &buffer);
+    glGenTextures(1, &texture);
+    // Leerer Buffer wäre als Texture-Buffer unvollständig -> mit einem Texel anlegen
+    capacity = 16;
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightClusterer::TextureBuffer::Destroy() {
+    if (texture) glDeleteTextures(1, &texture);
+    if (buffer) glDeleteBuffers(1, &buffer);
+    texture = buffer = 0;
+    capacity = 0;
+    shadow.clear();
+}
+
+void LightClusterer::TextureBuffer::Update(const void* data, size_t size, unsigned int internalFormat) {
+    if (!buffer || size == 0) return;
+    if (size == shadow.size() && std::memcmp(shadow.data(), data, size) == 0) return;
+    shadow.assign(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    if (size > capacity) {
+        // Großzügig wachsen, damit steigende Lichtzahlen nicht jeden Frame neu allokieren
+        capacity = std::max(size, capacity * 2);
+        glBufferData(GL_TEXTURE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+        // Neuer Datenspeicher -> Texture neu anhängen
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, buffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+// ==================== LightClusterer ====================
+
+LightClusterer::~LightClusterer() {
+    Shutdown();
+}
+
+void LightClusterer::Init() {
+    Shutdown();
+    lightBuffer.Create(GL_RGBA32F);
+    rangeBuffer.Create(GL_RG32UI);
+    indexBuffer.Create(GL_R32UI);
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    warnedOverflow = false;
+}
+
+void LightClusterer::Shutdown() {
+    lightBuffer.Destroy();
+    rangeBuffer.Destroy();
+    indexBuffer.Destroy();
+}
+
+void LightClusterer::UpdateClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane) {
+    if (projection == boundsProjection && nearPlane == boundsNear && farPlane == boundsFar) return;
+    boundsProjection = projection;
+    boundsNear = nearPlane;
+    boundsFar = farPlane;
+
+    // slice = log(d) * scale - bias  <=>  d = near * (far/near)^(slice/GridZ)
+    const float logRatio = std::log(farPlane / nearPlane);
+    sliceScale = static_cast<float>(GridZ) / logRatio;
+    sliceBias = static_cast<float>(GridZ) * std::log(nearPlane) / logRatio;
+
+    // Kachel-Ecken auf der Near-Plane; entlang des Strahls skaliert ergeben sie die Ecken jeder Scheibe
+    const glm::mat4 invProjection = glm::inverse(projection);
+    auto cornerOnNear = [&](uint32_t x, uint32_t y) {
+        const glm::vec4 ndc(-1.0f + 2.0f * x / GridX, -1.0f + 2.0f * y / GridY, -1.0f, 1.0f);
+        glm::vec4 p = invProjection * ndc;
+        return glm::vec3(p) / p.w;
+    };
+
+    clusterMin.resize(ClusterCount);
+    clusterMax.resize(ClusterCount);
+    for (uint32_t y = 0; y < GridY; ++y) {
+        for (uint32_t x = 0; x < GridX; ++x) {
+            const glm::vec3 corners[4] = { cornerOnNear(x, y), cornerOnNear(x + 1, y),
+                                           cornerOnNear(x, y + 1), cornerOnNear(x + 1, y + 1) };
+            for (uint32_t z = 0; z < GridZ; ++z) {
+                const float d0 = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z) / GridZ);
+                const float d1 = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z + 1) / GridZ);
+                glm::vec3 bmin(std::numeric_limits<float>::max());
+                glm::vec3 bmax(-std::numeric_limits<float>::max());
+                for (const glm::vec3& c : corners) {
+                    // c.z == -near
+                    for (float d : { d0, d1 }) {
+                        const glm::vec3 p = c * (d / nearPlane);
+                        bmin = glm::min(bmin, p);
+                        bmax = glm::max(bmax, p);
+                    }
+                }
+                const uint32_t index = ClusterIndex(x, y, z);
+                clusterMin[index] = bmin;
+                clusterMax[index] = bmax;
+            }
+        }
+    }
+}
+
+uint32_t LightClusterer::SliceForDepth(float depth) const {
+    const float slice = std::log(depth) * sliceScale - sliceBias;
+    return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GridZ - 1)));
+}
+
+void LightClusterer::Build(const std::vector<GpuClusterLight>& lights, const glm::mat4& view,
+                           const glm::mat4& projection, float nearPlane, float farPlane) {
+    auto start = std::chrono::high_resolution_clock::now();
+    UpdateClusterBounds(projection, nearPlane, farPlane);
+
+    const size_t n = lights.size();
+    lightCount = n;
+    lightBounds.resize(n);
+    lightSlices.resize(n);
+    lightSpheres.resize(n);
+    lightOffsets.assign(n + 1, 0);
+
+    JobSystem& jobs = JobSystem::Instance();
+
+    // 1) Pro Licht: Kachel-/Scheibenbereich bestimmen und die geschnittenen Cluster zählen
+    jobs.ParallelFor(0, n, LightGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const GpuClusterLight& light = lights[i];
+            const float r = std::min(light.positionRange.w, 1.0e6f); // Lichter ohne Dämpfung: endlich halten
+            const glm::vec3 c = glm::vec3(view * glm::vec4(glm::vec3(light.positionRange), 1.0f));
+            lightSpheres[i] = glm::vec4(c, r);
+            lightBounds[i] = glm::ivec4(-1);
+
+            const float depthMin = -c.z - r, depthMax = -c.z + r;
+            if (r <= 0.0f || depthMax < nearPlane || depthMin > farPlane) continue;
+
+            // Bildschirm-Rechteck der Box um die Kugel; z auf die Near-Plane begrenzt, damit
+            // Teile vor der Kamera die Projektion nicht umklappen (konservativ)
+            const float zNear = std::min(c.z + r, -nearPlane);
+            const float zFar = std::min(c.z - r, -nearPlane);
+            glm::vec2 ndcMin(std::numeric_limits<float>::max()), ndcMax(-std::numeric_limits<float>::max());
+            for (int corner = 0; corner < 8; ++corner) {
+                const glm::vec4 p((corner & 1) ? c.x + r : c.x - r,
+                                  (corner & 2) ? c.y + r : c.y - r,
+                                  (corner & 4) ? zFar : zNear, 1.0f);
+                const glm::vec4 clip = projection * p;
+                const glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) continue;
+
+            auto tile = [](float ndc, uint32_t count) {
+                const float t = (ndc * 0.5f + 0.5f) * static_cast<float>(count);
+                return static_cast<int>(std::clamp(t, 0.0f, static_cast<float>(count - 1)));
+            };
+            const glm::ivec4 bounds(tile(ndcMin.x, GridX), tile(ndcMin.y, GridY),
+                                    tile(ndcMax.x, GridX), tile(ndcMax.y, GridY));
+            const glm::ivec2 slices(SliceForDepth(std::max(depthMin, nearPlane)),
+                                    SliceForDepth(std::min(depthMax, farPlane)));
+
+            uint32_t count = 0;
+            for (int z = slices.x; z <= slices.y; ++z)
+                for (int y = bounds.y; y <= bounds.w; ++y)
+                    for (int x = bounds.x; x <= bounds.z; ++x) {
+                        const uint32_t cluster = ClusterIndex(x, y, z);
+                        if (SphereIntersectsBox(lightSpheres[i], clusterMin[cluster], clusterMax[cluster])) ++count;
+                    }
+            lightBounds[i] = bounds;
+            lightSlices[i] = slices;
+            lightOffsets[i] = count;
+        }
+    });
+
+    // 2) Präfixsumme -> Schreibposition jedes Lichts
+    uint32_t total = 0;
+    visibleCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t count = lightOffsets[i];
+        if (count > 0) ++visibleCount;
+        lightOffsets[i] = total;
+        total += count;
+    }
+    lightOffsets[n] = total;
+    pairClusters.resize(total);
+
+    // 3) Cluster-Indizes parallel eintragen (gleicher Test wie in 1)
+    jobs.ParallelFor(0, n, LightGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (lightOffsets[i] == lightOffsets[i + 1]) continue;
+            const glm::ivec4 bounds = lightBounds[i];
+            const glm::ivec2 slices = lightSlices[i];
+            uint32_t out = lightOffsets[i];
+            for (int z = slices.x; z <= slices.y; ++z)
+                for (int y = bounds.y; y <= bounds.w; ++y)
+                    for (int x = bounds.x; x <= bounds.z; ++x) {
+                        const uint32_t cluster = ClusterIndex(x, y, z);
+                        if (SphereIntersectsBox(lightSpheres[i], clusterMin[cluster], clusterMax[cluster])) {
+                            pairClusters[out++] = cluster;
+                        }
+                    }
+        }
+    });
+
+    // 4) Counting Sort nach Cluster; innerhalb eines Clusters bleiben die Lichter aufsteigend sortiert
+    clusterRanges.assign(ClusterCount * 2, 0);
+    for (uint32_t cluster : pairClusters) ++clusterRanges[cluster * 2 + 1];
+    uint32_t offset = 0;
+    for (uint32_t c = 0; c < ClusterCount; ++c) {
+        clusterRanges[c * 2] = offset;
+        offset += clusterRanges[c * 2 + 1];
+    }
+    lightIndices.resize(total);
+    clusterCursor.resize(ClusterCount);
+    for (uint32_t c = 0; c < ClusterCount; ++c) clusterCursor[c] = clusterRanges[c * 2];
+    for (size_t i = 0; i < n; ++i) {
+        for (uint32_t p = lightOffsets[i]; p < lightOffsets[i + 1]; ++p) {
+            lightIndices[clusterCursor[pairClusters[p]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void LightClusterer::Upload(const std::vector<GpuClusterLight>& lights) {
+    lightBuffer.Update(lights.data(), lights.size() * sizeof(GpuClusterLight), GL_RGBA32F);
+    rangeBuffer.Update(clusterRanges.data(), clusterRanges.size() * sizeof(uint32_t), GL_RG32UI);
+    indexBuffer.Update(lightIndices.data(), lightIndices.size() * sizeof(uint32_t), GL_R32UI);
+
+    const size_t largest = std::max(lights.size() * 4, lightIndices.size());
+    if (maxTexels > 0 && largest > static_cast<size_t>(maxTexels) && !warnedOverflow) {
+        std::cout << "[LightClusterer] " << largest << " texels exceed GL_MAX_TEXTURE_BUFFER_SIZE ("
+                  << maxTexels << "), lights will be missing" << std::endl;
+        warnedOverflow = true;
+    }
+}
+
+void LightClusterer::Bind(const Shader& shader) const {
+    static constexpr UniformId LightDataSampler("clusterLightData");
+    static constexpr UniformId RangeSampler("clusterRanges");
+    static constexpr UniformId IndexSampler("clusterLightIndices");
+
+    glActiveTexture(GL_TEXTURE0 + LightDataUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, lightBuffer.texture);
+    glActiveTexture(GL_TEXTURE0 + ClusterRangeUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, rangeBuffer.texture);
+    glActiveTexture(GL_TEXTURE0 + LightIndexUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, indexBuffer.texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.Set(LightDataSampler, LightDataUnit);
+    shader.Set(RangeSampler, ClusterRangeUnit);
+    shader.Set(IndexSampler, LightIndexUnit);
+}
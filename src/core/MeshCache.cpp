@@ -0,0 +1,468 @@
+#include "../../include/core/MeshCache.hpp"
+#include "../../include/core/ProjectManager.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    static_assert(std::is_trivially_copyable_v<Vertex> && std::is_trivially_copyable_v<CompactVertex>,
+                  "Vertex-Layouts der Arena werden 1:1 in die Datei kopiert");
+    static_assert(sizeof(glm::vec3) == 12, "Occluder-Positionen liegen dicht gepackt");
+
+    constexpr char Magic[4] = { 'A', 'R', 'K', 'M' };
+    constexpr uint64_t DataAlignment = 16;
+
+    // Aufbau: FileHeader | DependencyRecord[dependencyCount] | MeshRecord[meshCount] | LodRecord[lodCount] |
+    // Pfade (Abhängigkeiten, Texturen) | Datenblöcke (16-Byte-ausgerichtet).
+    // Offsets sind Byte-Offsets ab Dateianfang, Pfade relativ zur String-Tabelle.
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        uint64_t settingsHash;
+        uint64_t fileSize;
+        uint32_t meshCount;
+        uint32_t lodCount;
+        uint32_t dependencyCount;
+        float boundsMin[3];
+        float boundsMax[3];
+        float boundsCenter[3];
+        float boundsRadius;
+        uint32_t padding;
+    };
+    struct DependencyRecord {
+        uint64_t hash;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+    };
+    // Ein Arena-Bereich: drei Blöcke im Layout von format (GeometryArena::EncodedGeometry)
+    struct GeometryRecord {
+        uint64_t vertexOffset;
+        uint64_t positionOffset;
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t format;
+        float quantizationOffset[3];
+        float quantizationScale[3];
+        uint32_t padding;
+    };
+    struct MeshRecord {
+        GeometryRecord geometry;
+        uint64_t occluderPositionOffset;    // vec3[vertexCount]
+        uint64_t occluderIndexOffset;       // uint32[indexCount]
+        uint32_t firstLod;
+        uint32_t lodCount;
+        uint32_t diffuseOffset;
+        uint32_t diffuseLength;
+        uint32_t specularOffset;
+        uint32_t specularLength;
+        float shininess;
+        float boundsMin[3];
+        float boundsMax[3];
+        float boundsCenter[3];
+        float boundsRadius;
+        uint32_t padding;
+    };
+    struct LodRecord {
+        GeometryRecord geometry;
+        float error;
+        uint32_t padding;
+    };
+
+    uint64_t Rotl(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+
+    // Inhalts-Hash mit vier 64-Bit-Spuren (nach xxHash64), 32 Byte pro Schritt: liegt im warmen Ladepfad
+    // und soll gegenüber dem Mapping nicht ins Gewicht fallen
+    uint64_t HashContent(const unsigned char* data, size_t size) {
+        constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+        uint64_t lanes[4] = { Prime1 + Prime2, Prime2, 0, 0 - Prime1 };
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (int l = 0; l < 4; ++l) {
+                uint64_t word;
+                std::memcpy(&word, data + i + l * 8, sizeof(word));
+                lanes[l] = Rotl(lanes[l] + word * Prime2, 31) * Prime1;
+            }
+        }
+        uint64_t hash = Rotl(lanes[0], 1) + Rotl(lanes[1], 7) + Rotl(lanes[2], 12) + Rotl(lanes[3], 18) + size;
+        for (; i < size; ++i) hash = Rotl(hash ^ (data[i] * Prime1), 11) * Prime2;
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime1;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    uint64_t Align(uint64_t offset) { return (offset + DataAlignment - 1) & ~(DataAlignment - 1); }
+
+    // Bereich [offset, offset + count * elementSize) liegt in der Datei und ist für den Typ ausgerichtet
+    bool InFile(uint64_t offset, uint64_t count, size_t elementSize, size_t alignment, size_t fileSize) {
+        if (offset % alignment != 0 || offset > fileSize) return false;
+        return count <= (fileSize - offset) / elementSize;
+    }
+
+    // Prüft die drei Blöcke und setzt die View darauf
+    bool ReadGeometry(const GeometryRecord& record, const unsigned char* data, size_t size,
+                      GeometryArena::EncodedGeometry& geometry) {
+        if (record.format >= static_cast<uint32_t>(VertexFormat::Count)) return false;
+        const VertexFormat format = static_cast<VertexFormat>(record.format);
+        const size_t indexSize = GeometryArena::GetIndexSize(format);
+        if (!InFile(record.vertexOffset, record.vertexCount, GeometryArena::GetVertexSize(format), alignof(float), size) ||
+            !InFile(record.positionOffset, record.vertexCount, GeometryArena::GetPositionSize(format), alignof(float), size) ||
+            !InFile(record.indexOffset, record.indexCount, indexSize, indexSize, size)) {
+            return false;
+        }
+        geometry.format = format;
+        geometry.vertices = data + record.vertexOffset;
+        geometry.positions = data + record.positionOffset;
+        geometry.vertexCount = record.vertexCount;
+        geometry.indices = data + record.indexOffset;
+        geometry.indexCount = record.indexCount;
+        geometry.positionOffset = glm::vec3(record.quantizationOffset[0], record.quantizationOffset[1], record.quantizationOffset[2]);
+        geometry.positionScale = glm::vec3(record.quantizationScale[0], record.quantizationScale[1], record.quantizationScale[2]);
+        return true;
+    }
+
+    GeometryRecord DescribeGeometry(const GeometryArena::EncodedGeometry& geometry) {
+        GeometryRecord record = {};
+        record.vertexCount = geometry.vertexCount;
+        record.indexCount = geometry.indexCount;
+        record.format = static_cast<uint32_t>(geometry.format);
+        for (int i = 0; i < 3; ++i) {
+            record.quantizationOffset[i] = geometry.positionOffset[i];
+            record.quantizationScale[i] = geometry.positionScale[i];
+        }
+        return record;
+    }
+}
+
+namespace MeshCache {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(handle);
+        return false;
+    }
+    HANDLE map = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (map) CloseHandle(map);
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    mapping = map;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // Die Abbildung bleibt auch ohne offenen Deskriptor gültig
+    close(fd);
+    if (view == MAP_FAILED) return false;
+    // Wird direkt danach komplett gelesen
+    madvise(view, static_cast<size_t>(info.st_size), MADV_WILLNEED);
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+    if (file) CloseHandle(file);
+    mapping = file = nullptr;
+#else
+    if (data) munmap(const_cast<unsigned char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool HashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        // Leere Dateien lassen sich nicht abbilden, sind aber gültige Abhängigkeiten
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(path, error) || std::filesystem::file_size(path, error) != 0 || error) return false;
+        hash = HashContent(nullptr, 0);
+        return true;
+    }
+    hash = HashContent(file.Data(), file.Size());
+    return true;
+}
+
+bool ComputeKey(const std::string& sourcePath, uint64_t settings, Key& key) {
+    if (!HashFile(sourcePath, key.source)) return false;
+    key.settings = settings ^ (static_cast<uint64_t>(FormatVersion) << 56);
+    return true;
+}
+
+std::string CachePath(const std::string& cacheDirectory, const std::string& sourcePath, const Key& key) {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx",
+                  static_cast<unsigned long long>(key.source ^ Rotl(key.settings, 17) * 0x9E3779B185EBCA87ull));
+    const std::string name = std::filesystem::path(sourcePath).filename().string() + "-" + hash + ".arkmesh";
+    return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+std::string CacheDirectory() {
+    const std::string& root = ProjectManager::Instance().GetProjectRoot();
+    return root.empty() ? std::string("assets/cache") : root + "/assets/cache";
+}
+
+std::unique_ptr<CookedModel> CookedModel::Open(const std::string& path, const Key& key, const std::string& sourceDirectory) {
+    auto model = std::unique_ptr<CookedModel>(new CookedModel());
+    if (!model->file.Open(path)) return nullptr;
+    const unsigned char* data = model->file.Data();
+    const size_t size = model->file.Size();
+
+    if (size < sizeof(FileHeader)) return nullptr;
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != FormatVersion ||
+        header.sourceHash != key.source || header.settingsHash != key.settings || header.fileSize != size) {
+        return nullptr;
+    }
+    const uint64_t dependencyTable = sizeof(FileHeader);
+    const uint64_t meshTable = dependencyTable + static_cast<uint64_t>(header.dependencyCount) * sizeof(DependencyRecord);
+    const uint64_t lodTable = meshTable + static_cast<uint64_t>(header.meshCount) * sizeof(MeshRecord);
+    if (!InFile(dependencyTable, header.dependencyCount, sizeof(DependencyRecord), alignof(DependencyRecord), size) ||
+        !InFile(meshTable, header.meshCount, sizeof(MeshRecord), alignof(MeshRecord), size) ||
+        !InFile(lodTable, header.lodCount, sizeof(LodRecord), alignof(LodRecord), size)) {
+        std::cout << "[MeshCache] " << path << ": corrupt tables" << std::endl;
+        return nullptr;
+    }
+    const uint64_t strings = lodTable + static_cast<uint64_t>(header.lodCount) * sizeof(LodRecord);
+    const auto* dependencyRecords = reinterpret_cast<const DependencyRecord*>(data + dependencyTable);
+    const auto* meshRecords = reinterpret_cast<const MeshRecord*>(data + meshTable);
+    const auto* lodRecords = reinterpret_cast<const LodRecord*>(data + lodTable);
+    auto text = [&](uint32_t offset, uint32_t length, std::string& out) {
+        if (!InFile(strings + offset, length, 1, 1, size)) return false;
+        out.assign(reinterpret_cast<const char*>(data + strings + offset), length);
+        return true;
+    };
+
+    // Gleicher Hauptdatei-Inhalt reicht nicht: .mtl, .bin usw. müssen ebenfalls unverändert sein
+    for (uint32_t d = 0; d < header.dependencyCount; ++d) {
+        std::string dependency;
+        if (!text(dependencyRecords[d].pathOffset, dependencyRecords[d].pathLength, dependency)) {
+            std::cout << "[MeshCache] " << path << ": corrupt dependency " << d << std::endl;
+            return nullptr;
+        }
+        const std::string resolved = (std::filesystem::path(sourceDirectory) / dependency).lexically_normal().string();
+        uint64_t hash = 0;
+        if (!HashFile(resolved, hash) || hash != dependencyRecords[d].hash) return nullptr;
+    }
+
+    model->meshes.resize(header.meshCount);
+    for (uint32_t m = 0; m < header.meshCount; ++m) {
+        const MeshRecord& record = meshRecords[m];
+        MeshView& view = model->meshes[m];
+        if (!ReadGeometry(record.geometry, data, size, view.geometry) ||
+            !InFile(record.occluderPositionOffset, record.geometry.vertexCount, sizeof(glm::vec3), alignof(float), size) ||
+            !InFile(record.occluderIndexOffset, record.geometry.indexCount, sizeof(uint32_t), alignof(uint32_t), size) ||
+            record.firstLod > header.lodCount || record.lodCount > header.lodCount - record.firstLod ||
+            !text(record.diffuseOffset, record.diffuseLength, view.material.diffusePath) ||
+            !text(record.specularOffset, record.specularLength, view.material.specularPath)) {
+            std::cout << "[MeshCache] " << path << ": corrupt mesh " << m << std::endl;
+            return nullptr;
+        }
+        view.occluderPositions = reinterpret_cast<const glm::vec3*>(data + record.occluderPositionOffset);
+        view.occluderIndices = reinterpret_cast<const uint32_t*>(data + record.occluderIndexOffset);
+        view.bounds.min = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+        view.bounds.max = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+        view.bounds.center = glm::vec3(record.boundsCenter[0], record.boundsCenter[1], record.boundsCenter[2]);
+        view.bounds.radius = record.boundsRadius;
+        view.material.shininess = record.shininess;
+        view.lods.resize(record.lodCount);
+        for (uint32_t l = 0; l < record.lodCount; ++l) {
+            const LodRecord& lod = lodRecords[record.firstLod + l];
+            if (!ReadGeometry(lod.geometry, data, size, view.lods[l].geometry)) {
+                std::cout << "[MeshCache] " << path << ": corrupt LOD " << l << " of mesh " << m << std::endl;
+                return nullptr;
+            }
+            view.lods[l].error = lod.error;
+        }
+    }
+    model->bounds.min = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    model->bounds.max = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    model->bounds.center = glm::vec3(header.boundsCenter[0], header.boundsCenter[1], header.boundsCenter[2]);
+    model->bounds.radius = header.boundsRadius;
+    return model;
+}
+
+bool Write(const std::string& path, const Key& key, const std::vector<Dependency>& dependencies,
+           const std::vector<MeshView>& meshes, const Bounds& bounds) {
+    // Tabellen und String-Tabelle zuerst, die Offsets der Datenblöcke ergeben sich daraus
+    FileHeader header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.sourceHash = key.source;
+    header.settingsHash = key.settings;
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = bounds.min[i];
+        header.boundsMax[i] = bounds.max[i];
+        header.boundsCenter[i] = bounds.center[i];
+    }
+    header.boundsRadius = bounds.radius;
+
+    std::string strings;
+    std::vector<DependencyRecord> dependencyRecords(dependencies.size());
+    for (size_t d = 0; d < dependencies.size(); ++d) {
+        dependencyRecords[d].hash = dependencies[d].hash;
+        dependencyRecords[d].pathOffset = static_cast<uint32_t>(strings.size());
+        dependencyRecords[d].pathLength = static_cast<uint32_t>(dependencies[d].path.size());
+        strings += dependencies[d].path;
+    }
+    header.dependencyCount = static_cast<uint32_t>(dependencyRecords.size());
+
+    std::vector<MeshRecord> meshRecords(meshes.size());
+    std::vector<LodRecord> lodRecords;
+    for (size_t m = 0; m < meshes.size(); ++m) {
+        const MeshView& view = meshes[m];
+        MeshRecord& record = meshRecords[m];
+        record = {};
+        record.geometry = DescribeGeometry(view.geometry);
+        for (int i = 0; i < 3; ++i) {
+            record.boundsMin[i] = view.bounds.min[i];
+            record.boundsMax[i] = view.bounds.max[i];
+            record.boundsCenter[i] = view.bounds.center[i];
+        }
+        record.boundsRadius = view.bounds.radius;
+        record.firstLod = static_cast<uint32_t>(lodRecords.size());
+        record.lodCount = static_cast<uint32_t>(view.lods.size());
+        record.diffuseOffset = static_cast<uint32_t>(strings.size());
+        record.diffuseLength = static_cast<uint32_t>(view.material.diffusePath.size());
+        strings += view.material.diffusePath;
+        record.specularOffset = static_cast<uint32_t>(strings.size());
+        record.specularLength = static_cast<uint32_t>(view.material.specularPath.size());
+        strings += view.material.specularPath;
+        record.shininess = view.material.shininess;
+        for (const LodView& lod : view.lods) {
+            LodRecord lodRecord = {};
+            lodRecord.geometry = DescribeGeometry(lod.geometry);
+            lodRecord.error = lod.error;
+            lodRecords.push_back(lodRecord);
+        }
+    }
+    header.lodCount = static_cast<uint32_t>(lodRecords.size());
+
+    uint64_t offset = sizeof(FileHeader) + dependencyRecords.size() * sizeof(DependencyRecord) +
+                      meshRecords.size() * sizeof(MeshRecord) + lodRecords.size() * sizeof(LodRecord) + strings.size();
+    auto place = [&](uint64_t bytes) {
+        offset = Align(offset);
+        const uint64_t at = offset;
+        offset += bytes;
+        return at;
+    };
+    auto placeGeometry = [&](GeometryRecord& record) {
+        const VertexFormat format = static_cast<VertexFormat>(record.format);
+        record.vertexOffset = place(record.vertexCount * GeometryArena::GetVertexSize(format));
+        record.positionOffset = place(record.vertexCount * GeometryArena::GetPositionSize(format));
+        record.indexOffset = place(record.indexCount * GeometryArena::GetIndexSize(format));
+    };
+    for (size_t m = 0; m < meshes.size(); ++m) {
+        const MeshView& view = meshes[m];
+        MeshRecord& record = meshRecords[m];
+        placeGeometry(record.geometry);
+        record.occluderPositionOffset = place(record.geometry.vertexCount * sizeof(glm::vec3));
+        record.occluderIndexOffset = place(record.geometry.indexCount * sizeof(uint32_t));
+        for (size_t l = 0; l < view.lods.size(); ++l) placeGeometry(lodRecords[record.firstLod + l].geometry);
+    }
+    header.fileSize = offset;
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    // Eindeutig pro Thread: zwei Quellen mit gleichem Inhalt landen in derselben Cache-Datei
+    const std::string temporary = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cout << "[MeshCache] cannot write " << temporary << std::endl;
+            return false;
+        }
+        uint64_t written = 0;
+        auto write = [&](const void* bytes, uint64_t count) {
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+            written += count;
+        };
+        auto pad = [&] {
+            static const char zeros[DataAlignment] = {};
+            write(zeros, Align(written) - written);
+        };
+        write(&header, sizeof(header));
+        write(dependencyRecords.data(), dependencyRecords.size() * sizeof(DependencyRecord));
+        write(meshRecords.data(), meshRecords.size() * sizeof(MeshRecord));
+        write(lodRecords.data(), lodRecords.size() * sizeof(LodRecord));
+        write(strings.data(), strings.size());
+        // Gleiche Reihenfolge wie place oben
+        auto writeGeometry = [&](const GeometryArena::EncodedGeometry& geometry) {
+            pad();
+            write(geometry.vertices, geometry.vertexCount * GeometryArena::GetVertexSize(geometry.format));
+            pad();
+            write(geometry.positions, geometry.vertexCount * GeometryArena::GetPositionSize(geometry.format));
+            pad();
+            write(geometry.indices, geometry.indexCount * GeometryArena::GetIndexSize(geometry.format));
+        };
+        for (const MeshView& view : meshes) {
+            writeGeometry(view.geometry);
+            pad();
+            write(view.occluderPositions, view.geometry.vertexCount * sizeof(glm::vec3));
+            pad();
+            write(view.occluderIndices, view.geometry.indexCount * sizeof(uint32_t));
+            for (const LodView& lod : view.lods) writeGeometry(lod.geometry);
+        }
+        if (!out || written != header.fileSize) {
+            out.close();
+            std::filesystem::remove(temporary, error);
+            std::cout << "[MeshCache] write of " << path << " failed" << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,267 @@
+#include "../../include/core/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+namespace {
+    // Nächster Fächer-Vertex, wenn keiner der gerade ausgegebenen mehr offene Dreiecke hat:
+    // zuerst die zuletzt benutzten (liegen eher noch im Cache), dann linear über alle
+    int SkipDeadEnd(const std::vector<uint32_t>& live, std::vector<unsigned int>& deadEnds, size_t& cursor) {
+        while (!deadEnds.empty()) {
+            const unsigned int v = deadEnds.back();
+            deadEnds.pop_back();
+            if (live[v] > 0) return static_cast<int>(v);
+        }
+        while (cursor < live.size()) {
+            if (live[cursor] > 0) return static_cast<int>(cursor);
+            ++cursor;
+        }
+        return -1;
+    }
+
+    // Bitgenauer Vergleich der Eckpunkte, unabhängig von der Vertex-Nummerierung
+    struct TriangleKey {
+        Vertex corners[3];
+        bool operator<(const TriangleKey& o) const { return std::memcmp(corners, o.corners, sizeof(corners)) < 0; }
+        bool operator==(const TriangleKey& o) const { return std::memcmp(corners, o.corners, sizeof(corners)) == 0; }
+    };
+
+    std::vector<TriangleKey> SortedTriangles(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+        std::vector<TriangleKey> triangles(indices.size() / 3);
+        for (size_t t = 0; t < triangles.size(); ++t) {
+            // Mit der kleinsten Ecke beginnen: zyklisch verschobene Ecken (gleiche Umlaufrichtung) ergeben denselben Schlüssel
+            int first = 0;
+            for (int c = 1; c < 3; ++c) {
+                if (std::memcmp(&vertices[indices[t * 3 + c]], &vertices[indices[t * 3 + first]], sizeof(Vertex)) < 0) first = c;
+            }
+            for (int c = 0; c < 3; ++c) triangles[t].corners[c] = vertices[indices[t * 3 + (first + c) % 3]];
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+namespace MeshOptimizer {
+
+CacheStats AnalyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize) {
+    CacheStats stats;
+    stats.triangles = indices.size() / 3;
+    // FIFO über Zeitstempel: ein Vertex ist im Cache, solange nach ihm höchstens cacheSize-1 andere geladen wurden
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    for (unsigned int index : indices) {
+        if (timestamps[index] == 0) ++stats.vertices;
+        if (time - timestamps[index] > cacheSize) {
+            timestamps[index] = time++;
+            ++stats.misses;
+        }
+    }
+    return stats;
+}
+
+std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                              unsigned int cacheSize, std::vector<unsigned int>* clusterStarts) {
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<unsigned int> result;
+    result.reserve(triangleCount * 3);
+    if (clusterStarts) clusterStarts->clear();
+    if (triangleCount == 0) return result;
+
+    // Dreiecke pro Vertex (CSR); live = noch nicht ausgegebene davon
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) ++offsets[indices[i] + 1];
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> live(vertexCount);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        for (size_t v = 0; v < vertexCount; ++v) live[v] = offsets[v + 1] - offsets[v];
+    }
+
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<unsigned int> deadEnds;
+    std::vector<unsigned int> candidates;
+    size_t cursor = 0;
+
+    int fan = SkipDeadEnd(live, deadEnds, cursor);
+    if (clusterStarts) clusterStarts->push_back(0);
+    while (fan >= 0) {
+        // Alle offenen Dreiecke um den Fächer-Vertex ausgeben, Reihenfolge der Ecken bleibt
+        candidates.clear();
+        for (uint32_t k = offsets[fan]; k < offsets[fan + 1]; ++k) {
+            const uint32_t t = adjacency[k];
+            if (emitted[t]) continue;
+            emitted[t] = 1;
+            for (int c = 0; c < 3; ++c) {
+                const unsigned int v = indices[static_cast<size_t>(t) * 3 + c];
+                result.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - timestamps[v] > cacheSize) timestamps[v] = time++;
+            }
+        }
+
+        // Nächster Fächer: ein Nachbar, der nach seinen restlichen Dreiecken noch im Cache läge,
+        // bevorzugt der älteste davon (er fiele als erster heraus)
+        int next = -1;
+        int bestPriority = -1;
+        for (unsigned int v : candidates) {
+            if (live[v] == 0) continue;
+            int priority = 0;
+            const uint32_t age = time - timestamps[v];
+            if (age + 2 * live[v] <= cacheSize) priority = static_cast<int>(age);
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = static_cast<int>(v);
+            }
+        }
+        if (next < 0) {
+            next = SkipDeadEnd(live, deadEnds, cursor);
+            // Sprung zu einem Vertex außerhalb des Caches: harte Grenze, hier darf OptimizeOverdraw umsortieren
+            if (clusterStarts && next >= 0 && time - timestamps[next] > cacheSize) {
+                clusterStarts->push_back(static_cast<unsigned int>(result.size() / 3));
+            }
+        }
+        fan = next;
+    }
+    return result;
+}
+
+void OptimizeOverdraw(std::vector<unsigned int>& indices, const Vertex* vertices, size_t vertexCount,
+                      const std::vector<unsigned int>& hardStarts, float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (hardStarts.empty()) return;
+
+    // Weiche Grenzen (Sander et al.): jeder harte Cluster wird dort geteilt, wo die ACMR seit der letzten
+    // Grenze (Cache dort geleert) höchstens threshold * ACMR des ganzen Clusters beträgt. Ein Sprung der
+    // Zeit um CacheSize + 1 leert den simulierten FIFO.
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = CacheSize + 1;
+    auto triangleMisses = [&](size_t t) {
+        unsigned int misses = 0;
+        for (int c = 0; c < 3; ++c) {
+            const unsigned int v = indices[t * 3 + c];
+            if (time - timestamps[v] > CacheSize) {
+                timestamps[v] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    std::vector<unsigned int> clusterStarts;
+    for (size_t i = 0; i < hardStarts.size(); ++i) {
+        const size_t first = hardStarts[i];
+        const size_t end = i + 1 < hardStarts.size() ? hardStarts[i + 1] : triangleCount;
+        time += CacheSize + 1;
+        size_t clusterMisses = 0;
+        for (size_t t = first; t < end; ++t) clusterMisses += triangleMisses(t);
+        const float target = threshold * static_cast<float>(clusterMisses) / static_cast<float>(std::max<size_t>(end - first, 1));
+
+        time += CacheSize + 1;
+        clusterStarts.push_back(static_cast<unsigned int>(first));
+        size_t misses = 0, count = 0;
+        for (size_t t = first; t < end; ++t) {
+            misses += triangleMisses(t);
+            ++count;
+            if (t + 1 < end && static_cast<float>(misses) <= target * static_cast<float>(count)) {
+                clusterStarts.push_back(static_cast<unsigned int>(t + 1));
+                time += CacheSize + 1;
+                misses = count = 0;
+            }
+        }
+    }
+    if (clusterStarts.size() < 2) return;
+
+    // Flächengewichteter Schwerpunkt des Meshes
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = vertices[indices[t * 3]].position;
+        const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+        const float area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea <= 0.0f) return;
+    meshCenter = meshCenter * (1.0f / meshArea);
+
+    // Cluster, die weit außen liegen und nach außen zeigen, verdecken am ehesten andere -> zuerst
+    struct Cluster {
+        unsigned int first;
+        unsigned int count;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters(clusterStarts.size());
+    for (size_t i = 0; i < clusterStarts.size(); ++i) {
+        const unsigned int first = clusterStarts[i];
+        const unsigned int end = i + 1 < clusterStarts.size() ? clusterStarts[i + 1] : static_cast<unsigned int>(triangleCount);
+        glm::vec3 normal(0.0f), center(0.0f);
+        float area = 0.0f;
+        for (unsigned int t = first; t < end; ++t) {
+            const glm::vec3& a = vertices[indices[t * 3]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+            const glm::vec3 n = glm::cross(b - a, c - a);
+            const float triangleArea = glm::length(n);
+            normal += n;
+            center += (a + b + c) * (triangleArea / 3.0f);
+            area += triangleArea;
+        }
+        const float normalLength = glm::length(normal);
+        float key = 0.0f;
+        if (area > 0.0f && normalLength > 0.0f) {
+            key = glm::dot(center * (1.0f / area) - meshCenter, normal * (1.0f / normalLength));
+        }
+        clusters[i] = { first, end - first, key };
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        sorted.insert(sorted.end(), indices.begin() + static_cast<size_t>(cluster.first) * 3,
+                      indices.begin() + static_cast<size_t>(cluster.first + cluster.count) * 3);
+    }
+    indices.swap(sorted);
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    std::vector<unsigned int> remap(vertices.size(), ~0u);
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (unsigned int& index : indices) {
+        if (remap[index] == ~0u) {
+            remap[index] = static_cast<unsigned int>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+Result Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, bool overdraw) {
+    Result result;
+    result.before = AnalyzeVertexCache(indices, vertices.size());
+    std::vector<unsigned int> clusterStarts;
+    indices = OptimizeVertexCache(indices, vertices.size(), CacheSize, overdraw ? &clusterStarts : nullptr);
+    if (overdraw) OptimizeOverdraw(indices, vertices.data(), vertices.size(), clusterStarts);
+    OptimizeVertexFetch(vertices, indices);
+    result.after = AnalyzeVertexCache(indices, vertices.size());
+    return result;
+}
+
+bool IsEquivalent(const std::vector<Vertex>& verticesA, const std::vector<unsigned int>& indicesA,
+                  const std::vector<Vertex>& verticesB, const std::vector<unsigned int>& indicesB) {
+    if (indicesA.size() != indicesB.size()) return false;
+    return SortedTriangles(verticesA, indicesA) == SortedTriangles(verticesB, indicesB);
+}
+
+}
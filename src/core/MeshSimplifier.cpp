@@ -0,0 +1,272 @@
+#include "../../include/core/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+    constexpr size_t MinLodTriangles = 256;     // darunter lohnt eine LOD-Kette nicht
+    constexpr float BaseLodError = 0.01f;       // erlaubter Fehler der ersten Stufe relativ zum Radius, verdoppelt je Stufe
+
+    // Symmetrische 4x4-Quadrik (10 Koeffizienten) plus Flächengewicht, in double gegen Auslöschung
+    struct Quadric {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double w = 0;
+
+        void Add(const Quadric& o) {
+            a00 += o.a00; a01 += o.a01; a02 += o.a02; a11 += o.a11; a12 += o.a12; a22 += o.a22;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2; c += o.c;
+            w += o.w;
+        }
+        // Ebene n*p + d = 0 (n normiert), gewichtet mit der Dreiecksfläche
+        void AddPlane(double nx, double ny, double nz, double d, double weight) {
+            a00 += nx * nx * weight; a01 += nx * ny * weight; a02 += nx * nz * weight;
+            a11 += ny * ny * weight; a12 += ny * nz * weight; a22 += nz * nz * weight;
+            b0 += nx * d * weight; b1 += ny * d * weight; b2 += nz * d * weight;
+            c += d * d * weight;
+            w += weight;
+        }
+        // Gewichtete Summe der quadrierten Abstände von p zu allen Ebenen
+        double Evaluate(const glm::vec3& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            const double r = x * (a00 * x + 2.0 * (a01 * y + a02 * z + b0)) +
+                             y * (a11 * y + 2.0 * (a12 * z + b1)) +
+                             z * (a22 * z + 2.0 * b2) + c;
+            return std::max(r, 0.0);
+        }
+    };
+
+    // Mittlerer Abstand (Modell-Einheiten) von p zu den Ebenen beider Quadriken
+    float CollapseError(const Quadric& a, const Quadric& b, const glm::vec3& p) {
+        const double w = a.w + b.w;
+        if (w <= 0.0) return 0.0f;
+        return static_cast<float>(std::sqrt((a.Evaluate(p) + b.Evaluate(p)) / w));
+    }
+
+    struct Collapse {
+        float error;
+        unsigned int from;      // wird entfernt
+        unsigned int to;        // bleibt stehen
+    };
+
+    // canonical[v] = Repräsentant aller Vertices mit exakt gleicher Position
+    void WeldPositions(const Vertex* vertices, size_t vertexCount, std::vector<unsigned int>& canonical,
+                       std::vector<uint8_t>& locked) {
+        std::vector<unsigned int> order(vertexCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+            const glm::vec3& pa = vertices[a].position;
+            const glm::vec3& pb = vertices[b].position;
+            if (pa.x != pb.x) return pa.x < pb.x;
+            if (pa.y != pb.y) return pa.y < pb.y;
+            return pa.z < pb.z;
+        });
+        canonical.resize(vertexCount);
+        locked.assign(vertexCount, 0);
+        size_t begin = 0;
+        while (begin < vertexCount) {
+            size_t end = begin + 1;
+            const glm::vec3& p = vertices[order[begin]].position;
+            while (end < vertexCount && vertices[order[end]].position == p) ++end;
+            const unsigned int representative = order[begin];
+            for (size_t i = begin; i < end; ++i) canonical[order[i]] = representative;
+            // Mehrere Vertices an einer Position = Naht in Normalen oder UVs -> fest
+            if (end - begin > 1) locked[representative] = 1;
+            begin = end;
+        }
+    }
+}
+
+namespace MeshSimplifier {
+
+std::vector<unsigned int> Simplify(const Vertex* vertices, size_t vertexCount, const std::vector<unsigned int>& indices,
+                                   size_t targetIndexCount, float targetError, float* outError) {
+    std::vector<unsigned int> result = indices;
+    if (outError) *outError = 0.0f;
+    if (vertexCount == 0 || result.size() <= targetIndexCount) return result;
+
+    std::vector<unsigned int> canonical;
+    std::vector<uint8_t> locked;
+    WeldPositions(vertices, vertexCount, canonical, locked);
+
+    // Randkanten (nur ein Dreieck) fixieren ihre Endpunkte, sonst würde der Rand nach innen wandern
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    edgeUse.reserve(result.size());
+    for (size_t i = 0; i < result.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            uint64_t a = canonical[result[i + e]];
+            uint64_t b = canonical[result[i + (e + 1) % 3]];
+            if (a > b) std::swap(a, b);
+            ++edgeUse[(a << 32) | b];
+        }
+    }
+    for (const auto& [edge, uses] : edgeUse) {
+        if (uses != 1) continue;
+        locked[static_cast<uint32_t>(edge >> 32)] = 1;
+        locked[static_cast<uint32_t>(edge)] = 1;
+    }
+
+    // Eine Quadrik pro verschweißter Position aus den Ebenen aller angrenzenden Dreiecke
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < result.size(); i += 3) {
+        const glm::vec3& p0 = vertices[result[i]].position;
+        glm::vec3 n = glm::cross(vertices[result[i + 1]].position - p0, vertices[result[i + 2]].position - p0);
+        const float length = glm::length(n);
+        if (length <= 0.0f) continue;
+        n = n * (1.0f / length);
+        const double d = -static_cast<double>(glm::dot(n, p0));
+        for (int k = 0; k < 3; ++k) {
+            quadrics[canonical[result[i + k]]].AddPlane(n.x, n.y, n.z, d, length * 0.5);
+        }
+    }
+
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<uint8_t> dirty(vertexCount);
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    float maxError = 0.0f;
+
+    // Pro Durchgang: alle Kanten nach Fehler sortieren und gierig kollabieren, solange die Umgebung
+    // im selben Durchgang noch unverändert ist. Danach Indizes umschreiben und von vorne.
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+
+        // Dreiecke pro Position (CSR)
+        adjacencyOffsets.assign(vertexCount + 1, 0);
+        for (unsigned int index : result) ++adjacencyOffsets[canonical[index] + 1];
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        adjacency.resize(result.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i) {
+                adjacency[fill[canonical[result[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3) {
+            for (int e = 0; e < 3; ++e) {
+                const unsigned int u = result[i + e];
+                const unsigned int v = result[i + (e + 1) % 3];
+                const unsigned int cu = canonical[u];
+                const unsigned int cv = canonical[v];
+                if (!locked[cu]) collapses.push_back({ CollapseError(quadrics[cu], quadrics[cv], vertices[v].position), u, v });
+                if (!locked[cv]) collapses.push_back({ CollapseError(quadrics[cv], quadrics[cu], vertices[u].position), v, u });
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(dirty.begin(), dirty.end(), 0);
+        const size_t toRemove = triangleCount - targetIndexCount / 3;
+        size_t removed = 0;
+        size_t applied = 0;
+        for (const Collapse& collapse : collapses) {
+            if (collapse.error > targetError || removed >= toRemove) break;
+            const unsigned int ca = canonical[collapse.from];
+            const unsigned int cb = canonical[collapse.to];
+            if (dirty[ca] || dirty[cb]) continue;
+
+            // Kein Dreieck um a darf beim Verschieben auf b umklappen
+            const glm::vec3& target = vertices[collapse.to].position;
+            bool flips = false;
+            size_t collapsed = 0;
+            for (uint32_t k = adjacencyOffsets[ca]; k < adjacencyOffsets[ca + 1] && !flips; ++k) {
+                const unsigned int* tri = &result[static_cast<size_t>(adjacency[k]) * 3];
+                if (canonical[tri[0]] == cb || canonical[tri[1]] == cb || canonical[tri[2]] == cb) {
+                    ++collapsed;
+                    continue;
+                }
+                glm::vec3 before[3], after[3];
+                for (int c = 0; c < 3; ++c) {
+                    before[c] = vertices[tri[c]].position;
+                    after[c] = canonical[tri[c]] == ca ? target : before[c];
+                }
+                const glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+                flips = glm::dot(n0, n1) <= 0.0f;
+            }
+            if (flips) continue;
+
+            // Nicht fixierte Positionen haben genau einen Vertex -> ein Eintrag in remap genügt
+            remap[collapse.from] = collapse.to;
+            quadrics[cb].Add(quadrics[ca]);
+            for (uint32_t k = adjacencyOffsets[ca]; k < adjacencyOffsets[ca + 1]; ++k) {
+                const unsigned int* tri = &result[static_cast<size_t>(adjacency[k]) * 3];
+                dirty[canonical[tri[0]]] = dirty[canonical[tri[1]]] = dirty[canonical[tri[2]]] = 1;
+            }
+            removed += collapsed;
+            maxError = std::max(maxError, collapse.error);
+            ++applied;
+        }
+        if (applied == 0) break;
+
+        // Umschreiben; Dreiecke mit zwei gleichen Positionen sind entartet und fallen weg
+        size_t out = 0;
+        for (size_t i = 0; i < result.size(); i += 3) {
+            const unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+            const unsigned int ca = canonical[a], cb = canonical[b], cc = canonical[c];
+            if (ca == cb || cb == cc || ca == cc) continue;
+            result[out++] = a;
+            result[out++] = b;
+            result[out++] = c;
+        }
+        result.resize(out);
+    }
+
+    if (outError) *outError = maxError;
+    return result;
+}
+
+std::vector<LodLevel> BuildLodChain(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    std::vector<LodLevel> lods;
+    if (vertices.empty() || indices.size() / 3 < MinLodTriangles) return lods;
+
+    glm::vec3 mn = vertices[0].position, mx = vertices[0].position;
+    for (const Vertex& v : vertices) {
+        mn = glm::min(mn, v.position);
+        mx = glm::max(mx, v.position);
+    }
+    const float radius = glm::length(mx - mn) * 0.5f;
+
+    // Jede Stufe vereinfacht die vorige auf die halbe Dreieckszahl; die Fehler addieren sich
+    // (obere Schranke für den Abstand zur vollen Auflösung)
+    lods.reserve(MaxLodLevels);
+    const std::vector<unsigned int>* source = &indices;
+    float accumulatedError = 0.0f;
+    for (int level = 0; level < MaxLodLevels; ++level) {
+        const size_t target = source->size() / 6 * 3;
+        const float targetError = radius * BaseLodError * static_cast<float>(1 << level);
+        float error = 0.0f;
+        std::vector<unsigned int> simplified = MeshSimplifier::Simplify(vertices.data(), vertices.size(), *source,
+                                                                        target, targetError, &error);
+        // Kaum Ersparnis (Nähte, Ränder, Fehlergrenze) -> weitere Stufen bringen nichts
+        if (simplified.empty() || simplified.size() * 10 > source->size() * 9) break;
+        accumulatedError += error;
+        LodLevel lod;
+        lod.indices = std::move(simplified);
+        lod.error = accumulatedError;
+        lods.push_back(std::move(lod));
+        source = &lods.back().indices;
+    }
+
+    // Erst jetzt kompaktieren: alle Stufen indizieren bis hierhin die Original-Vertices
+    std::vector<unsigned int> newIndex(vertices.size());
+    for (LodLevel& lod : lods) {
+        std::fill(newIndex.begin(), newIndex.end(), ~0u);
+        for (unsigned int& index : lod.indices) {
+            if (newIndex[index] == ~0u) {
+                newIndex[index] = static_cast<unsigned int>(lod.vertices.size());
+                lod.vertices.push_back(vertices[index]);
+            }
+            index = newIndex[index];
+        }
+    }
+    return lods;
+}
+
+}
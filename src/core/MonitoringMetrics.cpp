@@ -6,28 +6,7 @@
 #include <psapi.h>
 #endif
 #include "glad/glad.h"
-
-// Helper: Extension-Erkennung ohne GLAD Variablen
-static bool HasGLExtension(const char* name) {
-    if (!name) return false;
-    GLint numExt = 0;
-    if (glGetStringi) {
-        glGetIntegerv(GL_NUM_EXTENSIONS, &numExt);
-        for (GLint i=0;i<numExt;++i) {
-            const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, i);
-            if (ext && std::strcmp(ext, name)==0) return true;
-        }
-        return false;
-    }
-    // Fallback (älter): gesamter String (deprecated, aber als Rückfallebene ok)
-    const char* all = (const char*)glGetString(GL_EXTENSIONS);
-    if (!all) return false;
-    std::string s(all);
-    std::string needle(name);
-    needle.push_back(' ');
-    if (s.rfind(needle, 0) == 0) return true; // ganz vorne
-    return s.find(std::string(" ")+needle) != std::string::npos;
-}
+#include "../../include/core/GLCapabilities.hpp"
 
 // Definiere fehlende Konstanten sicherheitshalber
 #ifndef GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX
@@ -54,6 +33,21 @@ MonitoringMetrics::MonitoringMetrics() {
     ramMBSeries.init(N);
     vramMBSeries.init(N);
     vramUsedMBSeries.init(N);
+    queueBuildMs.init(N);
+    queueSortMs.init(N);
+    drawCallSeries.init(N);
+    batchingRatioSeries.init(N);
+    shadedPerPixelSeries.init(N);
+    instanceUploadKB.init(N);
+    fenceWaitMsSeries.init(N);
+    cullMsSeries.init(N);
+    visibleSeries.init(N);
+    occlusionRasterMs.init(N);
+    occlusionTestMs.init(N);
+    lodTrianglesK.init(N);
+    transformUpdateMs.init(N);
+    uniformCallSeries.init(N);
+    lightClusterMs.init(N);
 #ifdef _WIN32
     SYSTEM_INFO si; GetSystemInfo(&si); cpuCount = (int)si.dwNumberOfProcessors;
 #endif
@@ -137,8 +131,8 @@ void MonitoringMetrics::UpdateMemory() {
     static bool hasNVX = false;
     static bool hasATI = false;
     if (!extChecked) {
-        hasNVX = HasGLExtension("GL_NVX_gpu_memory_info");
-        hasATI = HasGLExtension("GL_ATI_meminfo");
+        hasNVX = GLCapabilities::HasExtension("GL_NVX_gpu_memory_info");
+        hasATI = GLCapabilities::HasExtension("GL_ATI_meminfo");
         extChecked = true;
     }
     if (hasNVX) {
@@ -164,3 +158,87 @@ void MonitoringMetrics::UpdateMemory() {
     vramMBSeries.push(lastVramTotalMB);
     vramUsedMBSeries.push(lastVramUsedMB);
 }
+
+void MonitoringMetrics::RecordRenderQueue(double buildMs, double sortMs, size_t items, size_t batches, size_t drawCalls) {
+    queueBuildMs.push((float)buildMs);
+    queueSortMs.push((float)sortMs);
+    drawCallSeries.push((float)drawCalls);
+    lastQueueItems = items;
+    lastDrawCalls = drawCalls;
+    lastBatches = batches;
+    batchingRatioSeries.push((float)LastBatchingRatio());
+}
+
+void MonitoringMetrics::RecordInstanceUpload(size_t bytes, int fenceWaits, double fenceWaitMs, int ringFallbacks) {
+    instanceUploadKB.push((float)(bytes / 1024.0));
+    fenceWaitMsSeries.push((float)fenceWaitMs);
+    lastFenceWaits = fenceWaits;
+    if (ringFallbacks > 0) ++ringFallbackFrames;
+}
+
+void MonitoringMetrics::RecordCulling(size_t visible, size_t culled, double cullMs) {
+    cullMsSeries.push((float)cullMs);
+    visibleSeries.push((float)visible);
+    lastVisible = visible;
+    lastCulled = culled;
+}
+
+void MonitoringMetrics::RecordOcclusion(size_t occluded, size_t occluderTriangles, double rasterMs, double testMs) {
+    occlusionRasterMs.push((float)rasterMs);
+    occlusionTestMs.push((float)testMs);
+    lastOccluded = occluded;
+    lastOccluderTriangles = occluderTriangles;
+}
+
+void MonitoringMetrics::RecordLod(size_t selectedTriangles, size_t fullTriangles, size_t reducedInstances) {
+    lodTrianglesK.push((float)(selectedTriangles / 1000.0));
+    lastLodTriangles = selectedTriangles;
+    lastFullTriangles = fullTriangles;
+    lastLodReduced = reducedInstances;
+}
+
+void MonitoringMetrics::RecordTransformUpdate(size_t updatedNodes, double updateMs) {
+    transformUpdateMs.push((float)updateMs);
+    lastTransformUpdates = updatedNodes;
+}
+
+void MonitoringMetrics::RecordUniformUploads(size_t uniformCalls, size_t skippedCalls, size_t bufferUploads) {
+    uniformCallSeries.push((float)uniformCalls);
+    lastUniformCalls = uniformCalls;
+    lastSkippedUniformCalls = skippedCalls;
+    lastUniformBufferUploads = bufferUploads;
+}
+
+void MonitoringMetrics::RecordLightClusters(size_t lights, size_t visibleLights, size_t lightIndices, double buildMs) {
+    lightClusterMs.push((float)buildMs);
+    lastLights = lights;
+    lastVisibleLights = visibleLights;
+    lastLightIndices = lightIndices;
+}
+
+void MonitoringMetrics::RecordGeometryArena(size_t vaoBinds, size_t vertexBytes, size_t indexBytes) {
+    lastVaoBinds = vaoBinds;
+    lastArenaVertexBytes = vertexBytes;
+    lastArenaIndexBytes = indexBytes;
+}
+
+void MonitoringMetrics::RecordShadedFragments(long long samples, size_t pixels) {
+    if (pixels == 0) return;
+    lastShadedPerPixel = (float)((double)samples / (double)pixels);
+    shadedPerPixelSeries.push(lastShadedPerPixel);
+}
+
+void MonitoringMetrics::RecordGpuPass(const char* name, double ms) {
+    // Wenige Passes -> lineare Suche
+    for (auto& pass : gpuPasses) {
+        if (pass.name == name) {
+            pass.ms.push((float)ms);
+            return;
+        }
+    }
+    GpuPassSeries pass;
+    pass.name = name;
+    pass.ms.init(frameTimeMs.data.size());
+    pass.ms.push((float)ms);
+    gpuPasses.push_back(std::move(pass));
+}
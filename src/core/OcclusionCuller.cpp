@@ -0,0 +1,267 @@
+#include "../../include/core/OcclusionCuller.hpp"
+#include "../../include/core/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ARK_OCCLUSION_SSE 1
+#include <immintrin.h>
+#endif
+
+OcclusionCuller::OcclusionCuller() {
+    int offset = 0;
+    for (int level = 0; level < LevelCount; ++level) {
+        levelWidth[level] = std::max(1, Width >> level);
+        levelHeight[level] = std::max(1, Height >> level);
+        levelOffset[level] = offset;
+        offset += levelWidth[level] * levelHeight[level];
+    }
+    depth.assign(static_cast<size_t>(Width) * Height, 1.0f);
+    hiZ.assign(offset, 1.0f);
+}
+
+void OcclusionCuller::Begin(const glm::mat4& vp) {
+    viewProj = vp;
+    occluders.clear();
+}
+
+void OcclusionCuller::AddOccluder(const glm::vec3* positions, size_t stride, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount, const glm::mat4& model) {
+    if (!positions || !indices || indexCount < 3) return;
+    occluders.push_back({ positions, stride, vertexCount, indices, indexCount, viewProj * model });
+}
+
+void OcclusionCuller::Rasterize() {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    JobSystem& jobs = JobSystem::Instance();
+
+    // 1. Vertices transformieren, an der Near-Plane clippen, Dreiecke aufsetzen (pro Occluder unabhängig)
+    if (occluderTriangles.size() < occluders.size()) occluderTriangles.resize(occluders.size());
+    jobs.ParallelFor(0, occluders.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            occluderTriangles[i].clear();
+            SetupOccluder(occluders[i], occluderTriangles[i]);
+        }
+    });
+
+    // 2. Binning nach Zeilenbändern, damit jedes Band nur seine Dreiecke anfasst
+    for (auto& band : bands) band.clear();
+    triangleCount = 0;
+    for (size_t i = 0; i < occluders.size(); ++i) {
+        for (const ScreenTriangle& tri : occluderTriangles[i]) {
+            const int first = tri.minY / BandHeight;
+            const int last = tri.maxY / BandHeight;
+            for (int b = first; b <= last; ++b) bands[b].push_back(&tri);
+        }
+        triangleCount += occluderTriangles[i].size();
+    }
+
+    // 3. Bänder sind disjunkte Zeilen des Tiefenpuffers -> ohne Synchronisation parallel
+    jobs.ParallelFor(0, BandCount, 1, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) RasterizeBand(static_cast<int>(b));
+    });
+
+    BuildHiZ();
+    rasterMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+void OcclusionCuller::SetupOccluder(const Occluder& occluder, std::vector<ScreenTriangle>& out) const {
+    // Jeder Vertex wird einmal transformiert, auch wenn er in mehreren Dreiecken vorkommt
+    thread_local std::vector<glm::vec4> clip;
+    clip.resize(occluder.vertexCount);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(occluder.positions);
+    for (size_t v = 0; v < occluder.vertexCount; ++v) {
+        const glm::vec3& p = *reinterpret_cast<const glm::vec3*>(bytes + v * occluder.stride);
+        clip[v] = occluder.mvp * glm::vec4(p, 1.0f);
+    }
+
+    for (size_t i = 0; i + 2 < occluder.indexCount; i += 3) {
+        const uint32_t i0 = occluder.indices[i], i1 = occluder.indices[i + 1], i2 = occluder.indices[i + 2];
+        if (i0 >= occluder.vertexCount || i1 >= occluder.vertexCount || i2 >= occluder.vertexCount) continue;
+        const glm::vec4 v[3] = { clip[i0], clip[i1], clip[i2] };
+        // Abstand zur Near-Plane (GL: z >= -w)
+        const float d[3] = { v[0].z + v[0].w, v[1].z + v[1].w, v[2].z + v[2].w };
+        const int inside = (d[0] >= 0.0f) + (d[1] >= 0.0f) + (d[2] >= 0.0f);
+        if (inside == 0) continue;
+        if (inside == 3) {
+            EmitTriangle(v[0], v[1], v[2], out);
+            continue;
+        }
+        // Sutherland-Hodgman gegen eine Ebene: 3 oder 4 Eckpunkte, als Fächer ausgeben
+        glm::vec4 poly[4];
+        int n = 0;
+        for (int e = 0; e < 3; ++e) {
+            const int next = (e + 1) % 3;
+            if (d[e] >= 0.0f) poly[n++] = v[e];
+            if ((d[e] >= 0.0f) != (d[next] >= 0.0f)) {
+                const float t = d[e] / (d[e] - d[next]);
+                poly[n++] = v[e] + (v[next] - v[e]) * t;
+            }
+        }
+        for (int k = 1; k + 1 < n; ++k) EmitTriangle(poly[0], poly[k], poly[k + 1], out);
+    }
+}
+
+void OcclusionCuller::EmitTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c,
+                                   std::vector<ScreenTriangle>& out) const {
+    const glm::vec4* v[3] = { &a, &b, &c };
+    float x[3], y[3], z[3];
+    for (int k = 0; k < 3; ++k) {
+        if (v[k]->w <= 1e-6f) return;
+        const float invW = 1.0f / v[k]->w;
+        x[k] = (v[k]->x * invW * 0.5f + 0.5f) * Width;
+        y[k] = (v[k]->y * invW * 0.5f + 0.5f) * Height;
+        z[k] = v[k]->z * invW * 0.5f + 0.5f;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::fabs(area) < 1e-8f) return;
+    // Occluder werden beidseitig gerastert (der Renderer cullt keine Rückseiten); einheitlich CCW ausrichten
+    if (area < 0.0f) {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    // Abgetastet wird in Pixelmitten (i + 0.5)
+    ScreenTriangle tri;
+    tri.minX = std::max(0, static_cast<int>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+    tri.maxX = std::min(Width - 1, static_cast<int>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+    tri.minY = std::max(0, static_cast<int>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+    tri.maxY = std::min(Height - 1, static_cast<int>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY) return;
+
+    for (int k = 0; k < 3; ++k) {
+        tri.x[k] = x[k];
+        tri.y[k] = y[k];
+    }
+    const float invArea = 1.0f / area;
+    tri.dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) * invArea;
+    tri.dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) * invArea;
+    tri.z0 = z[0] - tri.dzdx * x[0] - tri.dzdy * y[0];
+    out.push_back(tri);
+}
+
+void OcclusionCuller::RasterizeBand(int band) {
+    const int bandMinY = band * BandHeight;
+    const int bandMaxY = bandMinY + BandHeight - 1;
+    for (int y = bandMinY; y <= bandMaxY; ++y) {
+        std::fill_n(depth.begin() + static_cast<size_t>(y) * Width, Width, 1.0f);
+    }
+
+    for (const ScreenTriangle* tri : bands[band]) {
+        // Kantenfunktionen E(p) = A * px + B * py + C, >= 0 innerhalb (CCW)
+        float A[3], B[3], C[3];
+        for (int e = 0; e < 3; ++e) {
+            const int n = (e + 1) % 3;
+            A[e] = -(tri->y[n] - tri->y[e]);
+            B[e] = tri->x[n] - tri->x[e];
+            C[e] = -(A[e] * tri->x[e] + B[e] * tri->y[e]);
+        }
+        const int y0 = std::max(bandMinY, tri->minY);
+        const int y1 = std::min(bandMaxY, tri->maxY);
+        // Vierergruppen beginnen ausgerichtet; Width ist ein Vielfaches von 4
+        const int x0 = tri->minX & ~3;
+        const int x1 = tri->maxX;
+
+        for (int y = y0; y <= y1; ++y) {
+            const float py = static_cast<float>(y) + 0.5f;
+            float* row = depth.data() + static_cast<size_t>(y) * Width;
+            const float rowE0 = B[0] * py + C[0];
+            const float rowE1 = B[1] * py + C[1];
+            const float rowE2 = B[2] * py + C[2];
+            const float rowZ = tri->z0 + tri->dzdy * py;
+#if defined(ARK_OCCLUSION_SSE)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 lane = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+            const __m128 a0 = _mm_set1_ps(A[0]), a1 = _mm_set1_ps(A[1]), a2 = _mm_set1_ps(A[2]);
+            const __m128 r0 = _mm_set1_ps(rowE0), r1 = _mm_set1_ps(rowE1), r2 = _mm_set1_ps(rowE2);
+            const __m128 dzdx = _mm_set1_ps(tri->dzdx), rz = _mm_set1_ps(rowZ);
+            for (int x = x0; x <= x1; x += 4) {
+                const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+                __m128 mask = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero);
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero));
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+                if (_mm_movemask_ps(mask) == 0) continue;
+                const __m128 z = _mm_add_ps(rz, _mm_mul_ps(dzdx, px));
+                const __m128 old = _mm_loadu_ps(row + x);
+                const __m128 nearest = _mm_min_ps(old, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, nearest), _mm_andnot_ps(mask, old)));
+            }
+#else
+            for (int x = tri->minX; x <= x1; ++x) {
+                const float px = static_cast<float>(x) + 0.5f;
+                if (A[0] * px + rowE0 < 0.0f || A[1] * px + rowE1 < 0.0f || A[2] * px + rowE2 < 0.0f) continue;
+                row[x] = std::min(row[x], rowZ + tri->dzdx * px);
+            }
+            (void)x0;
+#endif
+        }
+    }
+}
+
+void OcclusionCuller::BuildHiZ() {
+    std::copy(depth.begin(), depth.end(), hiZ.begin());
+    // Jeder Texel hält die größte (fernste) Tiefe seiner 2x2 Kinder
+    for (int level = 1; level < LevelCount; ++level) {
+        const float* src = hiZ.data() + levelOffset[level - 1];
+        float* dst = hiZ.data() + levelOffset[level];
+        const int srcW = levelWidth[level - 1], srcH = levelHeight[level - 1];
+        for (int y = 0; y < levelHeight[level]; ++y) {
+            const int sy0 = std::min(2 * y, srcH - 1), sy1 = std::min(2 * y + 1, srcH - 1);
+            for (int x = 0; x < levelWidth[level]; ++x) {
+                const int sx0 = std::min(2 * x, srcW - 1), sx1 = std::min(2 * x + 1, srcW - 1);
+                dst[y * levelWidth[level] + x] = std::max(std::max(src[sy0 * srcW + sx0], src[sy0 * srcW + sx1]),
+                                                          std::max(src[sy1 * srcW + sx0], src[sy1 * srcW + sx1]));
+            }
+        }
+    }
+}
+
+float OcclusionCuller::GetHiZ(int level, int x, int y) const {
+    return hiZ[levelOffset[level] + y * levelWidth[level] + x];
+}
+
+bool OcclusionCuller::IsOccluded(const glm::vec3& center, const glm::vec3& extents) const {
+    if (occluders.empty()) return false;
+
+    // Acht Ecken in Clip-Space: Mittelpunkt plus/minus die skalierten Matrixspalten
+    const glm::vec4 c = viewProj * glm::vec4(center, 1.0f);
+    const glm::vec4 ax = viewProj[0] * extents.x;
+    const glm::vec4 ay = viewProj[1] * extents.y;
+    const glm::vec4 az = viewProj[2] * extents.z;
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, minZ = 1e30f;
+    for (int k = 0; k < 8; ++k) {
+        const glm::vec4 p = c + ((k & 1) ? ax : -ax) + ((k & 2) ? ay : -ay) + ((k & 4) ? az : -az);
+        // Schneidet die Box die Near-Plane, lässt sich kein Bildrechteck angeben
+        if (p.z < -p.w || p.w <= 1e-6f) return false;
+        const float invW = 1.0f / p.w;
+        minX = std::min(minX, p.x * invW);
+        maxX = std::max(maxX, p.x * invW);
+        minY = std::min(minY, p.y * invW);
+        maxY = std::max(maxY, p.y * invW);
+        minZ = std::min(minZ, p.z * invW);
+    }
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) return false;
+
+    // Alle Pixel, die das Bildrechteck berührt
+    const int px0 = std::max(0, static_cast<int>(std::floor((minX * 0.5f + 0.5f) * Width)));
+    const int px1 = std::min(Width - 1, static_cast<int>(std::floor((maxX * 0.5f + 0.5f) * Width)));
+    const int py0 = std::max(0, static_cast<int>(std::floor((minY * 0.5f + 0.5f) * Height)));
+    const int py1 = std::min(Height - 1, static_cast<int>(std::floor((maxY * 0.5f + 0.5f) * Height)));
+    const float nearest = minZ * 0.5f + 0.5f;
+
+    // Gröbstes Level, auf dem das Rechteck höchstens 2x2 Texel überdeckt
+    int level = 0;
+    while (level < LevelCount - 1 && ((px1 >> level) - (px0 >> level) > 1 || (py1 >> level) - (py0 >> level) > 1)) {
+        ++level;
+    }
+    for (int y = py0 >> level; y <= (py1 >> level); ++y) {
+        for (int x = px0 >> level; x <= (px1 >> level); ++x) {
+            if (nearest <= GetHiZ(level, x, y)) return false;
+        }
+    }
+    return true;
+}
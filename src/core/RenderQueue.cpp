@@ -0,0 +1,101 @@
+#include "../../include/core/RenderQueue.hpp"
+#include <algorithm>
+#include <cstring>
+
+uint64_t RenderQueue::MakeKey(uint32_t shaderId, uint32_t geometryId, MaterialId materialId, float depth01) {
+    float d = std::clamp(depth01, 0.0f, 1.0f);
+    uint64_t depthBits = static_cast<uint64_t>(d * 65535.0f);
+    return (static_cast<uint64_t>(shaderId   & 0xFFu)     << 56) |
+           (static_cast<uint64_t>(geometryId & 0xFFFFFFu) << 32) |
+           (depthBits << 16) |
+           static_cast<uint64_t>(materialId);
+}
+
+void RenderQueue::Clear() {
+    // Nur die Größe zurücksetzen, Kapazität bleibt für den nächsten Frame erhalten
+    items.clear();
+    instances.clear();
+}
+
+void RenderQueue::Reserve(size_t count) {
+    items.reserve(count);
+    scratch.reserve(count);
+    instances.reserve(count);
+}
+
+void RenderQueue::Push(Mesh* mesh, uint32_t geometry, const InstanceData& instance, uint64_t key) {
+    DrawItem item;
+    item.key = key;
+    item.mesh = mesh;
+    item.geometry = geometry;
+    item.instanceIndex = static_cast<uint32_t>(instances.size());
+    item.material = static_cast<MaterialId>(instance.material);
+    const GeometryArena::Range& range = GeometryArena::Instance().Get(geometry);
+    instances.push_back(IsCompactFormat(range.format) ? range.Dequantize(instance) : instance);
+    items.push_back(item);
+}
+
+void RenderQueue::Sort() {
+    const size_t n = items.size();
+    if (n < 2) return;
+    scratch.resize(n);
+
+    // Histogramme für alle 8 Bytes in einem Durchlauf
+    uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const DrawItem& item : items) {
+        uint64_t k = item.key;
+        for (int b = 0; b < 8; ++b) {
+            ++histograms[b][(k >> (b * 8)) & 0xFF];
+        }
+    }
+
+    DrawItem* src = items.data();
+    DrawItem* dst = scratch.data();
+    for (int b = 0; b < 8; ++b) {
+        uint32_t* hist = histograms[b];
+        // Byte ist bei allen Keys gleich -> Pass überspringen (häufig bei Shader/Material)
+        if (hist[(src[0].key >> (b * 8)) & 0xFF] == n) continue;
+
+        uint32_t offsets[256];
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; ++i) {
+            offsets[i] = sum;
+            sum += hist[i];
+        }
+        const int shift = b * 8;
+        for (size_t i = 0; i < n; ++i) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    // Ergebnis liegt ggf. im Scratch-Buffer -> Buffer tauschen statt kopieren
+    if (src != items.data()) items.swap(scratch);
+}
+
+const std::vector<RenderQueue::Batch>& RenderQueue::BuildBatches() {
+    batches.clear();
+    const uint32_t n = static_cast<uint32_t>(items.size());
+    uint32_t i = 0;
+    while (i < n) {
+        Batch batch;
+        batch.mesh = items[i].mesh;
+        batch.geometry = items[i].geometry;
+        batch.format = GeometryArena::Instance().Get(batch.geometry).format;
+        batch.first = i;
+        const uint64_t key = items[i].key;
+        batch.order = static_cast<uint32_t>(((key >> 56) << 16) | ((key >> 16) & 0xFFFFu));
+        while (i < n && items[i].geometry == batch.geometry) ++i;
+        batch.count = i - batch.first;
+        batches.push_back(batch);
+    }
+    std::sort(batches.begin(), batches.end(), [](const Batch& a, const Batch& b) {
+        if (a.format != b.format) return a.format < b.format;
+        return a.order < b.order;
+    });
+    return batches;
+}
+
+void RenderQueue::WriteInstanceData(InstanceData* dst) const {
+    for (const DrawItem& item : items) *dst++ = instances[item.instanceIndex];
+}
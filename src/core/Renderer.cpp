@@ -8,12 +8,41 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include <sstream>
 #include <thread>
-#include <map>
+#include <chrono>
 #include "../../include/core/MonitoringMetrics.hpp"
+#include "../../include/core/JobSystem.hpp"
+#include "../../include/core/ResourceManager.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+    // Matrix dessen, was die GPU zeichnet: Instanzdaten ohne Scherung, Rotation so quantisiert wie im Shader.
+    // Culling und Occluder nutzen sie statt der Welt-Matrix, damit sie zur gezeichneten Form passen.
+    glm::mat4 DrawnMatrix(const WorldTransformComponent& transform) {
+        const glm::quat rotation = InstanceData::Make(transform.worldPosition, transform.worldRotation,
+                                                      transform.worldScale, 0).Rotation();
+        const glm::mat4 model = glm::translate(glm::mat4(1.0f), transform.worldPosition) * glm::mat4_cast(rotation);
+        return glm::scale(model, transform.worldScale);
+    }
+}
 
 Renderer::Renderer(Window& win, Scene& sc, std::shared_ptr<Shader> sh, Camera& cam, UI& ui, InputSystem* inputSys)
         : window(win), scene(sc), shader(sh), camera(cam), ui(ui), inputSystem(inputSys) {
     glEnable(GL_DEPTH_TEST);
+    instanceRing.Init(1024 * sizeof(InstanceData));
+    cameraUbo.Init(sizeof(CameraBlock), UniformBinding::Camera);
+    lightUbo.Init(sizeof(LightBlock), UniformBinding::Lights);
+    lightClusterer.Init();
+    gpuTimer.Init();
+    // Transform Feedback müsste die Anzahl pro Batch jeden Frame blockierend zurücklesen -> ohne Compute kein GPU-Culling
+    if (GLCapabilities::Get().computeShader && GLCapabilities::Get().multiDrawIndirect) gpuCuller.Init();
+    gBufferShader = ResourceManager::GetShader("shaders/StandardLit.vert", "shaders/GBuffer.frag");
+    deferredLightingShader = ResourceManager::GetShader("shaders/Fullscreen.vert", "shaders/DeferredLighting.frag");
+    depthShader = ResourceManager::GetShader("shaders/DepthOnly.vert", "shaders/DepthOnly.frag");
+    // Vollbild-Dreieck kommt aus gl_VertexID, Core Profile verlangt trotzdem ein VAO
+    glGenVertexArrays(1, &fullscreenVAO);
 
     // Start im Editor-Modus: Cursor frei, keine Kamera-Eingabe
     paused = true;
@@ -72,6 +101,7 @@ void Renderer::CreateViewportFBO(int width, int height) {
         std::cout << "Framebuffer nicht komplett!" << std::endl;
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CreateGBuffer(width, height);
 }
 
 void Renderer::DeleteViewportFBO() {
@@ -81,120 +111,491 @@ void Renderer::DeleteViewportFBO() {
     viewportTexture = 0;
     viewportRBO = 0;
     viewportFBO = 0;
+    DeleteGBuffer();
+}
+
+void Renderer::CreateGBuffer(int width, int height) {
+    if (gBufferFBO) DeleteGBuffer();
+
+    glGenFramebuffers(1, &gBufferFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, gBufferFBO);
+
+    auto attach = [&](GLuint& tex, GLenum internalFormat, GLenum format, GLenum type, GLenum attachment) {
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, tex, 0);
+    };
+    attach(gAlbedoSpec, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, GL_COLOR_ATTACHMENT0);      // rgb = Albedo, a = Specular
+    attach(gNormal, GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, GL_COLOR_ATTACHMENT1);          // xyz = Normale (Welt), w = Shininess
+    // Gleiches Format wie das Viewport-RBO, damit die Tiefe per Blit übernommen werden kann
+    attach(gDepth, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, GL_DEPTH_STENCIL_ATTACHMENT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    const GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "[Renderer] G-Buffer nicht komplett!" << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-glm::mat4 ComputeModelMatrix(const GameObject& obj) {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, obj.GetPosition());
-    model *= glm::mat4_cast(obj.GetRotation());
-    model = glm::scale(model, obj.GetScale());
-    return model;
+void Renderer::DeleteGBuffer() {
+    if (gAlbedoSpec) glDeleteTextures(1, &gAlbedoSpec);
+    if (gNormal) glDeleteTextures(1, &gNormal);
+    if (gDepth) glDeleteTextures(1, &gDepth);
+    if (gBufferFBO) glDeleteFramebuffers(1, &gBufferFBO);
+    gAlbedoSpec = gNormal = gDepth = 0;
+    gBufferFBO = 0;
 }
 
 void Renderer::UpdateMeshCache() {
-    if (!meshesDirty) return;
+    if (cachedMeshRevision == scene.GetRevision()) return;
     cachedMeshes.clear();
-    for (auto& obj : scene.GetObjects()) {
-        if (auto* cube = dynamic_cast<Cube*>(obj.get())) {
-            if (cube->GetMesh()) cachedMeshes.push_back(cube->GetMesh().get());
-        } else if (auto* plane = dynamic_cast<Plane*>(obj.get())) {
-            if (plane->GetMesh()) cachedMeshes.push_back(plane->GetMesh().get());
-        }
+    for (const auto& [mesh, indices] : scene.GetRenderablesByMesh()) {
+        cachedMeshes.push_back(mesh);
     }
-    meshesDirty = false;
+    cachedMeshRevision = scene.GetRevision();
 }
 
-void Renderer::SetProjectionMatrix(const glm::mat4& projection, const glm::mat4& view) {
-    shader->SetMat4("projection", projection);
-    shader->SetMat4("view", view);
-    shader->SetVec3("viewPos", camera.position);
+void Renderer::UpdateCameraBlock(float aspect) {
+    CameraBlock block;
+    block.view = camera.GetViewMatrix();
+    block.projection = camera.GetProjectionMatrix(aspect);
+    block.viewProjection = block.projection * block.view;
+    block.invViewProjection = glm::inverse(block.viewProjection);
+    block.position = glm::vec4(camera.position, 1.0f);
+    block.clipPlanes = glm::vec4(camera.GetNear(), camera.GetFar(),
+                                 static_cast<float>(viewportWidth), static_cast<float>(viewportHeight));
+    // Steht die Kamera still, entfällt der Upload
+    cameraUbo.Update(block);
 }
 
 void Renderer::SetMaterials() {
-    shader->SetFloat("material.shininess", 32.0f);
-    shader->SetInt("material.diffuse", 0);
-    shader->SetInt("material.specular", 1);
+    // Neue Materialien bzw. neu befüllte Texture-Arrays (Mipmaps) vor dem ersten Draw hochladen
+    ResourceManager::UploadMaterials();
 }
 
-void Renderer::SetLighting(Shader& shader) {
-    int pointLightIdx = 0;
-    int numPointLights = 0;
-    std::vector<Light*> pointLights;
-    Light* dirLight = nullptr;
-    // SpotLights
-    int spotLightIdx = 0;
-    std::vector<SpotLight*> spotLights;
-
-    for (const auto& obj : scene.GetObjects()) {
-        if (auto* light = dynamic_cast<Light*>(obj.get())) {
-            switch (light->type) {
-                case Light::Type::Point:
-                    if (pointLightIdx < 32) { pointLights.push_back(light); ++pointLightIdx; }
-                    break;
-                case Light::Type::Directional:
-                    if (!dirLight) dirLight = light;
-                    break;
-                case Light::Type::Spot:
-                    if (spotLightIdx < 16) { spotLights.push_back(static_cast<SpotLight*>(light)); ++spotLightIdx; }
-                    break;
-            }
+void Renderer::SetLighting(float aspect) {
+    // CPU-seitig packen (billig, keine GL-Aufrufe); hochgeladen wird nur, wenn sich
+    // die Lichtmenge oder ein Parameter gegenüber dem letzten Upload geändert hat.
+    // Lichter kommen aus dem dichten LightComponent-Pool, kein Typ-Dispatch über alle Objekte.
+    LightBlock block{};
+    bool hasDirLight = false;
+    clusterLights.clear();
+    EntityRegistry::Instance().View<LightComponent>().Each([&](Entity, LightComponent& component) {
+        Light* light = component.light;
+        switch (light->type) {
+            case Light::Type::Point:
+                static_cast<PointLight*>(light)->Pack(clusterLights.emplace_back());
+                break;
+            case Light::Type::Spot:
+                static_cast<SpotLight*>(light)->Pack(clusterLights.emplace_back());
+                break;
+            case Light::Type::Directional:
+                // Der Shader kennt nur ein gerichtetes Licht: das erste im Pool gewinnt
+                if (!hasDirLight) static_cast<DirectionalLight*>(light)->Pack(block.dirLight);
+                hasDirLight = true;
+                break;
         }
-    }
-    numPointLights = static_cast<int>(pointLights.size());
+    });
+    lightClusterer.Build(clusterLights, camera.GetViewMatrix(), camera.GetProjectionMatrix(aspect),
+                         camera.GetNear(), camera.GetFar());
+    lightClusterer.Upload(clusterLights);
+
+    block.counts[0] = static_cast<int32_t>(lightClusterer.GetLightCount());
+    block.counts[1] = static_cast<int32_t>(lightClusterer.GetVisibleLightCount());
+    lightUbo.Update(block);
+    MonitoringMetrics::Instance().RecordLightClusters(lightClusterer.GetLightCount(), lightClusterer.GetVisibleLightCount(),
+                                                      lightClusterer.GetIndexCount(), lightClusterer.GetBuildMs());
+}
+
+bool Renderer::UseGpuCulling() const {
+    return ui.GetRenderSettings().gpuCulling && gpuCuller.GetMode() == GpuCuller::Mode::Compute;
+}
 
-    // Upload point lights
-    for (int i = 0; i < numPointLights; ++i) {
-        pointLights[i]->UploadToShader(&shader, i);
+void Renderer::BuildRenderQueue(float aspect) {
+    JobSystem& jobs = JobSystem::Instance();
+    size_t count = 0;
+
+    // Seriell: Views über die dichten Komponenten-Pools, kein Typ-Dispatch pro Objekt.
+    // Die Listen bleiben über Frames bestehen; ändert sich ein Eintrag nicht, bleibt auch seine
+    // Welt-AABB im Culler gültig, solange das Objekt sich nicht bewegt.
+    EntityRegistry& registry = EntityRegistry::Instance();
+    auto emit = [&](Mesh* mesh, Entity entity, const WorldTransformComponent& transform) {
+        const uint8_t occluder = registry.Has<OccluderComponent>(entity) ? 1 : 0;
+        if (count == cullMeshes.size()) {
+            cullMeshes.push_back(mesh);
+            cullEntities.push_back(entity);
+            cullTransforms.push_back(&transform);
+            cullVersions.push_back(0);
+            cullLods.push_back(0);
+            cullOccluders.push_back(occluder);
+        } else {
+            cullOccluders[count] = occluder;
+            if (cullMeshes[count] != mesh || cullEntities[count] != entity) {
+                cullMeshes[count] = mesh;
+                cullEntities[count] = entity;
+                cullVersions[count] = 0;
+                cullLods[count] = 0;
+            }
+            // Pools können sich seit dem letzten Frame umsortiert haben
+            cullTransforms[count] = &transform;
+        }
+        ++count;
+    };
+    registry.View<MeshRendererComponent, WorldTransformComponent>().Each(
+        [&](Entity e, MeshRendererComponent& renderer, WorldTransformComponent& transform) {
+            emit(renderer.mesh, e, transform);
+        });
+    registry.View<ModelRefComponent, WorldTransformComponent>().Each(
+        [&](Entity e, ModelRefComponent& ref, WorldTransformComponent& transform) {
+            // Import läuft noch: Platzhalter an der Stelle des Modells; fehlgeschlagene bleiben leer
+            const ModelAsset::State state = ref.model->GetState();
+            if (state == ModelAsset::State::Loading) {
+                if (!modelPlaceholder) {
+                    modelPlaceholder = ResourceManager::GetPrimitiveMesh(ResourceManager::Primitive::Cube,
+                                                                         ResourceManager::GetDefaultMaterial(),
+                                                                         &Cube::GetVertices, &Cube::GetIndices);
+                }
+                emit(modelPlaceholder.get(), e, transform);
+                return;
+            }
+            if (state != ModelAsset::State::Ready) return;
+            for (size_t i = 0; i < ref.model->GetMeshCount(); ++i) {
+                emit(ref.model->GetMeshAt(i), e, transform);
+            }
+        });
+    cullMeshes.resize(count);
+    cullEntities.resize(count);
+    cullTransforms.resize(count);
+    cullVersions.resize(count);
+    cullLods.resize(count);
+    cullOccluders.resize(count);
+
+    // Nur Boxen neu transformieren, deren Objekt seit dem letzten Frame eine neue Welt-Matrix hat
+    culler.Resize(count);
+    jobs.ParallelFor(0, count, 512, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const WorldTransformComponent& transform = *cullTransforms[i];
+            if (cullVersions[i] == transform.version) continue;
+            const Bounds& b = cullMeshes[i]->GetBounds();
+            culler.Set(i, b.min, b.max, DrawnMatrix(transform));
+            cullVersions[i] = transform.version;
+        }
+    });
+
+    const glm::mat4 view = camera.GetViewMatrix();
+    const glm::mat4 viewProj = camera.GetProjectionMatrix(aspect) * view;
+    size_t visibleCount = count;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    // Mit GPU-Culling gehen alle Instanzen in die Queue, getestet wird erst im Cull-Pass
+    if (frustumCulling && !UseGpuCulling()) {
+        Frustum frustum = Frustum::FromMatrix(viewProj);
+        cullVisibility.resize(count);
+        std::atomic<size_t> visible{0};
+        jobs.ParallelFor(0, count, 4096, [&](size_t begin, size_t end) {
+            visible += culler.CullRange(frustum, cullVisibility.data(), begin, end);
+        });
+        visibleCount = visible;
+    } else {
+        cullVisibility.assign(count, 1);
     }
-    shader.SetInt("numPointLights", numPointLights);
-
-    // Directional light (ein einziger)
-    if (dirLight) {
-        shader.SetVec3("dirLight.direction", dirLight->direction);
-        shader.SetVec3("dirLight.ambient",  dirLight->color * 0.1f);
-        shader.SetVec3("dirLight.diffuse",  dirLight->color * 0.8f);
-        shader.SetVec3("dirLight.specular", dirLight->color * 1.0f);
+    double cullMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    MonitoringMetrics::Instance().RecordCulling(visibleCount, count - visibleCount, cullMs);
+
+    // Occluder selbst werden nicht getestet (sie lägen bündig auf ihrer eigenen Tiefe)
+    size_t occludedCount = 0;
+    double occlusionTestMs = 0.0;
+    if (ui.GetRenderSettings().occlusionCulling) {
+        occlusionCuller.Begin(viewProj);
+        for (size_t i = 0; i < count; ++i) {
+            if (!cullOccluders[i] || !cullVisibility[i]) continue;
+            const Mesh::Occluder occluder = cullMeshes[i]->GetOccluder();
+            if (!occluder.positions) continue;
+            occlusionCuller.AddOccluder(occluder.positions, occluder.stride, occluder.vertexCount,
+                                        occluder.indices, occluder.indexCount, DrawnMatrix(*cullTransforms[i]));
+        }
+        occlusionCuller.Rasterize();
+
+        auto tTest = std::chrono::high_resolution_clock::now();
+        std::atomic<size_t> occluded{0};
+        jobs.ParallelFor(0, count, 1024, [&](size_t begin, size_t end) {
+            size_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                if (!cullVisibility[i] || cullOccluders[i]) continue;
+                if (occlusionCuller.IsOccluded(culler.GetCenter(i), culler.GetExtents(i))) {
+                    cullVisibility[i] = 0;
+                    ++local;
+                }
+            }
+            occluded += local;
+        });
+        occludedCount = occluded;
+        visibleCount -= occludedCount;
+        occlusionTestMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tTest).count();
+        MonitoringMetrics::Instance().RecordOcclusion(occludedCount, occlusionCuller.GetTriangleCount(),
+                                                      occlusionCuller.GetRasterMs(), occlusionTestMs);
     } else {
-        shader.SetVec3("dirLight.direction", glm::vec3(0));
-        shader.SetVec3("dirLight.ambient",  glm::vec3(0));
-        shader.SetVec3("dirLight.diffuse",  glm::vec3(0));
-        shader.SetVec3("dirLight.specular", glm::vec3(0));
+        MonitoringMetrics::Instance().RecordOcclusion(0, 0, 0.0, 0.0);
     }
 
-    // SpotLights
-    for (int i = 0; i < (int)spotLights.size(); ++i) {
-        spotLights[i]->UploadToShader(&shader, i);
+    // LOD: Fehler einer Stufe (Modell-Einheiten) auf Pixel projiziert, error * scale / distance * projScale.
+    // Gröber wird erst unterhalb von 80 % der Schwelle, feiner sofort darüber -> kein Flackern an der Grenze.
+    const RenderSettings& settings = ui.GetRenderSettings();
+    const float projScale = camera.GetProjectionMatrix(aspect)[1][1] * static_cast<float>(viewportHeight) * 0.5f;
+    const float lodThreshold = settings.lodErrorPixels;
+    size_t lodTriangles = 0, fullTriangles = 0, lodReduced = 0;
+
+    renderQueue.Clear();
+    renderQueue.Reserve(visibleCount);
+    const float invFar = 1.0f / camera.GetFar();
+    const uint32_t shaderId = shader->ID;
+    for (size_t i = 0; i < count; ++i) {
+        if (!cullVisibility[i]) continue;
+        Mesh* mesh = cullMeshes[i];
+        const WorldTransformComponent& transform = *cullTransforms[i];
+        const glm::mat4& model = transform.world;
+        size_t lod = 0;
+        const size_t lodCount = mesh->GetLodCount();
+        if (settings.lod && lodCount > 1) {
+            const float scale = std::sqrt(std::max({ glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                                     glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                                     glm::dot(glm::vec3(model[2]), glm::vec3(model[2])) }));
+            const float distance = glm::length(culler.GetCenter(i) - camera.position);
+            // Kamera innerhalb der Bounding-Sphere -> volle Auflösung
+            if (distance > mesh->GetBounds().radius * scale) {
+                const float pixelsPerUnit = scale * projScale / distance;
+                lod = std::min<size_t>(cullLods[i], lodCount - 1);
+                while (lod > 0 && mesh->GetLodError(lod) * pixelsPerUnit > lodThreshold) --lod;
+                while (lod + 1 < lodCount && mesh->GetLodError(lod + 1) * pixelsPerUnit <= lodThreshold * 0.8f) ++lod;
+            }
+        }
+        cullLods[i] = static_cast<uint8_t>(lod);
+        lodTriangles += mesh->GetLodIndexCount(lod) / 3;
+        fullTriangles += mesh->GetLodIndexCount(0) / 3;
+        if (lod > 0) ++lodReduced;
+
+        // Tiefe im View-Space (Kamera schaut entlang -Z), auf [0,1] normiert
+        float depth = -(view * model[3]).z * invFar;
+        const MaterialId material = mesh->GetMaterialId();
+        const uint32_t geometry = mesh->GetLodGeometry(lod);
+        uint64_t key = RenderQueue::MakeKey(shaderId, geometry, material, depth);
+        renderQueue.Push(mesh, geometry, InstanceData::Make(transform.worldPosition, transform.worldRotation,
+                                                            transform.worldScale, material), key);
     }
-    shader.SetInt("numSpotLights", (int)spotLights.size());
+    MonitoringMetrics::Instance().RecordLod(lodTriangles, fullTriangles, lodReduced);
 }
 
-void Renderer::RenderMeshes() {
-    std::map<Mesh*, std::vector<glm::mat4>> meshGroups;
-    for (auto& obj : scene.GetObjects()) {
-        Mesh* mesh = nullptr;
-        if (auto* asMesh = dynamic_cast<Mesh*>(obj.get())) {
-            mesh = asMesh;
-        } else if (auto* cube = dynamic_cast<Cube*>(obj.get())) {
-            mesh = cube->GetMesh().get();
-        } else if (auto* plane = dynamic_cast<Plane*>(obj.get())) {
-            mesh = plane->GetMesh().get();
-        } else if (auto* model = dynamic_cast<Model*>(obj.get())) {
-            // Alle Meshes des Models rendern
-            for (auto* modelMesh : model->GetMeshes()) {
-                meshGroups[modelMesh].push_back(ComputeModelMatrix(*model));
+void Renderer::RenderMeshes(float aspect, Shader& meshShader, const char* passName) {
+    using clock = std::chrono::high_resolution_clock;
+    auto t0 = clock::now();
+    BuildRenderQueue(aspect);
+    auto t1 = clock::now();
+    renderQueue.Sort();
+    auto t2 = clock::now();
+
+    const auto& batches = renderQueue.BuildBatches();
+
+    const bool gpuCulling = UseGpuCulling() && !batches.empty();
+
+    instanceBaseOffset = 0;
+    instanceSource = instanceRing.GetBuffer();
+    if (gpuCulling) {
+        // Alle Instanzen plus lokale AABB und Batch-Index zum Culler; die Draws lesen dessen Ausgabe
+        gpuCullInstances.resize(renderQueue.Size());
+        renderQueue.WriteInstanceData(gpuCullInstances.data());
+        gpuCullBounds.resize(renderQueue.Size());
+        const auto& items = renderQueue.Items();
+        for (size_t b = 0; b < batches.size(); ++b) {
+            // Kompakte Formate: die Instanz enthält die Dequantisierung -> Box in quantisierte Koordinaten
+            const GeometryArena::Range& range = GeometryArena::Instance().Get(batches[b].geometry);
+            const glm::vec3 invScale = glm::vec3(1.0f) / range.positionScale;
+            for (uint32_t i = batches[b].first; i < batches[b].first + batches[b].count; ++i) {
+                const Bounds& bounds = items[i].mesh->GetBounds();
+                gpuCullBounds[i] = { ((bounds.min + bounds.max) * 0.5f - range.positionOffset) * invScale,
+                                     static_cast<uint32_t>(b), (bounds.max - bounds.min) * 0.5f * invScale, 0.0f };
+            }
+        }
+        gpuCuller.Upload(gpuCullInstances.data(), gpuCullBounds.data(), gpuCullInstances.size());
+        instanceSource = gpuCuller.GetOutputBuffer();
+    } else {
+        // Alle Instanzen (Matrix + Material) in einem Rutsch in den Ring-Buffer, jede Gruppe zeichnet ab ihrem Offset
+        const size_t bytes = renderQueue.Size() * sizeof(InstanceData);
+        if (bytes > 0) {
+            instanceRing.Reserve(bytes);
+            if (auto* dst = static_cast<InstanceData*>(instanceRing.Map(bytes, instanceBaseOffset))) {
+                renderQueue.WriteInstanceData(dst);
+                instanceRing.Unmap();
+            } else {
+                // Map gescheitert (Treiber): den Frame trotzdem zeichnen, Daten über den Ersatz-Buffer
+                instanceStaging.resize(renderQueue.Size());
+                renderQueue.WriteInstanceData(instanceStaging.data());
+                instanceSource = instanceRing.UploadFallback(instanceStaging.data(), bytes);
+                instanceBaseOffset = 0;
             }
-            continue; // Model ist kein Mesh, daher überspringen
         }
-        if (mesh) {
-            meshGroups[mesh].push_back(ComputeModelMatrix(*obj));
+    }
+
+    if (!batches.empty() && GLCapabilities::Get().multiDrawIndirect) {
+        // baseInstance zeigt auf die erste Instanz des Batches, der Instanz-Pointer bleibt für alle gleich.
+        // Beim GPU-Culling startet instanceCount bei 0 und wird vom Compute-Shader hochgezählt.
+        indirectCommands.resize(batches.size());
+        for (size_t i = 0; i < batches.size(); ++i) {
+            const GeometryArena::Range& range = GeometryArena::Instance().Get(batches[i].geometry);
+            indirectCommands[i] = { range.indexCount, gpuCulling ? 0u : batches[i].count, range.firstIndex,
+                                    static_cast<int32_t>(range.baseVertex), batches[i].first };
         }
+        if (!indirectBuffer) glGenBuffers(1, &indirectBuffer);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, indirectCommands.size() * sizeof(DrawElementsIndirectCommand),
+                     indirectCommands.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+    if (gpuCulling) {
+        gpuTimer.Begin("GPU Cull");
+        gpuCuller.Cull(Frustum::FromMatrix(camera.GetProjectionMatrix(aspect) * camera.GetViewMatrix()), batches, indirectBuffer);
+        gpuTimer.End();
     }
-    for (auto& [mesh, matrices] : meshGroups) {
-        if (!matrices.empty()) {
-            mesh->SetModelMatrices(matrices);
-            mesh->DrawInstanced(*shader);
+    // Der Cull-Pass hat sein eigenes Programm gebunden
+    if (gpuCulling) meshShader.Use();
+
+    // Optionaler Depth-Pre-Pass: nur Positionen, keine Farbe. Danach shadet der Haupt-Pass
+    // per GL_EQUAL nur noch das jeweils vorderste Fragment.
+    const bool depthPrepass = ui.GetRenderSettings().depthPrepass && !batches.empty();
+    size_t drawCalls = 0;
+    if (depthPrepass) {
+        depthShader->Use();
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        gpuTimer.Begin("Depth Pre-Pass");
+        drawCalls += DrawBatches(*depthShader, true);
+        gpuTimer.End();
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+        meshShader.Use();
+    }
+    gpuTimer.Begin(passName, true);
+    drawCalls += DrawBatches(meshShader, false);
+    gpuTimer.End();
+    if (depthPrepass) {
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
+
+    double buildMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double sortMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    MonitoringMetrics::Instance().RecordRenderQueue(buildMs, sortMs, renderQueue.Size(), batches.size(), drawCalls);
+}
+
+size_t Renderer::DrawBatches(Shader& passShader, bool positionOnly) {
+    static constexpr UniformId CompactVertexUniform("compactVertex");
+    const auto& batches = renderQueue.Batches();
+    if (batches.empty()) return 0;
+
+    // Alle Meshes liegen in der GeometryArena: ein VAO-Bind pro Vertex-Format (Batches sind danach
+    // gruppiert), danach nur noch Offsets. Texturen liegen in Texture-Arrays und werden einmal gebunden;
+    // das Material kommt pro Instanz.
+    GeometryArena& arena = GeometryArena::Instance();
+    if (!positionOnly) ResourceManager::BindMaterials(passShader);
+
+    const bool multiDraw = GLCapabilities::Get().multiDrawIndirect;
+    if (multiDraw) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    size_t drawCalls = 0;
+    size_t runStart = 0;
+    while (runStart < batches.size()) {
+        const VertexFormat format = batches[runStart].format;
+        size_t runEnd = runStart + 1;
+        while (runEnd < batches.size() && batches[runEnd].format == format) ++runEnd;
+
+        if (positionOnly) {
+            arena.BindPositionStream(format);
+        } else {
+            arena.BindVertexFormat(format);
+            passShader.Set(CompactVertexUniform, IsCompactFormat(format) ? 1 : 0);
         }
+        const GLenum indexType = GeometryArena::GetIndexType(format);
+        const size_t indexSize = GeometryArena::GetIndexSize(format);
+
+        if (multiDraw) {
+            // Kein State-Wechsel zwischen den Batches eines Formats -> ein Aufruf pro Format
+            arena.SetInstanceBuffer(instanceSource, instanceBaseOffset);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (void*)(runStart * sizeof(DrawElementsIndirectCommand)),
+                                        static_cast<GLsizei>(runEnd - runStart), 0);
+            ++drawCalls;
+        } else {
+            for (size_t i = runStart; i < runEnd; ++i) {
+                const auto& batch = batches[i];
+                const GeometryArena::Range& range = arena.Get(batch.geometry);
+                arena.SetInstanceBuffer(instanceSource, instanceBaseOffset + batch.first * sizeof(InstanceData));
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount, indexType,
+                                                  (void*)(static_cast<size_t>(range.firstIndex) * indexSize),
+                                                  batch.count, range.baseVertex);
+                ++drawCalls;
+            }
+        }
+        runStart = runEnd;
     }
+    if (multiDraw) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    return drawCalls;
+}
+
+void Renderer::RenderForward(float aspect) {
+    shader->Use();
+    lightClusterer.Bind(*shader);
+    RenderMeshes(aspect, *shader, "Forward");
+}
+
+void Renderer::RenderDeferred(float aspect) {
+    static constexpr UniformId AlbedoSpecSampler("gAlbedoSpec");
+    static constexpr UniformId NormalSampler("gNormal");
+    static constexpr UniformId DepthSampler("gDepth");
+
+    // 1) Geometrie einmal in den G-Buffer, ohne Beleuchtung
+    glBindFramebuffer(GL_FRAMEBUFFER, gBufferFBO);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    gBufferShader->Use();
+    RenderMeshes(aspect, *gBufferShader, "G-Buffer");
+
+    // 2) Vollbild-Pass in den Viewport: jedes Pixel genau einmal pro Licht seines Clusters.
+    // Pixel ohne Geometrie werden verworfen, das Grid darunter bleibt erhalten.
+    glBindFramebuffer(GL_FRAMEBUFFER, viewportFBO);
+    deferredLightingShader->Use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, gNormal);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, gDepth);
+    glActiveTexture(GL_TEXTURE0);
+    deferredLightingShader->Set(AlbedoSpecSampler, 0);
+    deferredLightingShader->Set(NormalSampler, 1);
+    deferredLightingShader->Set(DepthSampler, 2);
+    lightClusterer.Bind(*deferredLightingShader);
+
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    gpuTimer.Begin("Lighting");
+    glBindVertexArray(fullscreenVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    gpuTimer.End();
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+
+    // Tiefe übernehmen, damit nachfolgende Passes wie im Forward-Pfad testen können
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, gBufferFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, viewportFBO);
+    glBlitFramebuffer(0, 0, viewportWidth, viewportHeight, 0, 0, viewportWidth, viewportHeight,
+                      GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, viewportFBO);
 }
 
 void Renderer::InitializeGrid() {
@@ -216,6 +617,12 @@ void Renderer::Render() {
         MonitoringMetrics& mon = MonitoringMetrics::Instance();
         mon.BeginFrameCpu();
         mon.BeginFrameGpu();
+        gpuTimer.BeginFrame();
+        for (const auto& pass : gpuTimer.GetResults()) {
+            mon.RecordGpuPass(pass.name, pass.ms);
+            if (pass.samples >= 0) mon.RecordShadedFragments(pass.samples, static_cast<size_t>(viewportWidth) * viewportHeight);
+        }
+        instanceRing.BeginFrame();
 
         deltaTime = frameStart - lastFrameTime;
         lastFrameTime = frameStart;
@@ -236,17 +643,37 @@ void Renderer::Render() {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         const float aspect = static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight);
 
+        UpdateCameraBlock(aspect);
+
         glDisable(GL_DEPTH_TEST); glDepthMask(GL_FALSE); glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gpuTimer.Begin("Grid");
         RenderGrid(aspect);
+        gpuTimer.End();
         glDisable(GL_BLEND); glDepthMask(GL_TRUE); glEnable(GL_DEPTH_TEST);
 
-        shader->Use();
-        SetProjectionMatrix(camera.GetProjectionMatrix(aspect), camera.GetViewMatrix());
+        {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            size_t updated = scene.UpdateTransforms();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+            mon.RecordTransformUpdate(updated, ms);
+        }
+
+        // Fertig geparste Modell-Importe hochladen (GL nur hier im Context-Thread), vor Materialien und Queue
+        ResourceManager::UpdateModelImports();
+        GeometryArena::Instance().Maintain();
         SetMaterials();
-        SetLighting(*shader);
-        RenderMeshes();
+        SetLighting(aspect);
+        if (ui.GetRenderSettings().path == RenderPath::Deferred) RenderDeferred(aspect);
+        else RenderForward(aspect);
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        instanceRing.EndFrame();
+        mon.RecordInstanceUpload(instanceRing.BytesThisFrame(), instanceRing.FenceWaitsThisFrame(), instanceRing.FenceWaitMsThisFrame(),
+                                 instanceRing.FallbacksThisFrame());
+        mon.RecordUniformUploads(Shader::ConsumeUniformCallCount(), Shader::ConsumeSkippedUniformCount(),
+                                 UniformBuffer::ConsumeUploadCount());
+        mon.RecordGeometryArena(GeometryArena::ConsumeBindCount(), GeometryArena::Instance().GetVertexBytes(),
+                                GeometryArena::Instance().GetIndexBytes());
         UpdateMeshCache();
 
         // Viewport JETZT zeichnen -> Hover-Status verfügbar
@@ -298,4 +725,5 @@ void Renderer::Render() {
         LimitFPS(frameStart, 300.0);
     }
     DeleteViewportFBO();
+    instanceRing.Shutdown();
 }
\ No newline at end of file
@@ -3,11 +3,50 @@
 //
 #include "../../include/core/ResourceManager.hpp"
 #include "stb_image.h"
+#include "../../include/core/JobSystem.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include "../../include/core/MeshCache.hpp"
+#include "../../include/objects/ModelAsset.hpp"
 #include "glad/glad.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    // Textur-Uploads können mitten im Frame passieren (z.B. Modell-Import aus der UI):
+    // FBO-Bindings und Scissor-Test für die Kopier-Blits sichern und danach wiederherstellen
+    struct FramebufferStateGuard {
+        GLint read = 0, draw = 0;
+        GLboolean scissor = GL_FALSE;
+        FramebufferStateGuard() {
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read);
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw);
+            scissor = glIsEnabled(GL_SCISSOR_TEST);
+            glDisable(GL_SCISSOR_TEST);
+        }
+        ~FramebufferStateGuard() {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, read);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw);
+            if (scissor) glEnable(GL_SCISSOR_TEST);
+        }
+    };
+}
 
 std::map<std::string, unsigned int> ResourceManager::textures;
 std::map<std::string, std::shared_ptr<Shader>> ResourceManager::shaders;
-std::map<std::string, std::shared_ptr<Model>> ResourceManager::models;
+std::map<std::string, std::shared_ptr<ModelAsset>> ResourceManager::models;
+std::vector<std::shared_ptr<ModelAsset>> ResourceManager::modelImports;
+JobCounter ResourceManager::modelImportJobs;
+std::map<std::pair<ResourceManager::Primitive, MaterialId>, std::shared_ptr<Mesh>> ResourceManager::primitives;
+std::map<std::string, TextureLayer> ResourceManager::textureLayers;
+ResourceManager::TextureArrayPool ResourceManager::textureArrays[ResourceManager::TextureArrayCount];
+unsigned int ResourceManager::copyFramebuffers[2] = { 0, 0 };
+std::map<MaterialDesc, std::shared_ptr<Material>> ResourceManager::materialCache;
+std::vector<GpuMaterial> ResourceManager::materials;
+unsigned int ResourceManager::materialBuffer = 0;
+unsigned int ResourceManager::materialTexture = 0;
+size_t ResourceManager::materialCapacity = 0;
+bool ResourceManager::materialsDirty = true;
 
 unsigned int ResourceManager::GetTexture(const std::string& path) {
     if (textures.count(path)) return textures[path];
@@ -16,6 +55,67 @@ unsigned int ResourceManager::GetTexture(const std::string& path) {
     unsigned char* data = stbi_load(path.c_str(), &w, &h, &c, 0);
     if (!data) return 0;
 
+    unsigned int tex = UploadTexture(data, w, h, c);
+    stbi_image_free(data);
+    textures[path] = tex;
+    return tex;
+}
+
+TextureLayer ResourceManager::GetTextureLayer(const std::string& path) {
+    auto it = textureLayers.find(path);
+    if (it != textureLayers.end()) return it->second;
+
+    int w, h, c;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &c, 4);
+    if (!data) return {};
+
+    TextureLayer layer = UploadTextureLayer(data, w, h);
+    stbi_image_free(data);
+    textureLayers[path] = layer;
+    return layer;
+}
+
+void ResourceManager::PreloadTextures(const std::vector<std::string>& paths) {
+    std::vector<std::string> pending;
+    for (const auto& path : paths) {
+        if (!textureLayers.count(path)) pending.push_back(path);
+    }
+    if (pending.empty()) return;
+    auto decoded = DecodeTextures(pending);
+    UploadTextures(decoded);
+}
+
+std::vector<ResourceManager::DecodedTexture> ResourceManager::DecodeTextures(const std::vector<std::string>& paths) {
+    std::vector<DecodedTexture> decoded;
+    for (const auto& path : paths) {
+        bool duplicate = std::any_of(decoded.begin(), decoded.end(), [&](const DecodedTexture& d) { return d.path == path; });
+        if (!duplicate) decoded.push_back({ path });
+    }
+
+    // stbi_load ist reine CPU-Arbeit und darf parallel laufen
+    JobSystem::Instance().ParallelFor(0, decoded.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& d = decoded[i];
+            int channels = 0;
+            d.data = { stbi_load(d.path.c_str(), &d.width, &d.height, &channels, 4), stbi_image_free };
+        }
+    });
+    return decoded;
+}
+
+void ResourceManager::UploadTextures(std::vector<DecodedTexture>& decoded) {
+    if (!GLCapabilities::IsContextThread()) {
+        std::cout << "[ResourceManager] UploadTextures outside the GL context thread, skipped" << std::endl;
+        return;
+    }
+    for (auto& d : decoded) {
+        if (!d.data || textureLayers.count(d.path)) continue;
+        textureLayers[d.path] = UploadTextureLayer(d.data.get(), d.width, d.height);
+        d.data.reset();
+    }
+}
+
+unsigned int ResourceManager::UploadTexture(unsigned char* data, int w, int h, int c) {
     unsigned int tex;
     glGenTextures(1, &tex);
     glBindTexture(GL_TEXTURE_2D, tex);
@@ -27,13 +127,172 @@ unsigned int ResourceManager::GetTexture(const std::string& path) {
     GLenum format = (c == 4) ? GL_RGBA : GL_RGB;
     glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
-    textures[path] = tex;
     return tex;
 }
 
+TextureLayer ResourceManager::UploadTextureLayer(const unsigned char* data, int w, int h) {
+    int array = 0;
+    int size = MinArraySize;
+    while (size < std::max(w, h) && size < MaxArraySize) {
+        size *= 2;
+        ++array;
+    }
+
+    TextureArrayPool& pool = textureArrays[array];
+    if (pool.layers == pool.capacity) GrowTextureArray(array, std::max(4u, pool.capacity * 2));
+    const uint32_t layer = pool.layers++;
+    pool.mipsDirty = true;
+
+    if (w == size && h == size) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, pool.texture);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return { static_cast<int16_t>(array), static_cast<uint16_t>(layer) };
+    }
+
+    // Andere Größe: über eine temporäre 2D-Textur per linearem Blit in den Layer skalieren
+    unsigned int source = 0;
+    glGenTextures(1, &source);
+    glBindTexture(GL_TEXTURE_2D, source);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    {
+        FramebufferStateGuard guard;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, copyFramebuffers[0]);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFramebuffers[1]);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, pool.texture, 0, layer);
+        glBlitFramebuffer(0, 0, w, h, 0, 0, size, size, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, 0, 0, 0);
+    }
+    glDeleteTextures(1, &source);
+    return { static_cast<int16_t>(array), static_cast<uint16_t>(layer) };
+}
+
+void ResourceManager::GrowTextureArray(int array, uint32_t newCapacity) {
+    TextureArrayPool& pool = textureArrays[array];
+    const int size = MinArraySize << array;
+    if (!copyFramebuffers[0]) glGenFramebuffers(2, copyFramebuffers);
+
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, newCapacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Vorhandene Layer umkopieren (GL 3.3 hat kein glCopyImageSubData), Mipmaps entstehen in UploadMaterials neu
+    if (pool.texture) {
+        FramebufferStateGuard guard;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, copyFramebuffers[0]);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFramebuffers[1]);
+        for (uint32_t layer = 0; layer < pool.layers; ++layer) {
+            glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, pool.texture, 0, layer);
+            glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture, 0, layer);
+            glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+        glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, 0, 0, 0);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, 0, 0, 0);
+        glDeleteTextures(1, &pool.texture);
+    }
+    pool.texture = texture;
+    pool.capacity = newCapacity;
+    pool.mipsDirty = true;
+}
+
+std::shared_ptr<Material> ResourceManager::GetMaterial(const MaterialDesc& desc) {
+    if (materials.empty()) {
+        // ID 0 ist das Standardmaterial
+        auto fallback = std::make_shared<Material>(0, MaterialDesc{}, TextureLayer{}, TextureLayer{});
+        materials.push_back(fallback->GetGpuData());
+        materialCache.emplace(MaterialDesc{}, fallback);
+        materialsDirty = true;
+    }
+    auto it = materialCache.find(desc);
+    if (it != materialCache.end()) return it->second;
+
+    if (materials.size() >= MaxMaterials) {
+        std::cout << "[ResourceManager] Material-Limit erreicht (" << MaxMaterials << "), nutze Standardmaterial" << std::endl;
+        return GetDefaultMaterial();
+    }
+
+    TextureLayer diffuse = desc.diffusePath.empty() ? TextureLayer{} : GetTextureLayer(desc.diffusePath);
+    TextureLayer specular = desc.specularPath.empty() ? TextureLayer{} : GetTextureLayer(desc.specularPath);
+    auto material = std::make_shared<Material>(static_cast<MaterialId>(materials.size()), desc, diffuse, specular);
+    materials.push_back(material->GetGpuData());
+    materialCache.emplace(desc, material);
+    materialsDirty = true;
+    return material;
+}
+
+std::shared_ptr<Material> ResourceManager::GetDefaultMaterial() {
+    return GetMaterial(MaterialDesc{});
+}
+
+void ResourceManager::UploadMaterials() {
+    for (TextureArrayPool& pool : textureArrays) {
+        if (!pool.mipsDirty) continue;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, pool.texture);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        pool.mipsDirty = false;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    if (!materialsDirty) return;
+    if (!materialBuffer) {
+        glGenBuffers(1, &materialBuffer);
+        glGenTextures(1, &materialTexture);
+    }
+    const size_t bytes = materials.size() * sizeof(GpuMaterial);
+    glBindBuffer(GL_TEXTURE_BUFFER, materialBuffer);
+    if (bytes > materialCapacity) {
+        materialCapacity = std::max(bytes, materialCapacity * 2);
+        glBufferData(GL_TEXTURE_BUFFER, materialCapacity, nullptr, GL_STATIC_DRAW);
+        // Neuer Datenspeicher -> Textur neu anhängen
+        glBindTexture(GL_TEXTURE_BUFFER, materialTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, materialBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, materials.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    materialsDirty = false;
+}
+
+void ResourceManager::BindMaterials(Shader& shader) {
+    static constexpr UniformId arraySamplers[TextureArrayCount] = {
+        UniformId("textureArray0"), UniformId("textureArray1"), UniformId("textureArray2"),
+        UniformId("textureArray3"), UniformId("textureArray4"), UniformId("textureArray5")
+    };
+    static constexpr UniformId MaterialSampler("materialData");
+
+    for (int i = 0; i < TextureArrayCount; ++i) {
+        glActiveTexture(GL_TEXTURE0 + TextureArrayUnit + i);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrays[i].texture);
+        shader.Set(arraySamplers[i], TextureArrayUnit + i);
+    }
+    glActiveTexture(GL_TEXTURE0 + MaterialUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, materialTexture);
+    shader.Set(MaterialSampler, MaterialUnit);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+size_t ResourceManager::GetTextureArrayBytes() {
+    size_t bytes = 0;
+    for (int i = 0; i < TextureArrayCount; ++i) {
+        const size_t size = static_cast<size_t>(MinArraySize) << i;
+        // Level 0 plus ca. ein Drittel für die Mip-Kette
+        bytes += size * size * 4 * textureArrays[i].capacity * 4 / 3;
+    }
+    return bytes;
+}
+
 void ResourceManager::ClearTextures() {
+    // Nur die einzelnen 2D-Texturen; die Array-Pools bleiben, Materialien verweisen auf ihre Layer
     for (auto& [_, tex] : textures) glDeleteTextures(1, &tex);
     textures.clear();
 }
@@ -51,14 +310,71 @@ void ResourceManager::ClearShaders() {
     shaders.clear();
 }
 
-std::shared_ptr<Model> ResourceManager::GetModel(const std::string& path) {
+std::shared_ptr<ModelAsset> ResourceManager::GetModelAsset(const std::string& path) {
     auto it = models.find(path);
     if (it != models.end()) return it->second;
-    auto model = std::make_shared<Model>(path);
-    models[path] = model;
-    return model;
+    auto asset = std::make_shared<ModelAsset>(path, MeshCache::CacheDirectory());
+    models[path] = asset;
+    modelImports.push_back(asset);
+    // Parsen und Aufbereiten im Hintergrund, nie in einem Wait() des Frames. Der Job hält nur einen
+    // rohen Zeiger: modelImports gibt das Asset erst nach cpuDone frei, und zwar in UpdateModelImports
+    // bzw. CancelModelImports im Context-Thread (~Mesh gibt Arena-Bereiche frei)
+    ModelAsset* importing = asset.get();
+    JobSystem::Instance().RunBackground([importing] { importing->ImportCpu(); }, &modelImportJobs);
+    return asset;
 }
 
 void ResourceManager::ClearModels() {
     models.clear();
+}
+
+void ResourceManager::UpdateModelImports(double budgetMs) {
+    if (modelImports.empty()) return;
+    if (!GLCapabilities::IsContextThread()) {
+        std::cout << "[ResourceManager] UpdateModelImports outside the GL context thread, skipped" << std::endl;
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < modelImports.size();) {
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::shared_ptr<ModelAsset> asset = modelImports[i];
+        // Budget aufgebraucht: Rest im nächsten Frame (ein angefangener Import bekommt immer einen Schritt)
+        if (elapsed >= budgetMs && i > 0) break;
+        if (!asset->UploadStep(budgetMs - elapsed)) {
+            ++i;
+            continue;
+        }
+        modelImports.erase(modelImports.begin() + static_cast<std::ptrdiff_t>(i));
+        if (!asset->IsReady()) {
+            auto it = models.find(asset->GetPath());
+            if (it != models.end() && it->second == asset) models.erase(it);
+        }
+    }
+}
+
+void ResourceManager::CancelModelImports() {
+    for (const auto& asset : modelImports) asset->Cancel();
+    if (JobSystem::Instance().IsInitialized()) JobSystem::Instance().Wait(modelImportJobs);
+    // Abgebrochen schließt UploadStep ohne GL-Arbeit ab; fertig geparste, die schon Ready sind, bleiben
+    for (const auto& asset : modelImports) {
+        asset->UploadStep(0.0);
+        if (!asset->IsReady()) models.erase(asset->GetPath());
+    }
+    modelImports.clear();
+}
+
+std::shared_ptr<Mesh> ResourceManager::GetPrimitiveMesh(Primitive primitive, const std::shared_ptr<Material>& material,
+                                                        std::vector<Vertex> (*vertices)(), std::vector<unsigned int> (*indices)()) {
+    const std::shared_ptr<Material>& resolved = material ? material : GetDefaultMaterial();
+    const auto key = std::make_pair(primitive, resolved->GetId());
+    auto it = primitives.find(key);
+    if (it != primitives.end()) return it->second;
+    auto mesh = std::make_shared<Mesh>(vertices(), indices(), resolved);
+    primitives.emplace(key, mesh);
+    return mesh;
+}
+
+void ResourceManager::ClearPrimitives() {
+    // Objekte, die noch eine Form halten, behalten ihren Mesh; neue bekommen einen frischen
+    primitives.clear();
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../../include/core/Scene.hpp"
+#include "../../include/objects/Shapes.hpp"
+#include <algorithm>
 #include <fstream>
 
 using json = nlohmann::json;
@@ -9,15 +11,114 @@ Scene::~Scene() {
 
 void Scene::AddObject(std::shared_ptr<GameObject> obj) {
     objects.push_back(obj);
+    RegisterObject(objects.size() - 1);
+    ++revision;
+}
+
+void Scene::RegisterObject(size_t index) {
+    GameObject& obj = *objects[index];
+    EntityRegistry& registry = EntityRegistry::Instance();
+    const Entity e = obj.GetEntity();
+    switch (obj.GetType()) {
+        case ObjectType::Shape:
+        case ObjectType::Cube:
+        case ObjectType::Plane: {
+            auto& shape = static_cast<Shapes&>(obj);
+            if (shape.mesh) {
+                renderablesByMesh[shape.mesh.get()].push_back(index);
+                registry.Add<MeshRendererComponent>(e, { shape.mesh.get() });
+            }
+            break;
+        }
+        case ObjectType::Model:
+            models.push_back(index);
+            registry.Add<ModelRefComponent>(e, { static_cast<Model*>(&obj) });
+            break;
+        case ObjectType::PointLight:
+            pointLights.push_back(index);
+            registry.Add<LightComponent>(e, { static_cast<Light*>(&obj) });
+            break;
+        case ObjectType::SpotLight:
+            spotLights.push_back(index);
+            registry.Add<LightComponent>(e, { static_cast<Light*>(&obj) });
+            break;
+        case ObjectType::DirectionalLight:
+            directionalLights.push_back(index);
+            registry.Add<LightComponent>(e, { static_cast<Light*>(&obj) });
+            break;
+        case ObjectType::Generic:
+            break;
+    }
+}
+
+void Scene::RemoveComponents(const GameObject& obj) {
+    EntityRegistry& registry = EntityRegistry::Instance();
+    const Entity e = obj.GetEntity();
+    registry.Remove<MeshRendererComponent>(e);
+    registry.Remove<ModelRefComponent>(e);
+    registry.Remove<LightComponent>(e);
+    registry.Remove<OccluderComponent>(e);
+}
+
+void Scene::SetOccluder(const GameObject& obj, bool occluder) {
+    EntityRegistry& registry = EntityRegistry::Instance();
+    const Entity e = obj.GetEntity();
+    if (!occluder) {
+        registry.Remove<OccluderComponent>(e);
+        return;
+    }
+    // Nur Objekte, die der Renderer auch zeichnet, haben Dreiecke zum Rastern
+    if (!registry.Has<MeshRendererComponent>(e) && !registry.Has<ModelRefComponent>(e)) return;
+    if (!registry.Has<OccluderComponent>(e)) registry.Add<OccluderComponent>(e);
+}
+
+bool Scene::IsOccluder(const GameObject& obj) const {
+    return EntityRegistry::Instance().Has<OccluderComponent>(obj.GetEntity());
+}
+
+void Scene::UnregisterObject(size_t index) {
+    RemoveComponents(*objects[index]);
+
+    // Eintrag entfernen und alle dahinterliegenden Indizes nachziehen
+    auto fixup = [index](std::vector<size_t>& list) {
+        list.erase(std::remove(list.begin(), list.end(), index), list.end());
+        for (size_t& i : list) {
+            if (i > index) --i;
+        }
+    };
+    fixup(pointLights);
+    fixup(spotLights);
+    fixup(directionalLights);
+    fixup(models);
+    for (auto it = renderablesByMesh.begin(); it != renderablesByMesh.end();) {
+        fixup(it->second);
+        if (it->second.empty()) it = renderablesByMesh.erase(it);
+        else ++it;
+    }
 }
 
 void Scene::RemoveObjectAt(size_t index) {
-    if (index < objects.size())
-        objects.erase(objects.begin() + index);
+    if (index >= objects.size()) return;
+    // Aus der Hierarchie lösen, damit keine Objekte außerhalb der Scene referenziert werden
+    GameObject* obj = objects[index].get();
+    obj->SetParent(nullptr);
+    while (!obj->GetChildren().empty()) {
+        obj->GetChildren().back()->SetParent(nullptr);
+    }
+    UnregisterObject(index);
+    objects.erase(objects.begin() + index);
+    ++revision;
 }
 
 void Scene::Clear() {
+    for (auto& obj : objects) RemoveComponents(*obj);
     objects.clear();
+    renderablesByMesh.clear();
+    pointLights.clear();
+    spotLights.clear();
+    directionalLights.clear();
+    models.clear();
+    ++revision;
 }
 
 std::vector<std::shared_ptr<GameObject>>& Scene::GetObjects() {
@@ -28,6 +129,15 @@ const std::vector<std::shared_ptr<GameObject>>& Scene::GetObjects() const {
     return objects;
 }
 
+size_t Scene::UpdateTransforms() {
+    size_t updated = 0;
+    for (auto& obj : objects) {
+        // Kinder werden über ihre Wurzel erreicht
+        if (!obj->GetParent()) updated += obj->UpdateTransform();
+    }
+    return updated;
+}
+
 /*void Scene::Save(const std::string& filename) const {
     json j;
     j["objects"] = json::array();
@@ -54,8 +164,6 @@ const std::vector<std::shared_ptr<GameObject>>& Scene::GetObjects() const {
                 entry["intensity"] = light->intensity;
         } else if (auto* model = dynamic_cast<Model*>(obj.get())) {
             entry["type"] = "Model";
-            // Modellpfad speichern (ggf. Methode GetPath() ergänzen)
-            // Hier als Platzhalter:
             entry["modelPath"] = model->GetPath();
         } else {
             entry["type"] = "Unknown";
@@ -90,8 +198,7 @@ void Scene::Load(const std::string& filename) {
             obj = light;
         } else if (type == "Model") {
             std::string path = entry.value("modelPath", "");
-            auto model = ResourceManager::GetModel(path);
-            obj = model;
+            obj = std::make_shared<Model>(ResourceManager::GetModelAsset(path));
         } else {
             continue; // Unbekannter Typ
         }
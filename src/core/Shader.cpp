@@ -3,9 +3,16 @@
 //
 #include "glad/glad.h"
 #include "../../include/core/Shader.hpp"
+#include "../../include/core/UniformBlocks.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+size_t Shader::uniformCalls = 0;
+size_t Shader::skippedUniformCalls = 0;
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     std::string vertexCode = LoadShaderCode(vertexPath);
@@ -14,12 +21,32 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     unsigned int vertex = CompileShader(vertexCode.c_str(), GL_VERTEX_SHADER);
     unsigned int fragment = CompileShader(fragmentCode.c_str(), GL_FRAGMENT_SHADER);
 
-    LinkProgram(vertex, fragment);
+    LinkProgram({ vertex, fragment });
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 }
 
+Shader::Shader(const char* computePath) {
+    std::string computeCode = LoadShaderCode(computePath);
+    unsigned int compute = CompileShader(computeCode.c_str(), GL_COMPUTE_SHADER);
+    LinkProgram({ compute });
+    glDeleteShader(compute);
+}
+
+Shader::Shader(const char* vertexPath, const char* geometryPath, const std::vector<const char*>& feedbackVaryings) {
+    std::string vertexCode = LoadShaderCode(vertexPath);
+    std::string geometryCode = LoadShaderCode(geometryPath);
+
+    unsigned int vertex = CompileShader(vertexCode.c_str(), GL_VERTEX_SHADER);
+    unsigned int geometry = CompileShader(geometryCode.c_str(), GL_GEOMETRY_SHADER);
+
+    LinkProgram({ vertex, geometry }, feedbackVaryings);
+
+    glDeleteShader(vertex);
+    glDeleteShader(geometry);
+}
+
 std::string Shader::LoadShaderCode(const char* path) {
     std::ifstream file;
     file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -50,10 +77,14 @@ unsigned int Shader::CompileShader(const char* code, int type) {
     return shader;
 }
 
-void Shader::LinkProgram(unsigned int vertex, unsigned int fragment) {
+void Shader::LinkProgram(std::initializer_list<unsigned int> stages, const std::vector<const char*>& feedbackVaryings) {
     ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
+    for (unsigned int stage : stages) glAttachShader(ID, stage);
+    // Muss vor dem Linken feststehen
+    if (!feedbackVaryings.empty()) {
+        glTransformFeedbackVaryings(ID, static_cast<GLsizei>(feedbackVaryings.size()), feedbackVaryings.data(),
+                                    GL_INTERLEAVED_ATTRIBS);
+    }
     glLinkProgram(ID);
 
     int success;
@@ -62,9 +93,145 @@ void Shader::LinkProgram(unsigned int vertex, unsigned int fragment) {
     if (!success) {
         glGetProgramInfoLog(ID, 512, NULL, infoLog);
         std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        return;
+    }
+
+    ReflectUniforms();
+
+    // Gemeinsame Blöcke an feste Binding-Punkte hängen (GLSL 330 kennt kein layout(binding))
+    BindUniformBlock("CameraBlock", UniformBinding::Camera);
+    BindUniformBlock("LightBlock", UniformBinding::Lights);
+}
+
+void Shader::ReflectUniforms() {
+    uniformTable.clear();
+    uniformBlocks.clear();
+
+    // Einzelne Uniforms (Block-Member haben keine Location und werden übersprungen)
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(std::max(maxLength, 1));
+
+    struct Entry { std::string name; int location; unsigned int type; };
+    std::vector<Entry> entries;
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, i, maxLength, &length, &size, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), length);
+        int location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0) continue;
+
+        // Arrays melden nur "name[0]": jedes Element und den Basisnamen eintragen
+        if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+            std::string base = name.substr(0, name.size() - 3);
+            entries.push_back({ base, location, type });
+            for (GLint e = 0; e < size; ++e) {
+                std::string element = base + "[" + std::to_string(e) + "]";
+                entries.push_back({ element, glGetUniformLocation(ID, element.c_str()), type });
+            }
+        } else {
+            entries.push_back({ name, location, type });
+        }
+    }
+
+    size_t capacity = 16;
+    while (capacity < entries.size() * 2) capacity *= 2;
+    uniformTable.assign(capacity, UniformSlot{});
+
+    std::unordered_map<uint32_t, std::string> names;
+    for (const Entry& entry : entries) {
+        const uint32_t hash = UniformId::Hash(entry.name.c_str());
+        auto [it, inserted] = names.emplace(hash, entry.name);
+        if (!inserted) {
+            if (it->second != entry.name) {
+                std::cout << "[Shader] uniform hash collision: " << entry.name << " / " << it->second << std::endl;
+            }
+            continue;
+        }
+        InsertUniform(hash, entry.location, entry.type);
+    }
+
+    // Uniform-Blöcke
+    GLint blockCount = 0, maxBlockName = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxBlockName);
+    std::vector<char> blockName(std::max(maxBlockName, 1));
+    for (GLint i = 0; i < blockCount; ++i) {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(ID, i, maxBlockName, &length, blockName.data());
+        UniformBlockInfo info;
+        info.hash = UniformId::Hash(std::string(blockName.data(), length).c_str());
+        info.index = i;
+        glGetActiveUniformBlockiv(ID, i, GL_UNIFORM_BLOCK_DATA_SIZE, &info.dataSize);
+        uniformBlocks.push_back(info);
+    }
+}
+
+void Shader::InsertUniform(uint32_t hash, int location, unsigned int type) {
+    const size_t mask = uniformTable.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        if (uniformTable[i].hash == 0) {
+            uniformTable[i].hash = hash;
+            uniformTable[i].location = location;
+            uniformTable[i].type = type;
+            return;
+        }
     }
 }
 
+Shader::UniformSlot* Shader::FindUniform(UniformId id) const {
+    if (uniformTable.empty()) return nullptr;
+    const size_t mask = uniformTable.size() - 1;
+    for (size_t i = id.hash & mask;; i = (i + 1) & mask) {
+        UniformSlot& slot = uniformTable[i];
+        if (slot.hash == id.hash) return &slot;
+        if (slot.hash == 0) return nullptr;
+    }
+}
+
+int Shader::GetUniformLocation(UniformId id) const {
+    const UniformSlot* slot = FindUniform(id);
+    return slot ? slot->location : -1;
+}
+
+int Shader::GetUniformBlockIndex(UniformId id) const {
+    for (const UniformBlockInfo& block : uniformBlocks) {
+        if (block.hash == id.hash) return block.index;
+    }
+    return -1;
+}
+
+bool Shader::UpdateCache(UniformSlot& slot, const void* data, size_t bytes) const {
+    if (slot.valid && std::memcmp(slot.value, data, bytes) == 0) {
+        ++skippedUniformCalls;
+        return false;
+    }
+    std::memcpy(slot.value, data, bytes);
+    slot.valid = true;
+    ++uniformCalls;
+    return true;
+}
+
+void Shader::BindUniformBlock(const char* blockName, unsigned int binding) const {
+    int index = GetUniformBlockIndex(UniformId(blockName));
+    if (index >= 0) glUniformBlockBinding(ID, index, binding);
+}
+
+size_t Shader::ConsumeUniformCallCount() {
+    size_t count = uniformCalls;
+    uniformCalls = 0;
+    return count;
+}
+
+size_t Shader::ConsumeSkippedUniformCount() {
+    size_t count = skippedUniformCalls;
+    skippedUniformCalls = 0;
+    return count;
+}
+
 void Shader::Use()
 {
     glUseProgram(ID);
@@ -72,21 +239,48 @@ void Shader::Use()
 
 void Shader::SetBool(const std::string &name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    Set(UniformId(name.c_str()), (int)value);
 }
 void Shader::SetInt(const std::string &name, int value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    Set(UniformId(name.c_str()), value);
 }
 void Shader::SetFloat(const std::string &name, float value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    Set(UniformId(name.c_str()), value);
 }
 
 void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    Set(UniformId(name.c_str()), mat);
 }
 
 void Shader::SetVec3(const std::string &name, const glm::vec3 &vec) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(vec));
+    Set(UniformId(name.c_str()), vec);
+}
+
+void Shader::Set(UniformId id, int value) const {
+    UniformSlot* slot = FindUniform(id);
+    if (slot && UpdateCache(*slot, &value, sizeof(value))) glUniform1i(slot->location, value);
+}
+
+void Shader::Set(UniformId id, float value) const {
+    UniformSlot* slot = FindUniform(id);
+    if (slot && UpdateCache(*slot, &value, sizeof(value))) glUniform1f(slot->location, value);
+}
+
+void Shader::Set(UniformId id, const glm::vec3& value) const {
+    UniformSlot* slot = FindUniform(id);
+    if (slot && UpdateCache(*slot, glm::value_ptr(value), sizeof(value))) glUniform3fv(slot->location, 1, glm::value_ptr(value));
+}
+
+void Shader::Set(UniformId id, const glm::vec4& value) const {
+    UniformSlot* slot = FindUniform(id);
+    if (slot && UpdateCache(*slot, glm::value_ptr(value), sizeof(value))) glUniform4fv(slot->location, 1, glm::value_ptr(value));
+}
+
+void Shader::Set(UniformId id, const glm::mat4& value) const {
+    UniformSlot* slot = FindUniform(id);
+    if (slot && UpdateCache(*slot, glm::value_ptr(value), sizeof(value))) {
+        glUniformMatrix4fv(slot->location, 1, GL_FALSE, glm::value_ptr(value));
+    }
 }
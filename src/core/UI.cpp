@@ -9,6 +9,7 @@
 #include "../../include/core/ui/StyleEditorPanel.hpp"
 #include "../../include/core/ui/MonitoringPanel.hpp"
 #include "../../include/objects/Model.hpp"
+#include <filesystem>
 #include <iostream>
 
 UI::UI(Window* windowObj, GLFWwindow* window) : windowObj(windowObj), window(window) {
@@ -82,7 +83,7 @@ void UI::EndFrame() {
 }
 
 void UI::Draw(const std::vector<Mesh*>& meshes, Scene& scene) {
-    PanelContext ctx{ &scene, &meshes, &selectionState };
+    PanelContext ctx{ &scene, &meshes, &selectionState, &renderSettings };
     for (auto& p : panels) {
         p->Draw(ctx);
     }
@@ -105,13 +106,31 @@ ViewportRect UI::DrawViewport(GLuint texture, int, int, Scene& scene) {
     if (ImGui::BeginDragDropTarget()) {
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("MODEL_PATH")) {
             const char* modelPath = (const char*)payload->Data;
-            scene.AddObject(std::make_shared<Model>(std::string(modelPath)));
+            // Neue Instanz auf das geteilte Asset: importiert wird nur beim ersten Drop dieses Pfads,
+            // im Hintergrund; bis zum Upload steht ein Platzhalter in der Szene
+            scene.AddObject(std::make_shared<Model>(ResourceManager::GetModelAsset(modelPath)));
         }
         ImGui::EndDragDropTarget();
     }
 
     ImGui::SetCursorPos(cursor);
     ImGui::Image((void*)(intptr_t)texture, imageSize, ImVec2(0,1), ImVec2(1,0));
+
+    // Laufende Modell-Importe: Fortschritt und Abbrechen oben links über dem Bild
+    const auto& imports = ResourceManager::GetModelImports();
+    if (!imports.empty()) {
+        ImGui::SetCursorPos(ImVec2(cursor.x + 8.0f, cursor.y + 8.0f));
+        ImGui::BeginGroup();
+        for (const auto& asset : imports) {
+            ImGui::PushID(asset.get());
+            const std::string name = std::filesystem::path(asset->GetPath()).filename().string();
+            ImGui::ProgressBar(asset->GetProgress(), ImVec2(220.0f, 0.0f), name.c_str());
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Cancel")) asset->Cancel();
+            ImGui::PopID();
+        }
+        ImGui::EndGroup();
+    }
     ImGui::End();
     return { absolutePos, imageSize };
 }
@@ -0,0 +1,48 @@
+#include "glad/glad.h"
+#include "../../include/core/UniformBuffer.hpp"
+#include <cstring>
+
+size_t UniformBuffer::uploadCount = 0;
+
+UniformBuffer::~UniformBuffer() {
+    Shutdown();
+}
+
+void UniformBuffer::Init(size_t size, unsigned int bindingPoint) {
+    Shutdown();
+    binding = bindingPoint;
+    shadow.assign(size, 0);
+    valid = false;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
+
+void UniformBuffer::Shutdown() {
+    if (buffer) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    shadow.clear();
+    valid = false;
+}
+
+bool UniformBuffer::Update(const void* data, size_t size) {
+    if (!buffer || size > shadow.size()) return false;
+    if (valid && std::memcmp(shadow.data(), data, size) == 0) return false;
+
+    std::memcpy(shadow.data(), data, size);
+    valid = true;
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    ++uploadCount;
+    return true;
+}
+
+size_t UniformBuffer::ConsumeUploadCount() {
+    size_t count = uploadCount;
+    uploadCount = 0;
+    return count;
+}
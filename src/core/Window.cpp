@@ -3,6 +3,7 @@
 //
 #include "glad/glad.h"
 #include "../../include/core/Window.hpp"
+#include "../../include/core/GLCapabilities.hpp"
 #include <iostream>
 #include <vector>
 
@@ -40,6 +41,7 @@ Window::Window(int width, int height, const char* title) {
         std::cout << "Failed to initialize GLAD" << std::endl;
         exit(-1);
     }
+    GLCapabilities::SetContextThread();
 
     glfwSwapInterval(0);
     glfwSetFramebufferSizeCallback(window, Window::framebuffer_size_callback);
@@ -38,8 +38,15 @@ void InspectorPanel::Draw(PanelContext& ctx) {
     glm::vec3 scale = obj->GetScale();
     if (ImGui::DragFloat3("Scale", &scale.x, 0.05f, 0.01f, 100.0f)) obj->SetScale(scale);
 
+    // Wände, Böden und andere große Objekte verdecken für das CPU-Occlusion-Culling
+    if (!IsLightType(obj->GetType()) && obj->GetType() != ObjectType::Generic) {
+        bool occluder = ctx.scene->IsOccluder(*obj);
+        if (ImGui::Checkbox("Occluder", &occluder)) ctx.scene->SetOccluder(*obj, occluder);
+    }
+
     // Light spezifische Attribute
-    if (auto* light = dynamic_cast<Light*>(obj.get())) {
+    if (IsLightType(obj->GetType())) {
+        auto* light = static_cast<Light*>(obj.get());
         ImGui::Separator();
         ImGui::Text("Light");
         ImGui::ColorEdit3("Color", (float*)&light->color);
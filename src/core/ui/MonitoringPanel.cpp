@@ -1,5 +1,7 @@
 #include "../../../include/core/ui/MonitoringPanel.hpp"
 #include "../../../include/core/ui/PanelContext.hpp"
+#include "../../../include/core/ResourceManager.hpp"
+#include "../../../include/core/ProjectManager.hpp"
 #include "imgui.h"
 #include <algorithm>
 #include <string>
@@ -23,7 +25,75 @@ void MonitoringPanel::PlotSeries(const char* label, const MonitoringMetrics::Sam
     ImGui::PlotLines(plotId.c_str(), ordered.data(), (int)ordered.size(), 0, nullptr, 0.0f, maxVal * 1.05f, ImVec2(0,60));
 }
 
-void MonitoringPanel::Draw(PanelContext&) {
+void MonitoringPanel::DrawBenchmarks(PanelContext& ctx) {
+    if (ImGui::Button("Frustum Culling (1M boxes)")) {
+        benchmarkResults.push_back(Benchmarks::FrustumCulling(1000000));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("JobSystem Scaling (1M items)")) {
+        auto results = Benchmarks::JobSystemScaling(1000000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    if (ImGui::Button("ECS Iteration (1M entities)")) {
+        auto results = Benchmarks::EntityIteration(1000000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Scene Dispatch (100k objects)")) {
+        auto results = Benchmarks::SceneDispatch(100000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    if (ImGui::Button("Light Clustering (1k/4k/16k)")) {
+        auto results = Benchmarks::LightClustering({1000, 4000, 16000});
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Occlusion Culling (100k boxes)")) {
+        auto results = Benchmarks::OcclusionCulling(100000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    if (ImGui::Button("GPU vs CPU Culling (1M instances)")) {
+        auto results = Benchmarks::GpuCulling(1000000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Instance Transforms (10k instances)")) {
+        auto results = Benchmarks::InstanceTransforms(10000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    if (ImGui::Button("Mesh Optimization (130k triangles)")) {
+        auto results = Benchmarks::MeshOptimization(130000);
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Model Cache (assets/models)")) {
+        const std::string& root = ProjectManager::Instance().GetProjectRoot();
+        auto results = Benchmarks::ModelCache(root.empty() ? std::string("assets/models") : root + "/assets/models");
+        benchmarkResults.insert(benchmarkResults.end(), results.begin(), results.end());
+    }
+    if (ImGui::Button("Clear")) benchmarkResults.clear();
+    // Testszenen ersetzen die aktuelle Scene; gemessen wird dann über Frame-/GPU-Zeit und den Renderer-Tab
+    if (ctx.scene) {
+        ImGui::TextUnformatted("Light scene:");
+        for (size_t count : {1000, 4000, 16000}) {
+            ImGui::SameLine();
+            const std::string label = std::to_string(count / 1000) + "k lights";
+            if (ImGui::Button(label.c_str())) Benchmarks::BuildLightScene(*ctx.scene, count);
+        }
+        ImGui::TextUnformatted("Material scene:");
+        for (size_t count : {1000, 10000}) {
+            ImGui::SameLine();
+            const std::string label = std::to_string(count / 1000) + "k cubes";
+            if (ImGui::Button(label.c_str())) Benchmarks::BuildMaterialScene(*ctx.scene, count);
+        }
+    }
+    ImGui::Separator();
+    for (const auto& r : benchmarkResults) {
+        ImGui::Text("%s: %.3f ms  (%s)", r.name.c_str(), r.ms, r.detail.c_str());
+    }
+}
+
+void MonitoringPanel::Draw(PanelContext& ctx) {
     auto& metrics = MonitoringMetrics::Instance();
     ImGui::Begin("Monitoring");
 
@@ -35,6 +105,73 @@ void MonitoringPanel::Draw(PanelContext&) {
             PlotSeries("FPS", metrics.Fps(), "fps");
             ImGui::EndTabItem();
         }
+        if (ImGui::BeginTabItem("Renderer")) {
+            if (ctx.renderSettings) {
+                int path = static_cast<int>(ctx.renderSettings->path);
+                ImGui::TextUnformatted("Render Path:");
+                ImGui::SameLine();
+                ImGui::RadioButton("Forward", &path, static_cast<int>(RenderPath::Forward));
+                ImGui::SameLine();
+                ImGui::RadioButton("Deferred", &path, static_cast<int>(RenderPath::Deferred));
+                ctx.renderSettings->path = static_cast<RenderPath>(path);
+                ImGui::Checkbox("Depth Pre-Pass", &ctx.renderSettings->depthPrepass);
+                ImGui::SameLine();
+                ImGui::Checkbox("Occlusion Culling", &ctx.renderSettings->occlusionCulling);
+                ImGui::SameLine();
+                ImGui::Checkbox("GPU Culling", &ctx.renderSettings->gpuCulling);
+                ImGui::Checkbox("LOD", &ctx.renderSettings->lod);
+                ImGui::SameLine();
+                ImGui::SliderFloat("LOD Error (px)", &ctx.renderSettings->lodErrorPixels, 0.25f, 8.0f, "%.2f");
+            }
+            // 1.0 = jedes sichtbare Pixel genau einmal geshadet; darüber ist Overdraw
+            ImGui::Text("Shaded fragments/pixel: %.2f", metrics.LastShadedPerPixel());
+            PlotSeries("Shaded fragments/pixel", metrics.ShadedPerPixel(), "");
+            for (const auto& pass : metrics.GpuPasses()) {
+                PlotSeries(("GPU " + pass.name + " (ms)").c_str(), pass.ms, "ms");
+            }
+            ImGui::Separator();
+            ImGui::Text("Queue Items: %zu", metrics.LastQueueItems());
+            ImGui::Text("Draw Calls: %zu  Batches: %zu (%.1f objects/draw)", metrics.LastDrawCalls(),
+                        metrics.LastBatches(), metrics.LastBatchingRatio());
+            ImGui::Text("Materials: %zu  Primitive Meshes: %zu  Model Assets: %zu  Texture Arrays: %.1f MB",
+                        ResourceManager::GetMaterialCount(), ResourceManager::GetPrimitiveMeshCount(),
+                        ResourceManager::GetModelAssetCount(), ResourceManager::GetTextureArrayBytes() / (1024.0 * 1024.0));
+            ImGui::Text("VAO Binds: %zu  Arena: %.1f MB vertices, %.1f MB indices", metrics.LastVaoBinds(),
+                        metrics.LastArenaVertexBytes() / (1024.0 * 1024.0), metrics.LastArenaIndexBytes() / (1024.0 * 1024.0));
+            PlotSeries("Queue Build (ms)", metrics.QueueBuildMs(), "ms");
+            PlotSeries("Queue Sort (ms)", metrics.QueueSortMs(), "ms");
+            PlotSeries("Draw Calls", metrics.DrawCalls(), "");
+            PlotSeries("Batching (objects/draw)", metrics.BatchingRatio(), "");
+            ImGui::Separator();
+            ImGui::Text("Visible: %zu  Culled: %zu", metrics.LastVisible(), metrics.LastCulled());
+            PlotSeries("Frustum Cull (ms)", metrics.CullMs(), "ms");
+            ImGui::Text("Occluded: %zu  Occluder triangles: %zu", metrics.LastOccluded(), metrics.LastOccluderTriangles());
+            PlotSeries("Occlusion Raster (ms)", metrics.OcclusionRasterMs(), "ms");
+            PlotSeries("Occlusion Test (ms)", metrics.OcclusionTestMs(), "ms");
+            ImGui::Text("Triangles: %zu of %zu (LOD > 0: %zu instances)", metrics.LastLodTriangles(),
+                        metrics.LastFullTriangles(), metrics.LastLodReduced());
+            PlotSeries("Triangles (K)", metrics.LodTrianglesK(), "K");
+            ImGui::Separator();
+            ImGui::Text("Transforms updated: %zu", metrics.LastTransformUpdates());
+            PlotSeries("Transform Update (ms)", metrics.TransformUpdateMs(), "ms");
+            ImGui::Separator();
+            ImGui::Text("Uniform calls: %zu (skipped %zu)  UBO uploads: %zu", metrics.LastUniformCalls(),
+                        metrics.LastSkippedUniformCalls(), metrics.LastUniformBufferUploads());
+            PlotSeries("Uniform Calls", metrics.UniformCalls(), "");
+            ImGui::Separator();
+            ImGui::Text("Lights: %zu (visible %zu)  Cluster indices: %zu", metrics.LastLights(),
+                        metrics.LastVisibleLights(), metrics.LastLightIndices());
+            PlotSeries("Light Clustering (ms)", metrics.LightClusterMs(), "ms");
+            ImGui::Separator();
+            ImGui::Text("Fence Waits: %d", metrics.LastFenceWaits());
+            if (metrics.RingFallbackFrames() > 0) {
+                ImGui::SameLine();
+                ImGui::Text("Ring Map Fallbacks: %zu frames", metrics.RingFallbackFrames());
+            }
+            PlotSeries("Instance Upload (KB)", metrics.InstanceUploadKB(), "KB");
+            PlotSeries("Fence Wait (ms)", metrics.FenceWaitMs(), "ms");
+            ImGui::EndTabItem();
+        }
         if (ImGui::BeginTabItem("CPU / Memory")) {
             PlotSeries("CPU Usage (%)", metrics.CpuUsagePercent(), "%");
             PlotSeries("RAM (MB)", metrics.RamMB(), "MB");
@@ -45,6 +182,10 @@ void MonitoringPanel::Draw(PanelContext&) {
             PlotSeries("VRAM Used (MB)", metrics.VramUsedMB(), "MB");
             ImGui::EndTabItem();
         }
+        if (ImGui::BeginTabItem("Benchmarks")) {
+            DrawBenchmarks(ctx);
+            ImGui::EndTabItem();
+        }
         ImGui::EndTabBar();
     }
 
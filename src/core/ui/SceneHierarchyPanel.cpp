@@ -19,10 +19,15 @@ void SceneHierarchyPanel::Draw(PanelContext& ctx) {
 
     for (int i=0;i< (int)objects.size();++i) {
         std::string label;
-        if (dynamic_cast<Cube*>(objects[i].get())) label = "Cube"; else
-        if (dynamic_cast<Plane*>(objects[i].get())) label = "Plane"; else
-        if (dynamic_cast<Light*>(objects[i].get())) label = "Light"; else
-        if (dynamic_cast<Model*>(objects[i].get())) label = "Model"; else label = "Unknown";
+        switch (objects[i]->GetType()) {
+            case ObjectType::Cube:  label = "Cube"; break;
+            case ObjectType::Plane: label = "Plane"; break;
+            case ObjectType::PointLight:
+            case ObjectType::DirectionalLight:
+            case ObjectType::SpotLight: label = "Light"; break;
+            case ObjectType::Model: label = "Model"; break;
+            default: label = "Unknown"; break;
+        }
         int num = ++typeCounter[label];
         label += " " + std::to_string(num);
         bool selected = (ctx.selection->selectedObject == i);
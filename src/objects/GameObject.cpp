@@ -0,0 +1,121 @@
+#include "../../include/objects/GameObject.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    glm::vec3 Perpendicular(const glm::vec3& v) {
+        const glm::vec3 axis = std::abs(v.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        return glm::normalize(glm::cross(v, axis));
+    }
+
+    // Zerlegt eine affine Matrix per Gram-Schmidt über die Spalten in Position, Rotation und Skalierung.
+    // Scherung fällt weg; eine Spiegelung landet im Vorzeichen von scale.x.
+    void DecomposeTransform(const glm::mat4& m, glm::vec3& position, glm::quat& rotation, glm::vec3& scale) {
+        position = glm::vec3(m[3]);
+        glm::vec3 x(m[0]), y(m[1]), z(m[2]);
+        scale.x = glm::length(x);
+        x = scale.x > 0.0f ? x * (1.0f / scale.x) : glm::vec3(1.0f, 0.0f, 0.0f);
+        y -= x * glm::dot(x, y);
+        scale.y = glm::length(y);
+        y = scale.y > 0.0f ? y * (1.0f / scale.y) : Perpendicular(x);
+        z = glm::cross(x, y);
+        scale.z = glm::dot(z, glm::vec3(m[2]));
+        if (scale.z < 0.0f) {
+            // Ungerade Spiegelung: x umdrehen, damit z = x * y eine echte Rotation bleibt
+            scale.x = -scale.x;
+            scale.z = -scale.z;
+            x = -x;
+            z = -z;
+        }
+        rotation = glm::quat_cast(glm::mat3(x, y, z));
+    }
+}
+
+GameObject::GameObject(ObjectType type) : type(type) {
+    EntityRegistry& registry = EntityRegistry::Instance();
+    entity = registry.Create();
+    registry.Add<TransformComponent>(entity);
+    registry.Add<WorldTransformComponent>(entity);
+}
+
+GameObject::~GameObject() {
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+    // Kinder werden zu Wurzeln; ihre Welt-Matrix entspricht dann der lokalen
+    for (GameObject* child : children) {
+        child->parent = nullptr;
+        child->MarkDirty();
+    }
+    EntityRegistry::Instance().Destroy(entity);
+}
+
+void GameObject::SetParent(GameObject* newParent) {
+    if (newParent == parent || newParent == this) return;
+    // Zyklen verhindern: newParent darf nicht im eigenen Teilbaum liegen
+    for (GameObject* p = newParent; p; p = p->parent) {
+        if (p == this) return;
+    }
+
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+    parent = newParent;
+    if (parent) parent->children.push_back(this);
+    MarkDirty();
+}
+
+void GameObject::MarkDirty() {
+    localDirty = true;
+    for (GameObject* child : children) child->MarkWorldDirty();
+    // Vorfahren merken sich, dass darunter Arbeit liegt; abbrechen, sobald das schon bekannt ist
+    for (GameObject* p = parent; p && !p->childDirty; p = p->parent) {
+        p->childDirty = true;
+    }
+}
+
+void GameObject::MarkWorldDirty() {
+    // Ist der Knoten schon markiert, ist es sein Teilbaum auch
+    if (worldDirty) return;
+    worldDirty = true;
+    for (GameObject* child : children) child->MarkWorldDirty();
+}
+
+size_t GameObject::UpdateTransform() {
+    return UpdateTransform(parent ? parent->GetWorldMatrix() : glm::mat4(1.0f));
+}
+
+size_t GameObject::UpdateTransform(const glm::mat4& parentWorld) {
+    if (!localDirty && !worldDirty && !childDirty) return 0;
+
+    size_t updated = 0;
+    // Eigene Komponente; Kinder legen keine Komponenten an, die Referenz bleibt also gültig
+    WorldTransformComponent& cached = WorldTransform();
+    if (localDirty) {
+        const TransformComponent& t = Transform();
+        cached.local = glm::translate(glm::mat4(1.0f), t.position);
+        cached.local *= glm::mat4_cast(t.rotation);
+        cached.local = glm::scale(cached.local, t.scale);
+    }
+    if (localDirty || worldDirty) {
+        cached.world = parent ? parentWorld * cached.local : cached.local;
+        if (parent) {
+            DecomposeTransform(cached.world, cached.worldPosition, cached.worldRotation, cached.worldScale);
+        } else {
+            const TransformComponent& t = Transform();
+            cached.worldPosition = t.position;
+            cached.worldRotation = t.rotation;
+            cached.worldScale = t.scale;
+        }
+        ++cached.version;
+        ++updated;
+    }
+    localDirty = worldDirty = childDirty = false;
+
+    for (GameObject* child : children) {
+        updated += child->UpdateTransform(cached.world);
+    }
+    return updated;
+}
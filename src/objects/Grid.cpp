@@ -55,27 +55,23 @@ void Grid::Render(const Camera& camera, float aspect) {
 
     gridShader->Use();
 
-    // Inverse View-Projection Matrix berechnen
-    glm::mat4 view = camera.GetViewMatrix();
-    glm::mat4 projection = camera.GetProjectionMatrix(aspect);
-    glm::mat4 invViewProj = glm::inverse(projection * view);
-
-    // Uniforms setzen
-    gridShader->SetMat4("uInvViewProj", invViewProj);
-    gridShader->SetVec3("uCameraPos", camera.position);
-    gridShader->SetFloat("uPlaneY", planeY);
-    gridShader->SetFloat("uMajorStep", majorStep);
-    gridShader->SetFloat("uThicknessPx", thicknessPx);
-    gridShader->SetFloat("uFadeStart", fadeStart);
-    gridShader->SetFloat("uFadeEnd", fadeEnd);
-
-    // Grid-Farben
-    gridShader->SetVec3("uGridColorMinor", glm::vec3(0.55f));
-    gridShader->SetVec3("uGridColorMajor", glm::vec3(0.85f));
-    gridShader->SetVec3("uBackground", glm::vec3(0.0f));
-    gridShader->SetVec3("uAxisX", glm::vec3(0.2f, 0.2f, 0.2f));
-    gridShader->SetVec3("uAxisZ", glm::vec3(0.2f, 0.2f, 0.2f));
-    gridShader->SetVec3("uAxisOrigin", glm::vec3(0.2f));
+    // Kamera-Matrizen kommen aus dem CameraBlock (UBO), hier nur die Grid-Parameter
+    if (paramsDirty) {
+        gridShader->SetFloat("uPlaneY", planeY);
+        gridShader->SetFloat("uMajorStep", majorStep);
+        gridShader->SetFloat("uThicknessPx", thicknessPx);
+        gridShader->SetFloat("uFadeStart", fadeStart);
+        gridShader->SetFloat("uFadeEnd", fadeEnd);
+
+        // Grid-Farben
+        gridShader->SetVec3("uGridColorMinor", glm::vec3(0.55f));
+        gridShader->SetVec3("uGridColorMajor", glm::vec3(0.85f));
+        gridShader->SetVec3("uBackground", glm::vec3(0.0f));
+        gridShader->SetVec3("uAxisX", glm::vec3(0.2f, 0.2f, 0.2f));
+        gridShader->SetVec3("uAxisZ", glm::vec3(0.2f, 0.2f, 0.2f));
+        gridShader->SetVec3("uAxisOrigin", glm::vec3(0.2f));
+        paramsDirty = false;
+    }
 
     glBindVertexArray(gridVAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -3,74 +3,168 @@
 //
 #include "glad/glad.h"
 #include "../../include/objects/Mesh.hpp"
+#include "../../include/core/ResourceManager.hpp"
+#include <algorithm>
+#include <cmath>
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures) {
-    this->vertices = vertices;
-    this->indices = indices;
-    this->textures = textures;
+namespace {
+    uint32_t NextMeshId() {
+        static uint32_t nextMeshId = 1;
+        return nextMeshId++;
+    }
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::shared_ptr<Material> material,
+           bool compactVertices) : compactVertices(compactVertices) {
+    meshId = NextMeshId();
+    this->vertices = std::move(vertices);
+    this->indices = std::move(indices);
+    this->material = material ? std::move(material) : ResourceManager::GetDefaultMaterial();
+    materialId = this->material->GetId();
+
+    bounds = ComputeBounds(this->vertices);
+    geometry = GeometryArena::Instance().Allocate(this->vertices.data(), this->vertices.size(),
+                                                  this->indices.data(), this->indices.size(), compactVertices);
+}
+
+Mesh::Mesh(const GeometryArena::EncodedGeometry& encoded, const Bounds& bounds, std::shared_ptr<Material> material)
+    : bounds(bounds), compactVertices(IsCompactFormat(encoded.format)) {
+    meshId = NextMeshId();
+    this->material = material ? std::move(material) : ResourceManager::GetDefaultMaterial();
+    materialId = this->material->GetId();
+    geometry = GeometryArena::Instance().Allocate(encoded);
+}
 
-    SetupMesh();
+Mesh::~Mesh() {
+    if (geometry != GeometryArena::InvalidHandle) GeometryArena::Instance().Free(geometry);
+    for (const MeshLod& lod : lods) GeometryArena::Instance().Free(lod.geometry);
 }
 
-void Mesh::SetupMesh()
-{
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+Mesh::Mesh(Mesh&& other) noexcept
+    : vertices(std::move(other.vertices)), indices(std::move(other.indices)), meshId(other.meshId),
+      material(std::move(other.material)), materialId(other.materialId), bounds(other.bounds),
+      geometry(other.geometry), compactVertices(other.compactVertices), lods(std::move(other.lods)),
+      externalOccluder(other.externalOccluder), instanceBuffer(other.instanceBuffer), instanceOffset(other.instanceOffset),
+      instanceCount(other.instanceCount) {
+    other.geometry = GeometryArena::InvalidHandle;
+    other.lods.clear();
+}
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    if (this == &other) return *this;
+    if (geometry != GeometryArena::InvalidHandle) GeometryArena::Instance().Free(geometry);
+    for (const MeshLod& lod : lods) GeometryArena::Instance().Free(lod.geometry);
+    vertices = std::move(other.vertices);
+    indices = std::move(other.indices);
+    meshId = other.meshId;
+    material = std::move(other.material);
+    materialId = other.materialId;
+    bounds = other.bounds;
+    geometry = other.geometry;
+    compactVertices = other.compactVertices;
+    lods = std::move(other.lods);
+    externalOccluder = other.externalOccluder;
+    instanceBuffer = other.instanceBuffer;
+    instanceOffset = other.instanceOffset;
+    instanceCount = other.instanceCount;
+    other.geometry = GeometryArena::InvalidHandle;
+    other.lods.clear();
+    return *this;
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+void Mesh::AddLod(const std::vector<Vertex>& lodVertices, const std::vector<unsigned int>& lodIndices, float error) {
+    AddLod(lodVertices.data(), lodVertices.size(), lodIndices.data(), lodIndices.size(), error);
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+void Mesh::AddLod(const Vertex* lodVertices, size_t vertexCount, const unsigned int* lodIndices, size_t indexCount,
+                  float error) {
+    if (indexCount == 0) return;
+    MeshLod lod;
+    lod.geometry = GeometryArena::Instance().Allocate(lodVertices, vertexCount, lodIndices, indexCount, compactVertices);
+    lod.indexCount = static_cast<uint32_t>(indexCount);
+    lod.error = error;
+    lods.push_back(lod);
+}
 
-    // Instancing Buffer für Model-Matrix
-    glGenBuffers(1, &instanceVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+void Mesh::AddLod(const GeometryArena::EncodedGeometry& lodGeometry, float error) {
+    if (lodGeometry.indexCount == 0) return;
+    MeshLod lod;
+    lod.geometry = GeometryArena::Instance().Allocate(lodGeometry);
+    lod.indexCount = lodGeometry.indexCount;
+    lod.error = error;
+    lods.push_back(lod);
+}
 
-    // Model-Matrix als 4 Attribute (3-6)
-    for (int i = 0; i < 4; ++i) {
-        glEnableVertexAttribArray(3 + i);
-        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(float) * i * 4));
-        glVertexAttribDivisor(3 + i, 1);
+Mesh::Occluder Mesh::GetOccluder() const {
+    if (vertices.empty()) return externalOccluder;
+    return { &vertices[0].position, sizeof(Vertex), vertices.size(), indices.data(), indices.size() };
+}
+
+void Mesh::SetExternalOccluder(const glm::vec3* positions, size_t vertexCount, const uint32_t* occluderIndices,
+                               size_t indexCount) {
+    externalOccluder = { positions, sizeof(glm::vec3), vertexCount, occluderIndices, indexCount };
+}
+
+size_t Mesh::GetGpuBytes() const {
+    const GeometryArena& arena = GeometryArena::Instance();
+    size_t bytes = arena.GetRangeBytes(geometry);
+    for (const MeshLod& lod : lods) bytes += arena.GetRangeBytes(lod.geometry);
+    return bytes;
+}
+
+size_t Mesh::GetUncompressedBytes() const {
+    // Vertex plus Positions-Stream (vec3) und 32-Bit-Indizes
+    const GeometryArena& arena = GeometryArena::Instance();
+    size_t bytes = 0;
+    for (size_t level = 0; level < GetLodCount(); ++level) {
+        const GeometryArena::Range& range = arena.Get(GetLodGeometry(level));
+        bytes += static_cast<size_t>(range.vertexCount) * (sizeof(Vertex) + sizeof(glm::vec3)) +
+                 static_cast<size_t>(range.indexCount) * sizeof(uint32_t);
     }
+    return bytes;
+}
 
-    glBindVertexArray(0);
+Bounds Mesh::ComputeBounds(const std::vector<Vertex>& vertices) {
+    Bounds bounds;
+    if (vertices.empty()) return bounds;
+    glm::vec3 mn = vertices[0].position;
+    glm::vec3 mx = vertices[0].position;
+    for (const Vertex& v : vertices) {
+        mn = glm::min(mn, v.position);
+        mx = glm::max(mx, v.position);
+    }
+    bounds.min = mn;
+    bounds.max = mx;
+    bounds.center = (mn + mx) * 0.5f;
+    // Kugel um das AABB-Zentrum, Radius über die tatsächlichen Vertices (enger als die halbe Diagonale)
+    float r2 = 0.0f;
+    for (const Vertex& v : vertices) {
+        glm::vec3 d = v.position - bounds.center;
+        r2 = std::max(r2, glm::dot(d, d));
+    }
+    bounds.radius = std::sqrt(r2);
+    return bounds;
 }
 
-void Mesh::SetModelMatrices(const std::vector<glm::mat4>& matrices) {
-    instanceCount = matrices.size();
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, instanceCount * sizeof(glm::mat4), matrices.data(), GL_DYNAMIC_DRAW);
+void Mesh::SetInstanceData(unsigned int buffer, size_t byteOffset, size_t count) {
+    instanceBuffer = buffer;
+    instanceOffset = byteOffset;
+    instanceCount = count;
 }
 
 void Mesh::DrawInstanced(Shader& shader) {
-    unsigned int diffuseNr = 1;
-    unsigned int specularNr = 1;
-    for (unsigned int i = 0; i < textures.size(); i++)
-    {
-        glActiveTexture(GL_TEXTURE0 + i);
-        std::string number;
-        std::string name = textures[i].type;
-        if (name == "texture_diffuse")
-            number = std::to_string(diffuseNr++);
-        else if (name == "texture_specular")
-            number = std::to_string(specularNr++);
-        shader.SetInt(("material." + name + number).c_str(), i);
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
-    }
-    glActiveTexture(GL_TEXTURE0);
+    static constexpr UniformId CompactVertexUniform("compactVertex");
+    ResourceManager::BindMaterials(shader);
+    if (!instanceBuffer || instanceCount == 0) return;
 
-    glBindVertexArray(VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0, instanceCount);
+    // Bei kompakten Formaten muss die Instanz die Dequantisierung enthalten (GeometryArena::Range::Dequantize)
+    const GeometryArena::Range& range = GetGeometry();
+    GeometryArena& arena = GeometryArena::Instance();
+    arena.BindVertexFormat(range.format);
+    shader.Set(CompactVertexUniform, IsCompactFormat(range.format) ? 1 : 0);
+    arena.SetInstanceBuffer(instanceBuffer, instanceOffset);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount, GeometryArena::GetIndexType(range.format),
+                                      (void*)(static_cast<size_t>(range.firstIndex) * GeometryArena::GetIndexSize(range.format)),
+                                      instanceCount, range.baseVertex);
     glBindVertexArray(0);
 }
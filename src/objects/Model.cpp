@@ -3,139 +3,20 @@
 //
 
 #include "../../include/objects/Model.hpp"
-#include <filesystem>
 
-void Model::Draw(Shader &shader)
+void Model::Draw(Shader &shader, InstanceRingBuffer& instances)
 {
-    std::vector<glm::mat4> matrices = { glm::mat4(1.0f) }; // eine Instanz, Identitätsmatrix
-    for(unsigned int i = 0; i < meshes.size(); i++) {
-        meshes[i].SetModelMatrices(matrices);
-        meshes[i].DrawInstanced(shader);
+    // eine Instanz pro Mesh, Identität mit dem Material des Meshes
+    if (!asset->IsReady()) return;
+    for(size_t i = 0; i < asset->GetMeshCount(); i++) {
+        Mesh& mesh = *asset->GetMeshAt(i);
+        size_t offset = 0;
+        auto* dst = static_cast<InstanceData*>(instances.Map(sizeof(InstanceData), offset));
+        if (!dst) return;
+        *dst = mesh.GetGeometry().Dequantize(InstanceData::Make(glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                                                                glm::vec3(1.0f), mesh.GetMaterialId()));
+        instances.Unmap();
+        mesh.SetInstanceData(instances.GetBuffer(), offset, 1);
+        mesh.DrawInstanced(shader);
     }
 }
-
-void Model::loadModel(std::string path)
-{
-    Assimp::Importer import;
-
-    unsigned int flags = aiProcess_Triangulate |
-                         aiProcess_FlipUVs |
-                         aiProcess_OptimizeMeshes |
-                         aiProcess_JoinIdenticalVertices |
-                         aiProcess_SortByPType |
-                         aiProcess_RemoveRedundantMaterials;
-
-    const aiScene *scene = import.ReadFile(path, flags);
-
-    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
-    {
-        std::cout << "ERROR::ASSIMP::" << import.GetErrorString() << std::endl;
-        return;
-    }
-
-    directory = std::filesystem::path(path).parent_path().string();
-
-    processNode(scene->mRootNode, scene);
-}
-
-void Model::processNode(aiNode *node, const aiScene *scene)
-{
-    // process all the node's meshes (if any)
-    for(unsigned int i = 0; i < node->mNumMeshes; i++)
-    {
-        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-        meshes.push_back(processMesh(mesh, scene));
-    }
-    // then do the same for each of its children
-    for(unsigned int i = 0; i < node->mNumChildren; i++)
-    {
-        processNode(node->mChildren[i], scene);
-    }
-}
-
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
-{
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
-
-    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
-    {
-        Vertex vertex;
-        // process vertex positions, normals and texture coordinates
-        glm::vec3 vector;
-        vertex.position.x = mesh->mVertices[i].x;
-        vertex.position.y = mesh->mVertices[i].y;
-        vertex.position.z = mesh->mVertices[i].z;
-        if(mesh->mNormals) {
-            vertex.normal.x = mesh->mNormals[i].x;
-            vertex.normal.y = mesh->mNormals[i].y;
-            vertex.normal.z = mesh->mNormals[i].z;
-        }
-
-        if(mesh->mTextureCoords[0])
-        {
-            glm::vec2 vec;
-            vec.x = mesh->mTextureCoords[0][i].x;
-            vec.y = 1.0f - mesh->mTextureCoords[0][i].y;
-            vertex.texCoords = vec;
-        }
-        else
-            vertex.texCoords = glm::vec2(0.0f, 0.0f);
-
-        vertices.push_back(vertex);
-    }
-    // process indices
-    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
-    {
-        aiFace face = mesh->mFaces[i];
-        for(unsigned int j = 0; j < face.mNumIndices; j++)
-            indices.push_back(face.mIndices[j]);
-    }
-    // process material
-    if(mesh->mMaterialIndex >= 0)
-    {
-        aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
-        std::vector<Texture> diffuseMaps = loadMaterialTextures(material,
-                                                           aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-        std::vector<Texture> specularMaps = loadMaterialTextures(material,
-                                                            aiTextureType_SPECULAR, "texture_specular");
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-    }
-
-    return Mesh(vertices, indices, textures);
-}
-
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName)
-{
-    std::vector<Texture> textures;
-    for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
-    {
-        aiString str;
-        mat->GetTexture(type, i, &str);
-        bool skip = false;
-        for(unsigned int j = 0; j < textures_loaded.size(); j++)
-        {
-            if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-            {
-                textures.push_back(textures_loaded[j]);
-                skip = true;
-                break;
-            }
-        }
-        if(!skip)
-        {
-            std::filesystem::path texPath = std::filesystem::path(directory) / str.C_Str();
-            texPath = texPath.lexically_normal();
-
-            Texture texture;
-            texture.id = ResourceManager::GetTexture(texPath.string());
-            texture.type = typeName;
-            texture.path = texPath.string();
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);
-        }
-    }
-    return textures;
-}
\ No newline at end of file
@@ -0,0 +1,418 @@
+//
+// Created by Anton on 09.07.2025.
+//
+
+#include "../../include/objects/ModelAsset.hpp"
+#include "../../include/core/ResourceManager.hpp"
+#include "../../include/core/JobSystem.hpp"
+#include "../../include/core/MeshOptimizer.hpp"
+#include "../../include/core/GLCapabilities.hpp"
+#include "../../include/core/MeshCache.hpp"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/ProgressHandler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+    // Anteile der Phasen an GetProgress(): Assimp-Parser, Aufbereitung pro Mesh, GPU-Upload
+    constexpr float ParseShare = 0.4f;
+    constexpr float ProcessShare = 0.4f;
+
+    constexpr unsigned int ImportFlags = aiProcess_Triangulate |
+                                         aiProcess_FlipUVs |
+                                         aiProcess_OptimizeMeshes |
+                                         aiProcess_JoinIdenticalVertices |
+                                         aiProcess_SortByPType |
+                                         aiProcess_RemoveRedundantMaterials;
+    // Bei Änderungen an Konvertierung, MeshOptimizer oder MeshSimplifier erhöhen, damit alte Cache-Dateien verfallen
+    constexpr uint64_t ImportVersion = 1;
+    // Alles, was das Ergebnis des CPU-Imports bestimmt (Teil des MeshCache-Schlüssels)
+    constexpr uint64_t ImportSettings = static_cast<uint64_t>(ImportFlags) |
+                                        (static_cast<uint64_t>(MeshOptimizer::CacheSize) << 32) |
+                                        (static_cast<uint64_t>(MeshSimplifier::MaxLodLevels) << 40) |
+                                        (ImportVersion << 48);
+
+    // Textur- und Abhängigkeitspfade stehen im Cache relativ zum Modellordner, damit eine verschobene Quelle ihn weiter nutzt
+    std::string RelativeModelPath(const std::string& directory, const std::string& file) {
+        if (file.empty() || directory.empty()) return file;
+        const std::filesystem::path relative = std::filesystem::path(file).lexically_relative(directory);
+        return relative.empty() ? file : relative.generic_string();
+    }
+    std::string ResolveModelPath(const std::string& directory, const std::string& file) {
+        if (file.empty()) return file;
+        return (std::filesystem::path(directory) / file).lexically_normal().string();
+    }
+
+    // Merkt sich jede Datei, die Assimp erfolgreich öffnet (Quelle, .mtl, .bin, ...), für den Cache-Schlüssel
+    class RecordingIOSystem : public Assimp::DefaultIOSystem {
+    public:
+        Assimp::IOStream* Open(const char* file, const char* mode) override {
+            Assimp::IOStream* stream = DefaultIOSystem::Open(file, mode);
+            if (stream) {
+                const std::string normalized = std::filesystem::path(file).lexically_normal().string();
+                if (std::find(opened.begin(), opened.end(), normalized) == opened.end()) opened.push_back(normalized);
+            }
+            return stream;
+        }
+        const std::vector<std::string>& GetOpened() const { return opened; }
+    private:
+        std::vector<std::string> opened;
+    };
+
+    // Fortschritt aus Assimp (0..1 über Lesen und Post-Processing); false bricht ReadFile ab
+    class ImportProgress : public Assimp::ProgressHandler {
+    public:
+        ImportProgress(std::atomic<float>& progress, const std::atomic<bool>& cancel) : progress(progress), cancel(cancel) {}
+        bool Update(float percentage) override {
+            if (percentage >= 0.0f) progress.store(ParseShare * std::min(percentage, 1.0f), std::memory_order_relaxed);
+            return !cancel.load(std::memory_order_relaxed);
+        }
+    private:
+        std::atomic<float>& progress;
+        const std::atomic<bool>& cancel;
+    };
+}
+
+ModelAsset::ModelAsset(const std::string& path, std::string cacheDirectory)
+    : path(path), cacheDirectory(std::move(cacheDirectory))
+{
+}
+
+void ModelAsset::ImportCpu()
+{
+    pending = loadModel();
+    cpuDone.store(true, std::memory_order_release);
+}
+
+std::unique_ptr<ModelAsset::ImportData> ModelAsset::loadModel()
+{
+    if (cancelRequested.load(std::memory_order_relaxed)) return nullptr;
+    directory = std::filesystem::path(path).parent_path().string();
+
+    // Gekochte Fassung, falls vorhanden und zum aktuellen Inhalt der Quelle passend
+    MeshCache::Key key;
+    std::string cachePath;
+    if (!cacheDirectory.empty() && MeshCache::ComputeKey(path, ImportSettings, key)) {
+        cachePath = MeshCache::CachePath(cacheDirectory, path, key);
+        if (auto cooked = MeshCache::CookedModel::Open(cachePath, key, directory)) return loadCooked(std::move(cooked));
+    }
+
+    Assimp::Importer import;
+    // Der Importer übernimmt die Handler und löscht sie selbst
+    import.SetProgressHandler(new ImportProgress(progress, cancelRequested));
+    auto* io = new RecordingIOSystem();
+    import.SetIOHandler(io);
+
+    const aiScene *scene = import.ReadFile(path, ImportFlags);
+
+    if (cancelRequested.load(std::memory_order_relaxed)) return nullptr;
+    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    {
+        std::cout << "ERROR::ASSIMP::" << import.GetErrorString() << std::endl;
+        return nullptr;
+    }
+
+    // Alles außer der Quelle selbst (steckt schon im Schlüssel) muss beim nächsten Öffnen unverändert sein
+    std::vector<MeshCache::Dependency> dependencies;
+    if (!cachePath.empty()) {
+        const std::string source = std::filesystem::path(path).lexically_normal().string();
+        for (const std::string& file : io->GetOpened()) {
+            if (file == source) continue;
+            MeshCache::Dependency dependency;
+            dependency.path = RelativeModelPath(directory, file);
+            if (!MeshCache::HashFile(file, dependency.hash)) {
+                // Nicht nachprüfbar -> nicht kochen
+                cachePath.clear();
+                break;
+            }
+            dependencies.push_back(std::move(dependency));
+        }
+    }
+
+    // Meshes in Knoten-Reihenfolge einsammeln
+    std::vector<aiMesh*> sceneMeshes;
+    processNode(scene->mRootNode, scene, sceneMeshes);
+
+    auto data = std::make_unique<ImportData>();
+    // Texturen aller Materialien parallel dekodieren; hochgeladen wird erst in UploadStep
+    data->textures = ResourceManager::DecodeTextures(collectTexturePaths(scene));
+
+    // Assimp -> Vertex/Index-Arrays, Umsortierung für Vertex-Cache/Overdraw/Fetch und die LOD-Ketten
+    // sind reine CPU-Arbeit und laufen parallel pro Mesh (im Import-Job: nur über die Hintergrund-Queue)
+    data->meshes.resize(sceneMeshes.size());
+    std::vector<MeshOptimizer::Result> optimizeStats(sceneMeshes.size());
+    // Zum Kochen: alle Stufen so kodiert, wie UploadStep sie in die Arena legt (volle Stufe zuerst)
+    std::vector<std::vector<GeometryArena::EncodedMesh>> encoded(cachePath.empty() ? 0 : sceneMeshes.size());
+    std::atomic<size_t> processed{0};
+    JobSystem::Instance().ParallelFor(0, sceneMeshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (cancelRequested.load(std::memory_order_relaxed)) return;
+            ImportedMesh& mesh = data->meshes[i];
+            convertMesh(sceneMeshes[i], mesh.vertices, mesh.indices);
+            mesh.material = materialDesc(sceneMeshes[i], scene);
+            optimizeStats[i] = MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+            mesh.lods = MeshSimplifier::BuildLodChain(mesh.vertices, mesh.indices);
+            for (MeshSimplifier::LodLevel& lod : mesh.lods) MeshOptimizer::Optimize(lod.vertices, lod.indices);
+            if (!encoded.empty()) {
+                encoded[i].push_back(GeometryArena::Encode(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(),
+                                                           mesh.indices.size(), true));
+                for (const MeshSimplifier::LodLevel& lod : mesh.lods) {
+                    encoded[i].push_back(GeometryArena::Encode(lod.vertices.data(), lod.vertices.size(), lod.indices.data(),
+                                                               lod.indices.size(), true));
+                }
+            }
+            const size_t done = processed.fetch_add(1, std::memory_order_relaxed) + 1;
+            progress.store(ParseShare + ProcessShare * done / sceneMeshes.size(), std::memory_order_relaxed);
+        }
+    });
+    if (cancelRequested.load(std::memory_order_relaxed)) return nullptr;
+
+    MeshOptimizer::CacheStats before, after;
+    for (const MeshOptimizer::Result& stats : optimizeStats) {
+        before += stats.before;
+        after += stats.after;
+    }
+    std::cout << "[Model] " << path << ": ACMR " << before.Acmr() << " -> " << after.Acmr()
+              << ", ATVR " << before.Atvr() << " -> " << after.Atvr() << std::endl;
+
+    bool first = true;
+    for (const ImportedMesh& mesh : data->meshes) {
+        for (const Vertex& v : mesh.vertices) {
+            data->bounds.min = first ? v.position : glm::min(data->bounds.min, v.position);
+            data->bounds.max = first ? v.position : glm::max(data->bounds.max, v.position);
+            first = false;
+        }
+    }
+    data->bounds.center = (data->bounds.min + data->bounds.max) * 0.5f;
+    data->bounds.radius = glm::length(data->bounds.max - data->bounds.center);
+
+    // Für den nächsten Start kochen: kodierte Stufen, Bounds und die volle Stufe als Occluder
+    if (!cachePath.empty()) {
+        std::vector<MeshCache::MeshView> views(data->meshes.size());
+        std::vector<std::vector<glm::vec3>> occluderPositions(data->meshes.size());
+        for (size_t i = 0; i < views.size(); ++i) {
+            const ImportedMesh& mesh = data->meshes[i];
+            occluderPositions[i].reserve(mesh.vertices.size());
+            for (const Vertex& v : mesh.vertices) occluderPositions[i].push_back(v.position);
+            views[i].geometry = encoded[i][0].View();
+            views[i].occluderPositions = occluderPositions[i].data();
+            views[i].occluderIndices = mesh.indices.data();
+            views[i].bounds = Mesh::ComputeBounds(mesh.vertices);
+            for (size_t l = 0; l < mesh.lods.size(); ++l) views[i].lods.push_back({ encoded[i][l + 1].View(), mesh.lods[l].error });
+            views[i].material = mesh.material;
+            views[i].material.diffusePath = RelativeModelPath(directory, mesh.material.diffusePath);
+            views[i].material.specularPath = RelativeModelPath(directory, mesh.material.specularPath);
+        }
+        if (MeshCache::Write(cachePath, key, dependencies, views, data->bounds)) {
+            std::cout << "[Model] cooked " << path << " -> " << cachePath << std::endl;
+        }
+    }
+    return data;
+}
+
+std::unique_ptr<ModelAsset::ImportData> ModelAsset::loadCooked(std::unique_ptr<MeshCache::CookedModel> cooked)
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto data = std::make_unique<ImportData>();
+    const std::vector<MeshCache::MeshView>& views = cooked->GetMeshes();
+    data->meshes.resize(views.size());
+    std::vector<std::string> texturePaths;
+    for (size_t i = 0; i < views.size(); ++i) {
+        const MeshCache::MeshView& view = views[i];
+        ImportedMesh& mesh = data->meshes[i];
+        // Keine Kopie: alle Stufen gehen beim Upload unverändert aus der Abbildung in die Arena, Bounds und
+        // Occluder-Daten stehen ebenfalls in der Datei
+        mesh.cooked = &view;
+        mesh.material = view.material;
+        mesh.material.diffusePath = ResolveModelPath(directory, view.material.diffusePath);
+        mesh.material.specularPath = ResolveModelPath(directory, view.material.specularPath);
+        for (const std::string* texture : { &mesh.material.diffusePath, &mesh.material.specularPath }) {
+            if (!texture->empty()) texturePaths.push_back(*texture);
+        }
+    }
+    data->bounds = cooked->GetBounds();
+    data->textures = ResourceManager::DecodeTextures(texturePaths);
+    const size_t fileSize = cooked->GetFileSize();
+    // Die Abbildung lebt bis nach dem Upload, danach am Asset (Occluder-Daten)
+    data->cooked = std::move(cooked);
+    progress.store(ParseShare + ProcessShare, std::memory_order_relaxed);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Model] " << path << ": cooked cache, " << fileSize / 1024 << " KB in " << ms << " ms" << std::endl;
+    if (cancelRequested.load(std::memory_order_relaxed)) return nullptr;
+    return data;
+}
+
+bool ModelAsset::UploadStep(double budgetMs)
+{
+    if (GetState() != State::Loading) return true;
+    if (!cpuDone.load(std::memory_order_acquire)) return false;
+    if (cancelRequested.load(std::memory_order_relaxed)) {
+        // Schon hochgeladene Meshes geben ihren Arena-Bereich hier im Context-Thread frei
+        pending.reset();
+        meshes.clear();
+        Finish(State::Cancelled);
+        return true;
+    }
+    if (!pending) {
+        Finish(State::Failed);
+        return true;
+    }
+    // GL-Upload nur im Context-Thread
+    if (!GLCapabilities::IsContextThread()) {
+        std::cout << "[Model] " << path << ": upload outside the GL context thread, skipped" << std::endl;
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    ImportData& data = *pending;
+    if (!data.textures.empty()) {
+        ResourceManager::UploadTextures(data.textures);
+        data.textures.clear();
+    }
+    meshes.reserve(data.meshes.size());
+    while (data.uploaded < data.meshes.size()) {
+        ImportedMesh& source = data.meshes[data.uploaded++];
+        if (source.cooked) {
+            const MeshCache::MeshView& view = *source.cooked;
+            meshes.emplace_back(view.geometry, view.bounds, ResourceManager::GetMaterial(source.material));
+            meshes.back().SetExternalOccluder(view.occluderPositions, view.geometry.vertexCount, view.occluderIndices,
+                                              view.geometry.indexCount);
+            for (const MeshCache::LodView& lod : view.lods) meshes.back().AddLod(lod.geometry, lod.error);
+        } else {
+            // Importierte Assets sind die großen Meshes -> kompaktes Vertex-Layout
+            meshes.emplace_back(std::move(source.vertices), std::move(source.indices),
+                                ResourceManager::GetMaterial(source.material), true);
+            for (const MeshSimplifier::LodLevel& lod : source.lods) meshes.back().AddLod(lod.vertices, lod.indices, lod.error);
+        }
+        source = ImportedMesh();
+        progress.store(ParseShare + ProcessShare + (1.0f - ParseShare - ProcessShare) * data.uploaded / data.meshes.size(),
+                       std::memory_order_relaxed);
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= budgetMs) break;
+    }
+    if (data.uploaded < data.meshes.size()) return false;
+
+    size_t lodCount = 0;
+    for (const Mesh& mesh : meshes) lodCount += mesh.GetLodCount() - 1;
+    if (lodCount > 0) std::cout << "[Model] " << lodCount << " LOD levels for " << path << std::endl;
+    // Speicher pro Mesh gegenüber Vertex (32 Byte) + vec3-Positions-Stream und 32-Bit-Indizes
+    size_t totalBytes = 0, totalUncompressed = 0;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const size_t bytes = meshes[i].GetGpuBytes();
+        const size_t uncompressed = meshes[i].GetUncompressedBytes();
+        totalBytes += bytes;
+        totalUncompressed += uncompressed;
+        std::cout << "[Model]   mesh " << i << ": " << meshes[i].GetGeometry().vertexCount << " vertices, "
+                  << uncompressed / 1024 << " KB -> " << bytes / 1024 << " KB ("
+                  << (HasShortIndices(meshes[i].GetGeometry().format) ? "16" : "32") << "-bit indices)" << std::endl;
+    }
+    if (totalUncompressed > 0) {
+        std::cout << "[Model] geometry " << totalUncompressed / 1024 << " KB -> " << totalBytes / 1024 << " KB ("
+                  << 100 * totalBytes / totalUncompressed << "%)" << std::endl;
+    }
+
+    bounds = data.bounds;
+    // Die Occluder der Meshes zeigen in die Abbildung, sie bleibt so lange wie das Asset
+    cookedFile = std::move(data.cooked);
+    pending.reset();
+    Finish(State::Ready);
+    return true;
+}
+
+void ModelAsset::Finish(State result)
+{
+    if (result == State::Ready) progress.store(1.0f, std::memory_order_relaxed);
+    else if (result == State::Cancelled) std::cout << "[Model] import of " << path << " cancelled" << std::endl;
+    else std::cout << "[Model] import of " << path << " failed" << std::endl;
+    state.store(result, std::memory_order_release);
+}
+
+void ModelAsset::processNode(aiNode *node, const aiScene *scene, std::vector<aiMesh*>& out)
+{
+    // collect all the node's meshes (if any)
+    for(unsigned int i = 0; i < node->mNumMeshes; i++)
+    {
+        out.push_back(scene->mMeshes[node->mMeshes[i]]);
+    }
+    // then do the same for each of its children
+    for(unsigned int i = 0; i < node->mNumChildren; i++)
+    {
+        processNode(node->mChildren[i], scene, out);
+    }
+}
+
+void ModelAsset::convertMesh(const aiMesh *mesh, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    vertices.reserve(mesh->mNumVertices);
+    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+    {
+        Vertex vertex;
+        // process vertex positions, normals and texture coordinates
+        vertex.position.x = mesh->mVertices[i].x;
+        vertex.position.y = mesh->mVertices[i].y;
+        vertex.position.z = mesh->mVertices[i].z;
+        if(mesh->mNormals) {
+            vertex.normal.x = mesh->mNormals[i].x;
+            vertex.normal.y = mesh->mNormals[i].y;
+            vertex.normal.z = mesh->mNormals[i].z;
+        }
+
+        if(mesh->mTextureCoords[0])
+        {
+            glm::vec2 vec;
+            vec.x = mesh->mTextureCoords[0][i].x;
+            vec.y = 1.0f - mesh->mTextureCoords[0][i].y;
+            vertex.texCoords = vec;
+        }
+        else
+            vertex.texCoords = glm::vec2(0.0f, 0.0f);
+
+        vertices.push_back(vertex);
+    }
+    // process indices
+    indices.reserve(mesh->mNumFaces * 3);
+    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+    {
+        const aiFace& face = mesh->mFaces[i];
+        for(unsigned int j = 0; j < face.mNumIndices; j++)
+            indices.push_back(face.mIndices[j]);
+    }
+}
+
+MaterialDesc ModelAsset::materialDesc(const aiMesh *mesh, const aiScene *scene) const
+{
+    // Erste Diffuse-/Specular-Textur des Assimp-Materials; gleiche Kombinationen teilen sich ein Material
+    MaterialDesc desc;
+    if(mesh->mMaterialIndex < scene->mNumMaterials)
+    {
+        const aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+        desc.diffusePath = texturePath(material, aiTextureType_DIFFUSE);
+        desc.specularPath = texturePath(material, aiTextureType_SPECULAR);
+    }
+    return desc;
+}
+
+std::vector<std::string> ModelAsset::collectTexturePaths(const aiScene *scene) const
+{
+    std::vector<std::string> paths;
+    for(unsigned int m = 0; m < scene->mNumMaterials; m++)
+    {
+        const aiMaterial *mat = scene->mMaterials[m];
+        for (aiTextureType type : { aiTextureType_DIFFUSE, aiTextureType_SPECULAR })
+        {
+            std::string path = texturePath(mat, type);
+            if (!path.empty()) paths.push_back(std::move(path));
+        }
+    }
+    return paths;
+}
+
+std::string ModelAsset::texturePath(const aiMaterial *mat, aiTextureType type) const
+{
+    if(mat->GetTextureCount(type) == 0) return {};
+    aiString str;
+    mat->GetTexture(type, 0, &str);
+    return (std::filesystem::path(directory) / str.C_Str()).lexically_normal().string();
+}
@@ -0,0 +1,150 @@
+#include "TestFramework.hpp"
+#include "../include/core/EntityRegistry.hpp"
+#include <algorithm>
+#include <set>
+
+// Handles mit Generation, Sparse-Set-Pools (Swap-Remove) und Views über mehrere Komponenten.
+// Eigene Registry pro Test, die Engine-Instanz bleibt unberührt.
+
+namespace {
+    struct Position { int x = 0; };
+    struct Velocity { int dx = 0; };
+    struct Tag {};
+}
+
+TEST(HandlesCarryGeneration) {
+    EntityRegistry registry;
+    const Entity a = registry.Create();
+    const Entity b = registry.Create();
+    CHECK(registry.IsAlive(a));
+    CHECK(registry.IsAlive(b));
+    CHECK(a != b);
+    CHECK_EQ(registry.AliveCount(), size_t(2));
+
+    registry.Destroy(a);
+    CHECK(!registry.IsAlive(a));
+    CHECK_EQ(registry.AliveCount(), size_t(1));
+
+    // Index wird wiederverwendet, das alte Handle bleibt ungültig
+    const Entity c = registry.Create();
+    CHECK_EQ(EntityIndex(c), EntityIndex(a));
+    CHECK(EntityGeneration(c) != EntityGeneration(a));
+    CHECK(registry.IsAlive(c));
+    CHECK(!registry.IsAlive(a));
+    CHECK(!registry.IsAlive(NullEntity));
+
+    // Doppeltes Destroy ist harmlos
+    registry.Destroy(a);
+    CHECK(registry.IsAlive(c));
+}
+
+TEST(ComponentsAddGetRemove) {
+    EntityRegistry registry;
+    const Entity e = registry.Create();
+    registry.Add<Position>(e, { 5 });
+    CHECK(registry.Has<Position>(e));
+    CHECK(!registry.Has<Velocity>(e));
+    CHECK_EQ(registry.Get<Position>(e).x, 5);
+    CHECK(registry.TryGet<Velocity>(e) == nullptr);
+
+    // Erneutes Add überschreibt
+    registry.Add<Position>(e, { 7 });
+    CHECK_EQ(registry.Get<Position>(e).x, 7);
+    CHECK_EQ(registry.Pool<Position>().Size(), size_t(1));
+
+    registry.Remove<Position>(e);
+    CHECK(!registry.Has<Position>(e));
+    CHECK(registry.IsAlive(e));
+}
+
+TEST(SwapRemoveKeepsOtherComponents) {
+    EntityRegistry registry;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 100; ++i) {
+        entities.push_back(registry.Create());
+        registry.Add<Position>(entities.back(), { i });
+    }
+    // Jede dritte entfernen: das letzte Element rückt jeweils in die Lücke
+    for (int i = 0; i < 100; i += 3) registry.Remove<Position>(entities[i]);
+
+    int wrong = 0;
+    for (int i = 0; i < 100; ++i) {
+        const bool expected = i % 3 != 0;
+        if (registry.Has<Position>(entities[i]) != expected) ++wrong;
+        else if (expected && registry.Get<Position>(entities[i]).x != i) ++wrong;
+    }
+    CHECK_EQ(wrong, 0);
+    CHECK_EQ(registry.Pool<Position>().Size(), size_t(66));
+}
+
+TEST(DestroyRemovesAllComponents) {
+    EntityRegistry registry;
+    const Entity e = registry.Create();
+    registry.Add<Position>(e, { 1 });
+    registry.Add<Velocity>(e, { 2 });
+    registry.Add<Tag>(e);
+    registry.Destroy(e);
+    CHECK_EQ(registry.Pool<Position>().Size(), size_t(0));
+    CHECK_EQ(registry.Pool<Velocity>().Size(), size_t(0));
+    CHECK_EQ(registry.Pool<Tag>().Size(), size_t(0));
+
+    // Ein neues Entity auf demselben Index erbt nichts
+    const Entity f = registry.Create();
+    CHECK_EQ(EntityIndex(f), EntityIndex(e));
+    CHECK(!registry.Has<Position>(f));
+    CHECK(!registry.Has<Position>(e));
+}
+
+TEST(ViewIteratesIntersection) {
+    EntityRegistry registry;
+    std::set<Entity> both;
+    for (int i = 0; i < 50; ++i) {
+        const Entity e = registry.Create();
+        if (i % 2 == 0) registry.Add<Position>(e, { i });
+        if (i % 3 == 0) registry.Add<Velocity>(e, { i * 10 });
+        if (i % 6 == 0) both.insert(e);
+    }
+
+    std::set<Entity> seen;
+    int mismatched = 0;
+    registry.View<Position, Velocity>().Each([&](Entity e, Position& p, Velocity& v) {
+        seen.insert(e);
+        if (v.dx != p.x * 10) ++mismatched;
+        p.x += 1000;
+    });
+    CHECK(seen == both);
+    CHECK_EQ(mismatched, 0);
+    // Änderungen über die View landen im Pool
+    for (Entity e : both) CHECK(registry.Get<Position>(e).x >= 1000);
+
+    size_t single = 0;
+    registry.View<Position>().Each([&](Entity, Position&) { ++single; });
+    CHECK_EQ(single, size_t(25));
+}
+
+TEST(ClearInvalidatesHandles) {
+    EntityRegistry registry;
+    const Entity a = registry.Create();
+    registry.Add<Position>(a, { 3 });
+    registry.Clear();
+    CHECK(!registry.IsAlive(a));
+    CHECK_EQ(registry.AliveCount(), size_t(0));
+    CHECK_EQ(registry.Pool<Position>().Size(), size_t(0));
+
+    const Entity b = registry.Create();
+    CHECK(registry.IsAlive(b));
+    CHECK(b != a);
+    CHECK(!registry.Has<Position>(b));
+}
+
+TEST(RegistriesAreIndependent) {
+    EntityRegistry first, second;
+    const Entity e = first.Create();
+    first.Add<Position>(e, { 1 });
+    CHECK_EQ(second.Pool<Position>().Size(), size_t(0));
+    CHECK(!second.IsAlive(e));
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,125 @@
+#include "TestFramework.hpp"
+#include "../include/core/FrustumCuller.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// SIMD-Pfade (AVX/SSE, je nach Build) gegen einen skalaren Referenztest mit derselben Formel, dazu
+// bekannte Fälle und die Welt-AABB aus Set() gegen die acht transformierten Ecken.
+
+namespace {
+    Frustum CameraFrustum() {
+        const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::FromMatrix(proj * view);
+    }
+
+    bool ReferenceVisible(const Frustum& frustum, const glm::vec3& c, const glm::vec3& e) {
+        for (const auto& p : frustum.planes) {
+            const float d = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+            const float r = std::fabs(p.x) * e.x + std::fabs(p.y) * e.y + std::fabs(p.z) * e.z;
+            if (d < -r) return false;
+        }
+        return true;
+    }
+}
+
+TEST(PlanesAreNormalized) {
+    const Frustum frustum = CameraFrustum();
+    for (const auto& p : frustum.planes) CHECK(std::fabs(glm::length(glm::vec3(p)) - 1.0f) < 1e-5f);
+    // Punkt auf der Blickachse liegt vor allen Ebenen
+    const glm::vec3 inside(0.0f, 1.0f, 2.5f);
+    for (const auto& p : frustum.planes) CHECK(glm::dot(glm::vec3(p), inside) + p.w > 0.0f);
+}
+
+TEST(KnownBoxes) {
+    const Frustum frustum = CameraFrustum();
+    FrustumCuller culler;
+    culler.AddWorld(glm::vec3(0.0f), glm::vec3(0.5f));                     // Blickziel
+    culler.AddWorld(glm::vec3(0.0f, 2.0f, 20.0f), glm::vec3(1.0f));         // hinter der Kamera
+    culler.AddWorld(glm::vec3(0.0f), glm::vec3(1000.0f));                   // umschließt das ganze Frustum
+    culler.AddWorld(glm::vec3(0.0f, 0.0f, -200.0f), glm::vec3(1.0f));       // hinter der Far-Plane
+    culler.AddWorld(glm::vec3(0.0f, 0.0f, -100.0f), glm::vec3(10.0f));      // schneidet die Far-Plane
+    culler.AddWorld(glm::vec3(200.0f, 0.0f, 0.0f), glm::vec3(1.0f));        // weit rechts
+    std::vector<uint8_t> visible;
+    CHECK_EQ(culler.Cull(frustum, visible), size_t(3));
+    CHECK(visible == std::vector<uint8_t>({ 1, 0, 1, 0, 1, 0 }));
+}
+
+TEST(SimdMatchesScalarReference) {
+    const Frustum frustum = CameraFrustum();
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<float> pos(-60.0f, 60.0f), ext(0.0f, 3.0f);
+    // Größen, bei denen AVX-, SSE- und skalare Reste in allen Kombinationen vorkommen
+    for (size_t n : { size_t(0), size_t(1), size_t(3), size_t(4), size_t(7), size_t(8), size_t(13), size_t(17), size_t(4099) }) {
+        FrustumCuller culler;
+        for (size_t i = 0; i < n; ++i) {
+            culler.AddWorld(glm::vec3(pos(rng), pos(rng) * 0.3f, pos(rng)), glm::vec3(ext(rng), ext(rng), ext(rng)));
+        }
+        std::vector<uint8_t> visible;
+        const size_t count = culler.Cull(frustum, visible);
+        size_t expectedCount = 0, mismatches = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const bool expected = ReferenceVisible(frustum, culler.GetCenter(i), culler.GetExtents(i));
+            expectedCount += expected ? 1 : 0;
+            if (visible[i] != (expected ? 1 : 0)) ++mismatches;
+        }
+        CHECK_EQ(mismatches, size_t(0));
+        CHECK_EQ(count, expectedCount);
+    }
+}
+
+TEST(CullRangeWithUnalignedStart) {
+    // ParallelFor teilt in beliebige Blöcke; jeder Teilbereich muss dasselbe liefern wie der Gesamtlauf
+    const Frustum frustum = CameraFrustum();
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(-40.0f, 40.0f), ext(0.1f, 2.0f);
+    FrustumCuller culler;
+    for (int i = 0; i < 1000; ++i) culler.AddWorld(glm::vec3(pos(rng), pos(rng), pos(rng)), glm::vec3(ext(rng)));
+    std::vector<uint8_t> whole;
+    const size_t total = culler.Cull(frustum, whole);
+
+    std::vector<uint8_t> parts(culler.Size(), 2);
+    size_t sum = 0;
+    for (size_t begin = 0; begin < culler.Size();) {
+        const size_t end = std::min(culler.Size(), begin + 1 + begin % 13);
+        sum += culler.CullRange(frustum, parts.data(), begin, end);
+        begin = end;
+    }
+    CHECK(parts == whole);
+    CHECK_EQ(sum, total);
+}
+
+TEST(WorldBoundsEncloseTransformedCorners) {
+    // Arvo liefert die kleinste achsenparallele Box um die acht transformierten Ecken
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+    int failures = 0;
+    for (int i = 0; i < 200; ++i) {
+        const glm::vec3 localMin(value(rng), value(rng), value(rng));
+        const glm::vec3 localMax = localMin + glm::abs(glm::vec3(value(rng), value(rng), value(rng)));
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(value(rng), value(rng), value(rng)) * 10.0f);
+        model = model * glm::mat4_cast(glm::angleAxis(value(rng), glm::normalize(glm::vec3(value(rng), value(rng), 1.0f))));
+        model = glm::scale(model, glm::abs(glm::vec3(value(rng), value(rng), value(rng))) + glm::vec3(0.1f));
+
+        glm::vec3 cornerMin(1e30f), cornerMax(-1e30f);
+        for (int c = 0; c < 8; ++c) {
+            const glm::vec3 local((c & 1) ? localMax.x : localMin.x, (c & 2) ? localMax.y : localMin.y, (c & 4) ? localMax.z : localMin.z);
+            const glm::vec3 world(model * glm::vec4(local, 1.0f));
+            cornerMin = glm::min(cornerMin, world);
+            cornerMax = glm::max(cornerMax, world);
+        }
+        FrustumCuller culler;
+        culler.Add(localMin, localMax, model);
+        const glm::vec3 center = culler.GetCenter(0), extents = culler.GetExtents(0);
+        const glm::vec3 error = glm::max(glm::abs(center - extents - cornerMin), glm::abs(center + extents - cornerMax));
+        if (std::max({ error.x, error.y, error.z }) > 1e-4f) ++failures;
+    }
+    CHECK_EQ(failures, 0);
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "glad/glad.h"
+#include "../include/core/GLCapabilities.hpp"
+#include <iostream>
+
+// Offscreen-GL-Kontext für Tests. Mit ARK_TEST_EGL (Linux) ohne Fenster und Display über EGL, z.B. Mesa llvmpipe
+// (LIBGL_ALWAYS_SOFTWARE=1); sonst über ein unsichtbares GLFW-Fenster. Versucht erst GL 4.6 (Compute-Pfade),
+// dann 3.3. Liefert false, wenn kein Kontext zu bekommen ist; der Test meldet sich dann mit Test::SkipCode.
+#ifdef ARK_TEST_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace Test {
+    inline bool CreateGLContext() {
+        EGLDisplay display = EGL_NO_DISPLAY;
+        // Surfaceless (Mesa) braucht weder X11 noch Wayland
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) return false;
+
+        // Ohne Surface reicht ein Kontext ohne Config (EGL_KHR_no_config_context), surfaceless bietet oft keine an
+        const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+        EGLConfig config = EGL_NO_CONFIG_KHR;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) config = EGL_NO_CONFIG_KHR;
+        if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+        const EGLint versions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 3 }, { 3, 3 } };
+        for (const auto& version : versions) {
+            const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, version[0], EGL_CONTEXT_MINOR_VERSION, version[1],
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE,
+            };
+            EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+            if (context == EGL_NO_CONTEXT) continue;
+            if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) &&
+                gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+                // Ohne Surface gibt es keinen Default-Framebuffer, Draws (auch mit RASTERIZER_DISCARD)
+                // brauchen aber einen vollständigen -> 1x1-FBO bleibt für die Laufzeit gebunden
+                GLuint framebuffer = 0, color = 0;
+                glGenFramebuffers(1, &framebuffer);
+                glGenRenderbuffers(1, &color);
+                glBindRenderbuffer(GL_RENDERBUFFER, color);
+                glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 1, 1);
+                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+                glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+                GLCapabilities::SetContextThread();
+                std::cout << "[Test] GL " << glGetString(GL_VERSION) << " (" << glGetString(GL_RENDERER) << ")" << std::endl;
+                return true;
+            }
+            eglDestroyContext(display, context);
+        }
+        return false;
+    }
+}
+#else
+#include <GLFW/glfw3.h>
+
+namespace Test {
+    inline bool CreateGLContext() {
+        if (!glfwInit()) return false;
+        const int versions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 3 }, { 3, 3 } };
+        for (const auto& version : versions) {
+            glfwDefaultWindowHints();
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+            GLFWwindow* window = glfwCreateWindow(64, 64, "ArkTest", nullptr, nullptr);
+            if (!window) continue;
+            glfwMakeContextCurrent(window);
+            if (gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+                GLCapabilities::SetContextThread();
+                std::cout << "[Test] GL " << glGetString(GL_VERSION) << " (" << glGetString(GL_RENDERER) << ")" << std::endl;
+                return true;
+            }
+            glfwDestroyWindow(window);
+        }
+        return false;
+    }
+}
+#endif
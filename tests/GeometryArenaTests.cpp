@@ -0,0 +1,151 @@
+#include "TestFramework.hpp"
+#include "GLTestContext.hpp"
+#include "../include/objects/Mesh.hpp"
+#include <cstring>
+#include <vector>
+
+// Deduplizierung über den 128-Bit-Inhaltshash, Referenzzählung und Kompaktieren der Pools.
+// Die Arena ist ein Singleton; jeder Test gibt seine Handles wieder frei.
+
+namespace {
+    struct TestGeometry {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    TestGeometry Grid(int size, float height) {
+        TestGeometry grid;
+        for (int y = 0; y <= size; ++y) {
+            for (int x = 0; x <= size; ++x) {
+                const glm::vec2 uv(static_cast<float>(x) / size, static_cast<float>(y) / size);
+                grid.vertices.push_back({ glm::vec3(uv.x, height * uv.x * uv.y, uv.y), glm::vec3(0.0f, 1.0f, 0.0f), uv });
+            }
+        }
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const uint32_t a = y * (size + 1) + x, b = a + 1, c = a + size + 1, d = c + 1;
+                for (uint32_t v : { a, c, b, b, c, d }) grid.indices.push_back(v);
+            }
+        }
+        return grid;
+    }
+
+    uint32_t Allocate(const TestGeometry& g, bool compact = false) {
+        return GeometryArena::Instance().Allocate(g.vertices.data(), g.vertices.size(), g.indices.data(), g.indices.size(), compact);
+    }
+
+    std::vector<Vertex> ReadVertices(uint32_t handle) {
+        // Nur der Test liest zurück; VAO des Formats hält den Vertex-Buffer als Attribut 0
+        const GeometryArena::Range& r = GeometryArena::Instance().Get(handle);
+        GeometryArena::Instance().BindVertexFormat(r.format);
+        GLint buffer = 0;
+        glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+        glBindVertexArray(0);
+        std::vector<Vertex> out(r.vertexCount);
+        glBindBuffer(GL_COPY_READ_BUFFER, static_cast<GLuint>(buffer));
+        glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(r.baseVertex) * sizeof(Vertex),
+                           static_cast<GLsizeiptr>(r.vertexCount * sizeof(Vertex)), out.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return out;
+    }
+}
+
+TEST(IdenticalGeometrySharesRange) {
+    GeometryArena& arena = GeometryArena::Instance();
+    const TestGeometry grid = Grid(8, 1.0f);
+    const uint32_t a = Allocate(grid);
+    const uint32_t b = Allocate(grid);
+    CHECK(a != GeometryArena::InvalidHandle);
+    CHECK_EQ(a, b);
+    CHECK_EQ(arena.Get(a).refCount, uint32_t(2));
+    CHECK(arena.Get(a).format == VertexFormat::Standard16);
+
+    // Die erste Freigabe behält den Bereich, die zweite gibt ihn frei
+    arena.Free(a);
+    CHECK(arena.Get(a).alive);
+    arena.Free(b);
+    CHECK(!arena.Get(a).alive);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+TEST(DifferentGeometryGetsOwnRange) {
+    GeometryArena& arena = GeometryArena::Instance();
+    const TestGeometry grid = Grid(8, 1.0f);
+    const uint32_t base = Allocate(grid);
+
+    TestGeometry moved = grid;
+    moved.vertices[17].position.y += 1e-3f;
+    TestGeometry renumbered = grid;
+    std::swap(renumbered.indices[0], renumbered.indices[1]);
+    TestGeometry shorter = grid;
+    shorter.indices.resize(shorter.indices.size() - 3);
+
+    std::vector<uint32_t> handles = { Allocate(moved), Allocate(renumbered), Allocate(shorter), Allocate(grid, true) };
+    for (uint32_t h : handles) {
+        CHECK(h != base);
+        CHECK_EQ(arena.Get(h).refCount, uint32_t(1));
+    }
+    CHECK(arena.Get(handles.back()).format == VertexFormat::Compact16);
+    CHECK(ReadVertices(handles[0])[17].position.y == moved.vertices[17].position.y);
+
+    handles.push_back(base);
+    for (uint32_t h : handles) arena.Free(h);
+}
+
+TEST(LargeMeshUsesFullIndices) {
+    GeometryArena& arena = GeometryArena::Instance();
+    const TestGeometry grid = Grid(300, 0.5f);
+    const uint32_t a = Allocate(grid);
+    const uint32_t b = Allocate(grid);
+    CHECK_EQ(a, b);
+    CHECK(arena.Get(a).format == VertexFormat::Standard);
+    arena.Free(a);
+    arena.Free(b);
+}
+
+TEST(PreEncodedMatchesVertexPath) {
+    // Gekochte Daten (Encode, später aus der .arkmesh-Datei) landen im selben Bereich wie der Vertex-Pfad
+    GeometryArena& arena = GeometryArena::Instance();
+    for (bool compact : { false, true }) {
+        const TestGeometry grid = Grid(10, 2.0f);
+        const uint32_t direct = Allocate(grid, compact);
+        const GeometryArena::EncodedMesh encoded =
+            GeometryArena::Encode(grid.vertices.data(), grid.vertices.size(), grid.indices.data(), grid.indices.size(), compact);
+        CHECK(encoded.format == arena.Get(direct).format);
+        CHECK_EQ(encoded.indices.size(), grid.indices.size() * sizeof(uint16_t));
+        const uint32_t cooked = arena.Allocate(encoded.View());
+        CHECK_EQ(cooked, direct);
+        CHECK_EQ(arena.Get(direct).refCount, uint32_t(2));
+        arena.Free(direct);
+        arena.Free(cooked);
+    }
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+TEST(DeduplicationSurvivesDefragment) {
+    GeometryArena& arena = GeometryArena::Instance();
+    std::vector<uint32_t> handles;
+    for (int i = 0; i < 8; ++i) handles.push_back(Allocate(Grid(6, static_cast<float>(i))));
+    // Lücken erzeugen, dann verschieben
+    for (int i = 0; i < 8; i += 2) arena.Free(handles[i]);
+    arena.Defragment(VertexFormat::Standard16);
+
+    const TestGeometry kept = Grid(6, 3.0f);
+    const uint32_t again = Allocate(kept);
+    CHECK_EQ(again, handles[3]);
+    CHECK_EQ(arena.Get(again).refCount, uint32_t(2));
+    const std::vector<Vertex> stored = ReadVertices(again);
+    CHECK(std::memcmp(stored.data(), kept.vertices.data(), stored.size() * sizeof(Vertex)) == 0);
+
+    arena.Free(again);
+    for (int i = 1; i < 8; i += 2) arena.Free(handles[i]);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+int main() {
+    if (!Test::CreateGLContext()) {
+        std::cout << "[Test] kein GL-Kontext, übersprungen" << std::endl;
+        return Test::SkipCode;
+    }
+    return Test::RunAll();
+}
@@ -0,0 +1,177 @@
+#include "TestFramework.hpp"
+#include "GLTestContext.hpp"
+#include "../include/core/GpuCuller.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <tuple>
+
+// Beide GPU-Pfade gegen FrustumCuller auf der CPU: Anzahl pro Batch und Inhalt der Ausgabe (bitgenau, Reihenfolge egal).
+// Braucht einen GL-Kontext (headless z.B. Mesa llvmpipe); Shader werden relativ zum Quellverzeichnis geladen.
+
+namespace {
+    struct Scene {
+        std::vector<InstanceData> instances;
+        std::vector<CullBounds> bounds;
+        std::vector<RenderQueue::Batch> batches;
+        Frustum frustum{};
+        // Erwartung der CPU, pro Batch die sichtbaren Instanzen
+        std::vector<std::vector<InstanceData>> expected;
+    };
+
+    bool Visible(FrustumCuller& cpu, const Frustum& frustum) {
+        std::vector<uint8_t> visible;
+        return cpu.Cull(frustum, visible) == 1;
+    }
+
+    // Zufällige, gedrehte Instanzen in Batches ungleicher Größe. Instanzen, die so knapp an einer Ebene liegen,
+    // dass CPU und GPU wegen Rundung verschieden entscheiden dürften, werden weggelassen.
+    Scene MakeScene(size_t batchCount) {
+        Scene scene;
+        const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 120.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        scene.frustum = Frustum::FromMatrix(proj * view);
+        Frustum inner = scene.frustum, outer = scene.frustum;
+        for (int i = 0; i < 6; ++i) {
+            inner.planes[i].w -= 0.01f;
+            outer.planes[i].w += 0.01f;
+        }
+
+        std::mt19937 rng(97531);
+        std::uniform_real_distribution<float> pos(-100.0f, 100.0f), size(0.2f, 4.0f), axis(-1.0f, 1.0f), offset(-0.5f, 0.5f);
+        for (size_t b = 0; b < batchCount; ++b) {
+            RenderQueue::Batch batch;
+            batch.first = static_cast<uint32_t>(scene.instances.size());
+            // Lokale AABB pro Batch verschieden (wie unterschiedliche Meshes)
+            const glm::vec3 localCenter(offset(rng), offset(rng), offset(rng));
+            const glm::vec3 localExtents(0.25f + 0.1f * b, 0.5f, 0.75f);
+            const size_t target = 100 + 700 * b;
+            std::vector<InstanceData> visible;
+            while (scene.instances.size() - batch.first < target) {
+                const glm::vec3 position(pos(rng), pos(rng) * 0.2f, pos(rng));
+                const glm::vec3 scale(size(rng), size(rng), size(rng));
+                const glm::quat rotation = glm::angleAxis(axis(rng) * 3.14159f, glm::normalize(glm::vec3(axis(rng), 1.0f, axis(rng))));
+                const InstanceData instance = InstanceData::Make(position, rotation, scale, static_cast<uint32_t>(b * 1000 + scene.instances.size()));
+
+                // Gleiche Transformation wie die Shader: gespeicherte (quantisierte) Rotation
+                const glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(instance.Rotation()), scale);
+                FrustumCuller cpu;
+                cpu.Add(localCenter - localExtents, localCenter + localExtents, model);
+                const bool inside = Visible(cpu, inner);
+                if (inside != Visible(cpu, outer)) continue;
+
+                scene.instances.push_back(instance);
+                scene.bounds.push_back({ localCenter, static_cast<uint32_t>(b), localExtents, 0.0f });
+                if (inside) visible.push_back(instance);
+            }
+            batch.count = static_cast<uint32_t>(target);
+            scene.batches.push_back(batch);
+            scene.expected.push_back(std::move(visible));
+        }
+        return scene;
+    }
+
+    bool Less(const InstanceData& a, const InstanceData& b) {
+        return std::memcmp(&a, &b, sizeof(InstanceData)) < 0;
+    }
+
+    std::vector<InstanceData> ReadOutput(const GpuCuller& culler, const RenderQueue::Batch& batch, uint32_t count) {
+        std::vector<InstanceData> out(count);
+        if (count == 0) return out;
+        glBindBuffer(GL_COPY_READ_BUFFER, culler.GetOutputBuffer());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(batch.first * sizeof(InstanceData)),
+                           static_cast<GLsizeiptr>(count * sizeof(InstanceData)), out.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return out;
+    }
+
+    // Anzahl und Inhalt pro Batch gegen die CPU-Erwartung
+    void CheckAgainstCpu(const Scene& scene, const GpuCuller& culler, const std::vector<uint32_t>& counts) {
+        CHECK_EQ(counts.size(), scene.batches.size());
+        for (size_t b = 0; b < scene.batches.size() && b < counts.size(); ++b) {
+            CHECK_EQ(counts[b], static_cast<uint32_t>(scene.expected[b].size()));
+            if (counts[b] != scene.expected[b].size()) continue;
+            std::vector<InstanceData> gpu = ReadOutput(culler, scene.batches[b], counts[b]);
+            std::vector<InstanceData> cpu = scene.expected[b];
+            std::sort(gpu.begin(), gpu.end(), Less);
+            std::sort(cpu.begin(), cpu.end(), Less);
+            CHECK(std::memcmp(gpu.data(), cpu.data(), gpu.size() * sizeof(InstanceData)) == 0);
+        }
+    }
+
+    std::vector<uint32_t> ReadIndirectCounts(GLuint indirect, size_t batchCount) {
+        std::vector<DrawElementsIndirectCommand> commands(batchCount);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+        glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(batchCount * sizeof(DrawElementsIndirectCommand)),
+                           commands.data());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        std::vector<uint32_t> counts;
+        for (const auto& c : commands) counts.push_back(c.instanceCount);
+        return counts;
+    }
+}
+
+TEST(TransformFeedbackMatchesCpu) {
+    const Scene scene = MakeScene(4);
+    GpuCuller culler;
+    culler.Init(false);
+    CHECK(culler.GetMode() == GpuCuller::Mode::TransformFeedback);
+    culler.Upload(scene.instances.data(), scene.bounds.data(), scene.instances.size());
+
+    // Zweimal hintereinander: Queries und Ausgabe werden pro Frame wiederverwendet
+    for (int frame = 0; frame < 2; ++frame) {
+        culler.Cull(scene.frustum, scene.batches, 0);
+        CheckAgainstCpu(scene, culler, culler.ReadVisibleCounts());
+    }
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+TEST(TransformFeedbackCullDoesNotWaitForResults) {
+    // Cull setzt nur ab; erst ReadVisibleCounts() liest die Queries
+    const Scene scene = MakeScene(2);
+    GpuCuller culler;
+    culler.Init(false);
+    culler.Upload(scene.instances.data(), scene.bounds.data(), scene.instances.size());
+    culler.Cull(scene.frustum, scene.batches, 0);
+    const std::vector<uint32_t> counts = culler.ReadVisibleCounts();
+    CHECK_EQ(counts.size(), size_t(2));
+    // Ohne neues Cull liefert ein zweiter Aufruf dasselbe, ohne die GPU erneut zu fragen
+    CHECK(culler.ReadVisibleCounts() == counts);
+}
+
+TEST(ComputeMatchesCpu) {
+    const GLCapabilities& caps = GLCapabilities::Get();
+    if (!(caps.computeShader && caps.multiDrawIndirect)) {
+        std::cout << "  Compute-Pfad nicht verfügbar, übersprungen" << std::endl;
+        return;
+    }
+    const Scene scene = MakeScene(4);
+    GpuCuller culler;
+    culler.Init(true);
+    CHECK(culler.GetMode() == GpuCuller::Mode::Compute);
+    culler.Upload(scene.instances.data(), scene.bounds.data(), scene.instances.size());
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    for (const auto& batch : scene.batches) commands.push_back({ 36, 0, 0, 0, batch.first });
+    GLuint indirect = 0;
+    glGenBuffers(1, &indirect);
+    for (int frame = 0; frame < 2; ++frame) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        culler.Cull(scene.frustum, scene.batches, indirect);
+        CheckAgainstCpu(scene, culler, ReadIndirectCounts(indirect, scene.batches.size()));
+    }
+    glDeleteBuffers(1, &indirect);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+int main() {
+    if (!Test::CreateGLContext()) {
+        std::cout << "[Test] kein GL-Kontext, übersprungen" << std::endl;
+        return Test::SkipCode;
+    }
+    return Test::RunAll();
+}
@@ -0,0 +1,106 @@
+#include "TestFramework.hpp"
+#include "GLTestContext.hpp"
+#include "../include/core/InstanceRingBuffer.hpp"
+#include <cstring>
+#include <vector>
+
+// Regionen pro Frame, Wachsen per Reserve und der Ersatzweg, wenn Map() nichts liefert
+
+namespace {
+    std::vector<uint32_t> ReadBack(unsigned int buffer, size_t offset, size_t count) {
+        std::vector<uint32_t> out(count);
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(count * sizeof(uint32_t)), out.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return out;
+    }
+
+    std::vector<uint32_t> Sequence(size_t count, uint32_t start) {
+        std::vector<uint32_t> values(count);
+        for (size_t i = 0; i < count; ++i) values[i] = start + static_cast<uint32_t>(i);
+        return values;
+    }
+}
+
+TEST(FramesUseSeparateRegions) {
+    InstanceRingBuffer ring;
+    ring.Init(1024);
+    size_t offsets[InstanceRingBuffer::FramesInFlight + 1] = {};
+    for (int frame = 0; frame <= InstanceRingBuffer::FramesInFlight; ++frame) {
+        ring.BeginFrame();
+        const std::vector<uint32_t> values = Sequence(64, frame * 1000);
+        void* dst = ring.Map(values.size() * sizeof(uint32_t), offsets[frame]);
+        CHECK(dst != nullptr);
+        if (dst) std::memcpy(dst, values.data(), values.size() * sizeof(uint32_t));
+        ring.Unmap();
+        CHECK(ReadBack(ring.GetBuffer(), offsets[frame], values.size()) == values);
+        ring.EndFrame();
+    }
+    // Drei verschiedene Regionen, danach wieder die erste
+    CHECK(offsets[0] != offsets[1]);
+    CHECK(offsets[1] != offsets[2]);
+    CHECK_EQ(offsets[InstanceRingBuffer::FramesInFlight], offsets[0]);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+TEST(ReserveGrowsRegion) {
+    InstanceRingBuffer ring;
+    ring.Init(256);
+    ring.BeginFrame();
+    const std::vector<uint32_t> values = Sequence(1000, 7);
+    const size_t bytes = values.size() * sizeof(uint32_t);
+    size_t offset = 0;
+    CHECK(ring.Map(bytes, offset) == nullptr);
+    ring.Reserve(bytes);
+    void* dst = ring.Map(bytes, offset);
+    CHECK(dst != nullptr);
+    if (dst) std::memcpy(dst, values.data(), bytes);
+    ring.Unmap();
+    CHECK(ReadBack(ring.GetBuffer(), offset, values.size()) == values);
+    ring.EndFrame();
+}
+
+TEST(FailedMapLeavesNoBufferBound) {
+    InstanceRingBuffer ring;
+    ring.Init(256);
+    ring.BeginFrame();
+    size_t offset = 0;
+    CHECK(ring.Map(4096, offset) == nullptr);
+    GLint bound = -1;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &bound);
+    CHECK_EQ(bound, 0);
+    ring.EndFrame();
+}
+
+TEST(FallbackUploadsAndCounts) {
+    InstanceRingBuffer ring;
+    ring.Init(256);
+    ring.BeginFrame();
+    CHECK_EQ(ring.FallbacksThisFrame(), 0);
+    const std::vector<uint32_t> first = Sequence(500, 1);
+    const unsigned int buffer = ring.UploadFallback(first.data(), first.size() * sizeof(uint32_t));
+    CHECK(buffer != 0);
+    CHECK(buffer != ring.GetBuffer());
+    CHECK(ReadBack(buffer, 0, first.size()) == first);
+    CHECK_EQ(ring.FallbacksThisFrame(), 1);
+
+    // Zweiter Upload im selben Buffer (verwaist), andere Größe
+    const std::vector<uint32_t> second = Sequence(2000, 100);
+    CHECK_EQ(ring.UploadFallback(second.data(), second.size() * sizeof(uint32_t)), buffer);
+    CHECK(ReadBack(buffer, 0, second.size()) == second);
+    CHECK_EQ(ring.FallbacksThisFrame(), 2);
+    ring.EndFrame();
+
+    ring.BeginFrame();
+    CHECK_EQ(ring.FallbacksThisFrame(), 0);
+    ring.EndFrame();
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+int main() {
+    if (!Test::CreateGLContext()) {
+        std::cout << "[Test] kein GL-Kontext, übersprungen" << std::endl;
+        return Test::SkipCode;
+    }
+    return Test::RunAll();
+}
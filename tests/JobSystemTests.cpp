@@ -0,0 +1,306 @@
+#include "TestFramework.hpp"
+#include "../include/core/JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Korrektheit von Countern, Abhängigkeiten und Stealing sowie Skalierung von ParallelFor über 1..N Threads.
+// Läuft mit festen Workern, damit Stealing auch auf Ein-Kern-Maschinen getestet wird.
+
+namespace {
+    // Rechenlast ohne Speicherzugriffe, damit die Skalierung nicht an der Bandbreite hängt
+    float Work(size_t i) {
+        float x = static_cast<float>(i) * 0.001f;
+        for (int k = 0; k < 32; ++k) x = std::sin(x) * 0.5f + std::cos(x * 1.3f);
+        return x;
+    }
+}
+
+TEST(CounterReachesZero) {
+    JobSystem& jobs = JobSystem::Instance();
+    std::atomic<int> executed{0};
+    JobCounter counter;
+    for (int i = 0; i < 10000; ++i) {
+        jobs.Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    CHECK_EQ(executed.load(), 10000);
+    CHECK_EQ(counter.Pending(), 0);
+
+    // Counter ist danach wiederverwendbar
+    jobs.Run([&executed] { executed.fetch_add(1); }, &counter);
+    jobs.Wait(counter);
+    CHECK_EQ(executed.load(), 10001);
+}
+
+TEST(EmptyCounterDoesNotBlock) {
+    JobCounter counter;
+    JobSystem::Instance().Wait(counter);
+    CHECK_EQ(counter.Pending(), 0);
+}
+
+TEST(DependencyRunsAfterAllPredecessors) {
+    JobSystem& jobs = JobSystem::Instance();
+    constexpr int Count = 256;
+    for (int round = 0; round < 20; ++round) {
+        std::unique_ptr<std::atomic<int>[]> stage(new std::atomic<int>[Count]);
+        for (int i = 0; i < Count; ++i) stage[i] = 0;
+
+        JobCounter first, second;
+        std::atomic<int> violations{0}, continuations{0};
+        for (int i = 0; i < Count; ++i) {
+            jobs.Run([&stage, i] {
+                std::this_thread::yield();
+                stage[i].store(1, std::memory_order_release);
+            }, &first);
+        }
+        // Continuations dürfen erst starten, wenn jeder Job der ersten Stufe fertig ist
+        for (int c = 0; c < 8; ++c) {
+            jobs.Run([&] {
+                for (int i = 0; i < Count; ++i) {
+                    if (stage[i].load(std::memory_order_acquire) != 1) violations.fetch_add(1);
+                }
+                continuations.fetch_add(1);
+            }, &second, &first);
+        }
+        jobs.Wait(second);
+        CHECK_EQ(violations.load(), 0);
+        CHECK_EQ(continuations.load(), 8);
+        CHECK_EQ(first.Pending(), 0);
+    }
+}
+
+TEST(DependencyChain) {
+    // a -> b -> c, jeweils über Counter verkettet; die Reihenfolge muss strikt sein
+    JobSystem& jobs = JobSystem::Instance();
+    for (int round = 0; round < 100; ++round) {
+        JobCounter a, b, c;
+        std::mutex orderMutex;
+        std::vector<int> order;
+        auto record = [&](int step) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(step);
+        };
+        jobs.Run([&] { record(1); }, &a);
+        jobs.Run([&] { record(2); }, &b, &a);
+        jobs.Run([&] { record(3); }, &c, &b);
+        jobs.Wait(c);
+        CHECK(order == std::vector<int>({ 1, 2, 3 }));
+    }
+}
+
+TEST(DependencyAlreadyFinished) {
+    JobSystem& jobs = JobSystem::Instance();
+    JobCounter done, counter;
+    jobs.Run([] {}, &done);
+    jobs.Wait(done);
+    std::atomic<bool> ran{false};
+    jobs.Run([&ran] { ran = true; }, &counter, &done);
+    jobs.Wait(counter);
+    CHECK(ran.load());
+}
+
+TEST(JobsSpawningJobs) {
+    // Worker legen Jobs in ihre eigene Deque, andere stehlen sie; jeder Job läuft genau einmal
+    JobSystem& jobs = JobSystem::Instance();
+    static constexpr int Outer = 64, Inner = 64;
+    std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[Outer * Inner]);
+    for (int i = 0; i < Outer * Inner; ++i) runs[i] = 0;
+
+    JobCounter counter;
+    for (int o = 0; o < Outer; ++o) {
+        jobs.Run([&, o] {
+            JobCounter inner;
+            for (int i = 0; i < Inner; ++i) {
+                jobs.Run([&runs, o, i] { runs[o * Inner + i].fetch_add(1); }, &inner);
+            }
+            jobs.Wait(inner);
+        }, &counter);
+    }
+    jobs.Wait(counter);
+
+    int wrong = 0;
+    for (int i = 0; i < Outer * Inner; ++i) {
+        if (runs[i].load() != 1) ++wrong;
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+TEST(WorkersStealFromMainThread) {
+    JobSystem& jobs = JobSystem::Instance();
+    if (jobs.ThreadCount() < 2) return;
+
+    // Alle Jobs landen in der Deque des Main-Threads; andere Threads kommen nur per Steal() dran
+    std::mutex idMutex;
+    std::set<std::thread::id> threads;
+    JobCounter counter;
+    for (int i = 0; i < 64; ++i) {
+        jobs.Run([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(idMutex);
+            threads.insert(std::this_thread::get_id());
+        }, &counter);
+    }
+    jobs.Wait(counter);
+    CHECK(threads.size() >= 2);
+}
+
+TEST(ParallelForCoversRangeOnce) {
+    JobSystem& jobs = JobSystem::Instance();
+    const size_t sizes[] = { 0, 1, 7, 64, 1000, 100003 };
+    const size_t grains[] = { 1, 16, 4096 };
+    for (size_t n : sizes) {
+        for (size_t grain : grains) {
+            std::vector<std::atomic<int>> hits(n);
+            jobs.ParallelFor(3, 3 + n, grain, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) hits[i - 3].fetch_add(1, std::memory_order_relaxed);
+            });
+            size_t wrong = 0;
+            for (auto& h : hits) {
+                if (h.load() != 1) ++wrong;
+            }
+            CHECK_EQ(wrong, size_t(0));
+        }
+    }
+}
+
+TEST(BackgroundJobsNeverRunInWait) {
+    // Ein blockierter Hintergrund-Job darf Wait() auf Frame-Arbeit nicht aufhalten und läuft nie im Main-Thread
+    JobSystem& jobs = JobSystem::Instance();
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<bool> release{false}, onMain{false};
+    std::atomic<int> started{0};
+    JobCounter background;
+    for (int i = 0; i < 2; ++i) {
+        jobs.RunBackground([&] {
+            if (std::this_thread::get_id() == mainThread) onMain = true;
+            started.fetch_add(1);
+            while (!release.load()) std::this_thread::yield();
+        }, &background);
+    }
+
+    for (int frame = 0; frame < 50; ++frame) {
+        JobCounter counter;
+        std::atomic<int> executed{0};
+        for (int i = 0; i < 64; ++i) jobs.Run([&executed] { executed.fetch_add(1); }, &counter);
+        jobs.Wait(counter);
+        CHECK_EQ(executed.load(), 64);
+    }
+    CHECK_EQ(background.Pending(), 2);
+    release = true;
+    jobs.Wait(background);
+    CHECK_EQ(started.load(), 2);
+    CHECK(!onMain.load());
+}
+
+TEST(BackgroundSubtasksNeverRunInWait) {
+    // ParallelFor und Run aus einem Hintergrund-Job (wie im Modell-Import) bleiben in der Hintergrund-Queue:
+    // Wait() im Main-Thread darf keine dieser Teilaufgaben stehlen
+    JobSystem& jobs = JobSystem::Instance();
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<bool> onMain{false};
+    std::atomic<int> subtasks{0};
+    JobCounter background;
+    jobs.RunBackground([&] {
+        jobs.ParallelFor(0, 64, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (std::this_thread::get_id() == mainThread) onMain = true;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                subtasks.fetch_add(1);
+            }
+        });
+        JobCounter nested;
+        for (int i = 0; i < 16; ++i) {
+            jobs.Run([&] {
+                if (std::this_thread::get_id() == mainThread) onMain = true;
+                subtasks.fetch_add(1);
+            }, &nested);
+        }
+        jobs.Wait(nested);
+    }, &background);
+
+    // Ein Frame, dann im Main-Thread warten, während der Import seine Teilaufgaben noch verteilt hat
+    JobCounter counter;
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 16; ++i) jobs.Run([&executed] { executed.fetch_add(1); }, &counter);
+    jobs.Wait(counter);
+    CHECK_EQ(executed.load(), 16);
+    while (subtasks.load() == 0) std::this_thread::yield();
+    jobs.Wait(background);
+    CHECK_EQ(subtasks.load(), 64 + 16);
+    CHECK(!onMain.load());
+}
+
+TEST(BackgroundWithoutWorkers) {
+    // Ohne Worker-Threads übernimmt ein eigener Thread; Frame-Jobs laufen weiter im Main-Thread
+    JobSystem& jobs = JobSystem::Instance();
+    const unsigned previousWorkers = jobs.ThreadCount() - 1;
+    jobs.Shutdown();
+    jobs.Initialize(0);
+
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<bool> release{false}, onMain{false};
+    JobCounter background;
+    jobs.RunBackground([&] {
+        if (std::this_thread::get_id() == mainThread) onMain = true;
+        while (!release.load()) std::this_thread::yield();
+    }, &background);
+
+    JobCounter counter;
+    int executed = 0;
+    for (int i = 0; i < 16; ++i) jobs.Run([&executed] { ++executed; }, &counter);
+    jobs.Wait(counter);
+    CHECK_EQ(executed, 16);
+    CHECK_EQ(background.Pending(), 1);
+    release = true;
+    jobs.Wait(background);
+    CHECK(!onMain.load());
+
+    jobs.Shutdown();
+    jobs.Initialize(previousWorkers);
+}
+
+TEST(ParallelForScaling) {
+    // Kein Assert auf die Beschleunigung (hängt von der Maschine ab), nur Bericht 1..N Threads
+    JobSystem& jobs = JobSystem::Instance();
+    constexpr size_t Items = 100000;
+    std::vector<float> out(Items);
+    const unsigned maxThreads = jobs.ThreadCount();
+
+    double singleMs = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+        double best = 1e30;
+        for (int run = 0; run < 3; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            jobs.ParallelFor(0, Items, 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) out[i] = Work(i);
+            }, threads);
+            best = std::min(best, Test::MillisecondsSince(start));
+        }
+        if (threads == 1) singleMs = best;
+        std::printf("  %2u threads: %8.2f ms  speedup %.2fx  efficiency %3.0f%%\n",
+                    threads, best, singleMs / best, 100.0 * singleMs / (best * threads));
+    }
+
+    // Ergebnis unabhängig von der Aufteilung
+    size_t wrong = 0;
+    for (size_t i = 0; i < Items; i += 997) {
+        if (out[i] != Work(i)) ++wrong;
+    }
+    CHECK_EQ(wrong, size_t(0));
+}
+
+int main() {
+    // Mindestens 3 Worker, damit Stealing und Continuations zwischen Threads auch auf kleinen Maschinen laufen
+    const unsigned hw = std::thread::hardware_concurrency();
+    JobSystem::Instance().Initialize(std::max(3u, hw > 1 ? hw - 1 : 0));
+    const int result = Test::RunAll();
+    JobSystem::Instance().Shutdown();
+    return result;
+}
@@ -0,0 +1,165 @@
+#include "TestFramework.hpp"
+#include "../include/core/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+// Der Optimierer darf nur Reihenfolge und Nummerierung ändern: jede Stufe wird per IsEquivalent gegen die
+// Eingabe geprüft, dazu IsEquivalent selbst gegen absichtlich veränderte Geometrie.
+
+namespace {
+    struct TestMesh {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    // UV-Kugel mit Naht, Dreiecke und Vertices zufällig gemischt (wie Benchmarks::MeshOptimization)
+    TestMesh ShuffledSphere(int segments, int rings, unsigned seed) {
+        TestMesh mesh;
+        for (int r = 0; r <= rings; ++r) {
+            for (int s = 0; s <= segments; ++s) {
+                const float theta = 3.14159265f * r / rings;
+                const float phi = 2.0f * 3.14159265f * s / segments;
+                const glm::vec3 p(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                mesh.vertices.push_back({ p, p, glm::vec2(static_cast<float>(s) / segments, static_cast<float>(r) / rings) });
+            }
+        }
+        std::mt19937 rng(seed);
+        std::vector<unsigned int> vertexOrder(mesh.vertices.size());
+        std::iota(vertexOrder.begin(), vertexOrder.end(), 0u);
+        std::shuffle(vertexOrder.begin(), vertexOrder.end(), rng);
+        std::vector<Vertex> shuffled(mesh.vertices.size());
+        for (size_t i = 0; i < mesh.vertices.size(); ++i) shuffled[vertexOrder[i]] = mesh.vertices[i];
+        mesh.vertices = shuffled;
+
+        std::vector<unsigned int> quads(static_cast<size_t>(rings) * segments);
+        std::iota(quads.begin(), quads.end(), 0u);
+        std::shuffle(quads.begin(), quads.end(), rng);
+        for (unsigned int q : quads) {
+            const unsigned int a = (q / segments) * (segments + 1) + q % segments;
+            const unsigned int b = a + 1, c = a + segments + 1, d = c + 1;
+            for (unsigned int v : { a, b, c, b, d, c }) mesh.indices.push_back(vertexOrder[v]);
+        }
+        return mesh;
+    }
+
+    bool IndicesInRange(const TestMesh& mesh) {
+        return std::all_of(mesh.indices.begin(), mesh.indices.end(),
+                           [&](unsigned int i) { return i < mesh.vertices.size(); });
+    }
+}
+
+TEST(OptimizeKeepsGeometry) {
+    const TestMesh input = ShuffledSphere(64, 32, 1357);
+    for (bool overdraw : { false, true }) {
+        TestMesh mesh = input;
+        const MeshOptimizer::Result stats = MeshOptimizer::Optimize(mesh.vertices, mesh.indices, overdraw);
+        CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, mesh.vertices, mesh.indices));
+        CHECK_EQ(mesh.indices.size(), input.indices.size());
+        CHECK(IndicesInRange(mesh));
+        // Gemischte Eingabe liegt weit über 1.5 Aufrufen pro Dreieck, danach deutlich unter 1
+        CHECK(stats.before.Acmr() > 1.5);
+        CHECK(stats.after.Acmr() < 1.0);
+        CHECK(stats.after.misses < stats.before.misses);
+    }
+}
+
+TEST(EachStageKeepsGeometry) {
+    const TestMesh input = ShuffledSphere(24, 12, 2468);
+    TestMesh mesh = input;
+
+    std::vector<unsigned int> clusters;
+    mesh.indices = MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size(), MeshOptimizer::CacheSize, &clusters);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, mesh.vertices, mesh.indices));
+    CHECK(!clusters.empty());
+    CHECK(std::is_sorted(clusters.begin(), clusters.end()));
+
+    MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices.data(), mesh.vertices.size(), clusters);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, mesh.vertices, mesh.indices));
+
+    MeshOptimizer::OptimizeVertexFetch(mesh.vertices, mesh.indices);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, mesh.vertices, mesh.indices));
+    CHECK(IndicesInRange(mesh));
+}
+
+TEST(VertexFetchOrdersByFirstUseAndDropsUnused) {
+    TestMesh mesh;
+    for (int i = 0; i < 6; ++i) mesh.vertices.push_back({ glm::vec3(static_cast<float>(i)), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f) });
+    // Vertex 1 und 4 werden nicht benutzt
+    mesh.indices = { 5, 3, 0, 0, 3, 2 };
+    const TestMesh input = mesh;
+    MeshOptimizer::OptimizeVertexFetch(mesh.vertices, mesh.indices);
+
+    CHECK_EQ(mesh.vertices.size(), size_t(4));
+    CHECK(mesh.indices == std::vector<unsigned int>({ 0, 1, 2, 2, 1, 3 }));
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, mesh.vertices, mesh.indices));
+}
+
+TEST(IsEquivalentDetectsChanges) {
+    const TestMesh input = ShuffledSphere(16, 8, 97);
+
+    // Eckpunkte eines Dreiecks zyklisch verschoben: gleiche Umlaufrichtung -> gleich
+    TestMesh rotated = input;
+    std::rotate(rotated.indices.begin(), rotated.indices.begin() + 1, rotated.indices.begin() + 3);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, rotated.vertices, rotated.indices));
+
+    // Dreiecke umsortiert -> gleich
+    TestMesh reordered = input;
+    std::swap_ranges(reordered.indices.begin(), reordered.indices.begin() + 3, reordered.indices.end() - 3);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, reordered.vertices, reordered.indices));
+
+    TestMesh flipped = input;
+    std::swap(flipped.indices[1], flipped.indices[2]);
+    CHECK(!MeshOptimizer::IsEquivalent(input.vertices, input.indices, flipped.vertices, flipped.indices));
+
+    TestMesh moved = input;
+    moved.vertices[moved.indices[0]].position.x += 1e-6f;
+    CHECK(!MeshOptimizer::IsEquivalent(input.vertices, input.indices, moved.vertices, moved.indices));
+
+    TestMesh renormal = input;
+    renormal.vertices[renormal.indices[0]].normal.y = -renormal.vertices[renormal.indices[0]].normal.y + 0.5f;
+    CHECK(!MeshOptimizer::IsEquivalent(input.vertices, input.indices, renormal.vertices, renormal.indices));
+
+    TestMesh dropped = input;
+    dropped.indices.resize(dropped.indices.size() - 3);
+    CHECK(!MeshOptimizer::IsEquivalent(input.vertices, input.indices, dropped.vertices, dropped.indices));
+
+    // Ein Dreieck doppelt statt eines anderen: gleiche Anzahl, andere Menge
+    TestMesh duplicated = input;
+    std::copy(duplicated.indices.begin(), duplicated.indices.begin() + 3, duplicated.indices.begin() + 3);
+    CHECK(!MeshOptimizer::IsEquivalent(input.vertices, input.indices, duplicated.vertices, duplicated.indices));
+}
+
+TEST(AnalyzeVertexCacheCountsMisses) {
+    // Einzelnes Dreieck: drei Aufrufe; dasselbe noch einmal trifft den Cache
+    const MeshOptimizer::CacheStats single = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2 }, 3);
+    CHECK_EQ(single.misses, size_t(3));
+    CHECK_EQ(single.Acmr(), 3.0);
+    const MeshOptimizer::CacheStats twice = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2, 2, 1, 0 }, 3);
+    CHECK_EQ(twice.misses, size_t(3));
+    CHECK_EQ(twice.triangles, size_t(2));
+    CHECK_EQ(twice.Atvr(), 1.0);
+
+    const MeshOptimizer::CacheStats empty = MeshOptimizer::AnalyzeVertexCache({}, 0);
+    CHECK_EQ(empty.Acmr(), 0.0);
+}
+
+TEST(EmptyAndTinyMeshes) {
+    TestMesh empty;
+    MeshOptimizer::Optimize(empty.vertices, empty.indices, true);
+    CHECK(empty.indices.empty());
+
+    TestMesh triangle;
+    triangle.vertices = { { glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f) },
+                          { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 0.0f) },
+                          { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 1.0f) } };
+    triangle.indices = { 2, 0, 1 };
+    const TestMesh input = triangle;
+    MeshOptimizer::Optimize(triangle.vertices, triangle.indices, true);
+    CHECK(MeshOptimizer::IsEquivalent(input.vertices, input.indices, triangle.vertices, triangle.indices));
+}
+
+int main() {
+    return Test::RunAll();
+}
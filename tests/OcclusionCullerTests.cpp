@@ -0,0 +1,128 @@
+#include "TestFramework.hpp"
+#include "../include/core/OcclusionCuller.hpp"
+#include "../include/core/JobSystem.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include <algorithm>
+#include <thread>
+
+// Headless: Occluder aus skalierten Einheitswürfeln, Kamera auf Augenhöhe mit Blick entlang -Z
+
+namespace {
+    const glm::vec3 CubeVertices[8] = {
+        {-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f},
+        {-0.5f, -0.5f,  0.5f}, {0.5f, -0.5f,  0.5f}, {0.5f, 0.5f,  0.5f}, {-0.5f, 0.5f,  0.5f},
+    };
+    const uint32_t CubeIndices[36] = {
+        0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+        3, 6, 2, 3, 7, 6,   0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5,
+    };
+
+    glm::mat4 ViewProj() {
+        // Seitenverhältnis des Tiefenpuffers wie im Renderer
+        const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 200.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 0.0f), glm::vec3(0.0f, 1.7f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return proj * view;
+    }
+
+    // Quader mit Mittelpunkt center und Kantenlängen size
+    glm::mat4 Box(const glm::vec3& center, const glm::vec3& size) {
+        return glm::scale(glm::translate(glm::mat4(1.0f), center), size);
+    }
+
+    void Rasterize(OcclusionCuller& culler, const std::vector<glm::mat4>& occluders) {
+        culler.Begin(ViewProj());
+        for (const glm::mat4& m : occluders) {
+            culler.AddOccluder(CubeVertices, sizeof(glm::vec3), 8, CubeIndices, 36, m);
+        }
+        culler.Rasterize();
+    }
+}
+
+TEST(EmptyBufferOccludesNothing) {
+    OcclusionCuller culler;
+    Rasterize(culler, {});
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.5f, -20.0f), glm::vec3(0.5f)));
+    CHECK_EQ(culler.GetDepth(OcclusionCuller::Width / 2, OcclusionCuller::Height / 2), 1.0f);
+}
+
+TEST(BoxBehindWallIsCulled) {
+    // 40 m breite, 10 m hohe Wand 10 m vor der Kamera verdeckt alles dahinter in Bildmitte
+    OcclusionCuller culler;
+    Rasterize(culler, { Box(glm::vec3(0.0f, 2.0f, -10.0f), glm::vec3(40.0f, 10.0f, 0.4f)) });
+    CHECK(culler.GetTriangleCount() > 0);
+    CHECK(culler.IsOccluded(glm::vec3(0.0f, 1.5f, -20.0f), glm::vec3(0.5f)));
+    CHECK(culler.IsOccluded(glm::vec3(3.0f, 2.0f, -30.0f), glm::vec3(1.0f)));
+    // Vor der Wand bleibt sichtbar
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.5f, -5.0f), glm::vec3(0.5f)));
+    // Die Box, die die Wand selbst einschließt, ist nicht "dahinter"
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 2.0f, -10.0f), glm::vec3(1.0f)));
+}
+
+TEST(BoxSeenThroughDoorwayIsKept) {
+    // Wand 10 m vor der Kamera mit 2 m breitem Durchgang in der Mitte
+    OcclusionCuller culler;
+    Rasterize(culler, {
+        Box(glm::vec3(-11.0f, 2.0f, -10.0f), glm::vec3(20.0f, 10.0f, 0.4f)),
+        Box(glm::vec3(11.0f, 2.0f, -10.0f), glm::vec3(20.0f, 10.0f, 0.4f)),
+    });
+    // Durch den Durchgang sichtbar (projiziert vollständig in die Lücke)
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.7f, -20.0f), glm::vec3(0.3f)));
+    // Teilweise im Durchgang, teilweise hinter der Wand
+    CHECK(!culler.IsOccluded(glm::vec3(1.5f, 1.7f, -20.0f), glm::vec3(0.5f)));
+    // Seitlich hinter dem Wandstück
+    CHECK(culler.IsOccluded(glm::vec3(-8.0f, 1.7f, -20.0f), glm::vec3(0.5f)));
+    CHECK(culler.IsOccluded(glm::vec3(8.0f, 1.7f, -20.0f), glm::vec3(0.5f)));
+}
+
+TEST(BoxStraddlingNearPlaneIsKept) {
+    // Wand füllt das ganze Bild; eine Box um die Kamera schneidet die Near-Plane und muss sichtbar bleiben
+    OcclusionCuller culler;
+    Rasterize(culler, { Box(glm::vec3(0.0f, 1.7f, -2.0f), glm::vec3(100.0f, 100.0f, 0.2f)) });
+    CHECK(culler.IsOccluded(glm::vec3(0.0f, 1.7f, -10.0f), glm::vec3(1.0f)));
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.7f, 0.0f), glm::vec3(0.5f, 0.5f, 1.0f)));
+    CHECK(!culler.IsOccluded(glm::vec3(0.3f, 1.5f, 0.05f), glm::vec3(0.2f)));
+    // Ganz hinter der Kamera: außerhalb des Bildes gilt als sichtbar (Frustum-Culling ist dafür zuständig)
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.7f, 10.0f), glm::vec3(0.5f)));
+}
+
+TEST(OccluderBehindBoxDoesNotCull) {
+    // Tiefe zählt, nicht nur die Abdeckung im Bild
+    OcclusionCuller culler;
+    Rasterize(culler, { Box(glm::vec3(0.0f, 2.0f, -30.0f), glm::vec3(60.0f, 20.0f, 0.4f)) });
+    CHECK(!culler.IsOccluded(glm::vec3(0.0f, 1.7f, -15.0f), glm::vec3(0.5f)));
+    CHECK(culler.IsOccluded(glm::vec3(0.0f, 1.7f, -40.0f), glm::vec3(0.5f)));
+}
+
+TEST(ParallelRasterMatchesSerial) {
+    // Bänder laufen über das JobSystem; das Ergebnis darf nicht von der Verteilung abhängen
+    std::vector<glm::mat4> occluders;
+    for (int row = 0; row < 3; ++row) {
+        const float z = -10.0f - 15.0f * row;
+        for (float x = -40.0f; x < 40.0f; x += 8.0f) {
+            occluders.push_back(Box(glm::vec3(x + 4.0f + row, 2.0f, z), glm::vec3(7.0f, 4.0f, 0.4f)));
+        }
+    }
+    OcclusionCuller parallel;
+    Rasterize(parallel, occluders);
+
+    JobSystem::Instance().Shutdown();
+    OcclusionCuller serial;
+    Rasterize(serial, occluders);
+    JobSystem::Instance().Initialize(3);
+
+    int mismatches = 0;
+    for (int y = 0; y < OcclusionCuller::Height; ++y) {
+        for (int x = 0; x < OcclusionCuller::Width; ++x) {
+            if (parallel.GetDepth(x, y) != serial.GetDepth(x, y)) ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(parallel.GetTriangleCount(), serial.GetTriangleCount());
+}
+
+int main() {
+    JobSystem::Instance().Initialize(3);
+    const int result = Test::RunAll();
+    JobSystem::Instance().Shutdown();
+    return result;
+}
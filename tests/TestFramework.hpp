@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimaler Test-Rahmen ohne externe Abhängigkeit. Jede Test-Executable registriert ihre Fälle mit
+// TEST(...) und ruft in main() Test::RunAll() auf; CHECK zählt Fehler, ohne den Fall abzubrechen.
+// Exit-Code: 0 = alles grün, 1 = Fehler, Test::SkipCode = übersprungen (z.B. kein GL-Kontext).
+namespace Test {
+    constexpr int SkipCode = 77;    // SKIP_RETURN_CODE in tests/CMakeLists.txt
+
+    struct Case {
+        const char* name;
+        std::function<void()> fn;
+    };
+
+    inline std::vector<Case>& Registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+    inline int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, std::function<void()> fn) { Registry().push_back({ name, std::move(fn) }); }
+    };
+
+    inline void Fail(const char* file, int line, const std::string& message) {
+        ++Failures();
+        std::cout << "  FAILED " << file << ":" << line << ": " << message << std::endl;
+    }
+
+    inline double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    inline int RunAll() {
+        for (const Case& c : Registry()) {
+            const int before = Failures();
+            const auto start = std::chrono::steady_clock::now();
+            std::cout << "[ RUN  ] " << c.name << std::endl;
+            c.fn();
+            std::cout << (Failures() == before ? "[  OK  ] " : "[ FAIL ] ") << c.name
+                      << " (" << MillisecondsSince(start) << " ms)" << std::endl;
+        }
+        std::cout << Registry().size() << " tests, " << Failures() << " failed checks" << std::endl;
+        return Failures() == 0 ? 0 : 1;
+    }
+}
+
+#define ARK_TEST_CONCAT2(a, b) a##b
+#define ARK_TEST_CONCAT(a, b) ARK_TEST_CONCAT2(a, b)
+
+#define TEST(name) \
+    static void name(); \
+    static Test::Registrar ARK_TEST_CONCAT(registrar_, name)(#name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { if (!(cond)) Test::Fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        const auto checkA = (a); const auto checkB = (b); \
+        if (!(checkA == checkB)) \
+            Test::Fail(__FILE__, __LINE__, std::string(#a " == " #b " (") + std::to_string(checkA) + " vs " + std::to_string(checkB) + ")"); \
+    } while (0)